@@ -77,10 +77,25 @@ groups = {
         "Types": [
             ("vector", "vector", "struct"),
             ("Aliases", aliases, "typedef"),
+            ("int4x2", "int4x2", "struct"),
+            ("uint4x2", "uint4x2", "struct"),
+            ("fp4x2_e2m1", "fp4x2_e2m1", "struct"),
+            ("fp8_e4m3fnuz", "fp8_e4m3fnuz", "struct"),
+            ("fp8_e5m2fnuz", "fp8_e5m2fnuz", "struct"),
+            ("fp6_e3m2", "fp6_e3m2", "struct"),
+            ("fp6_e2m3", "fp6_e2m3", "struct"),
+            ("fp8_e8m0", "fp8_e8m0", "struct"),
+            ("lazy_expr", "lazy_expr", "struct"),
+            ("compute_type_policy", "compute_type_policy", "struct"),
+            ("mixed_vec", "mixed_vec", "struct"),
+            ("fast_math_policy", "fast_math_policy", "struct"),
+            ("precise_policy", "precise_policy", "struct"),
         ],
         "Primitives": [
             "map",
+            "map_inplace",
             "reduce",
+            "reduce_axis",
             "zip",
             "zip_common",
             "make_vec",
@@ -88,12 +103,28 @@ groups = {
             "concat",
             "select",
             "for_each",
+            "lazy",
+            "eval",
         ],
         "Conversion": [
             "convert",
             "cast",
             "cast_to",
+            "cast_stochastic",
             "broadcast",
+            "reshape",
+            "pack",
+            "unpack",
+        ],
+        "Quantization": [
+            "quantize",
+            "dequantize",
+            "quantize_buffer",
+            "dequantize_buffer",
+            ("block_scaled_ptr", "block_scaled_ptr", "struct"),
+            "amax_buffer",
+            "cast_scaled_buffer",
+            ("delayed_scaling", "delayed_scaling", "struct"),
         ],
         "Generation": [
             ("range", "range()"),
@@ -108,13 +139,20 @@ groups = {
             "ones_like",
         ],
         "Shuffling": [
+            ("shuffle", "shuffle(const V&)"),
+            ("shuffle", "shuffle(const L&, const R&)"),
+            "permute",
+            "lookup",
+            "slice",
+            "split",
+            "interleave",
+            "deinterleave",
+            "rotate",
+            "reverse",
         #    "concat",
         #    "swizzle",
         #    "first",
         #    "last",
-        #    "reversed",
-        #    "rotate_left",
-        #    "rotate_right",
         ],
         "Unary Operators": [
             "negate",
@@ -149,11 +187,31 @@ groups = {
         "Reductions": [
             "sum",
             ("max", "max(const V&)"),
+            "amax",
             ("min", "min(const V&)"),
             "product",
             "all",
             "any",
             "count",
+            "bitmask",
+            "from_bitmask",
+            ("moments", "moments(const V&)"),
+            ("moments", "moments(vector_ptr<T, N, U>, size_t, size_t, size_t)"),
+            "merge_moments",
+            ("running_moments", "running_moments", "struct"),
+        ],
+        "Linear algebra": [
+            "matmul",
+            "outer",
+        ],
+        "Sorting": [
+            "sort",
+            "sort_by_key",
+            "median",
+            ("top_k", "top_k(const V&)"),
+            ("top_k", "top_k(const T*, size_t, size_t, size_t)"),
+            "merge_top_k",
+            ("top_k_result", "top_k_result", "struct"),
         ],
         "Mathematical": [
             ("abs", "abs(const V&)"),
@@ -227,6 +285,9 @@ groups = {
             ("read_aligned", "read_aligned(const T*)"),
             ("write_aligned", "write_aligned(T*, const V&)"),
             "assert_aligned",
+            "convert_buffer",
+            "read_packed",
+            "write_packed",
 
             ("vector_ptr", "vector_ptr", "struct"),
         ],
@@ -4,12 +4,16 @@ def name(x):
 
     return f"{x[0]}{x[1]}"
 
-def promote(a, b):
+def promote(a, b, policy="widest"):
     x = a[0]
     y = b[0]
 
+    # With the "narrowest" policy (`KERNEL_FLOAT_PROMOTE_NARROWEST`), the smallest of two floating-point types is
+    # chosen instead of the largest
+    widen = max if policy == "widest" or x not in ("f", "bf") else min
+
     if x == y:
-        return (x, max(a[1], b[1]))
+        return (x, widen(a[1], b[1]))
 
     if x == "b":
         return b
@@ -24,17 +28,17 @@ def promote(a, b):
         return b
 
     if x in ("f", "bf") and y in ("f", "bf"):
-        if a[1] > b[1]:
+        if a[1] == b[1]:
+            return ("f", a[1] * 2)
+        elif widen(a[1], b[1]) == a[1]:
             return a
-        elif b[1] > a[1]:
-            return b
         else:
-            return ("f", a[1] * 2)
+            return b
 
     return None
 
 
-if __name__ == "__main__":
+def generate_table(policy):
     types = [("b", 1)]
     types += [("i", n) for n in [8, 16, 32, 64]]
     types += [("u", n) for n in [8, 16, 32, 64]]
@@ -53,10 +57,19 @@ if __name__ == "__main__":
         line = [f"**{name(a)}**"]
 
         for b in types:
-            c = promote(a, b)
+            c = promote(a, b, policy)
             line.append(name(c) if c else "x")
 
         lines.append(",".join(line))
 
-    with open("promotion_table.csv", "w") as f:
-        f.write("\n".join(lines))
+    return "\n".join(lines)
+
+
+if __name__ == "__main__":
+    # One table for each value of `KERNEL_FLOAT_PROMOTION_POLICY`
+    for policy, filename in [
+        ("widest", "promotion_table.csv"),
+        ("narrowest", "promotion_table_narrowest.csv"),
+    ]:
+        with open(filename, "w") as f:
+            f.write(generate_table(policy))
@@ -7,10 +7,16 @@
 #include "kernel_float/conversion.h"
 #include "kernel_float/fp16.h"
 #include "kernel_float/iterate.h"
+#include "kernel_float/lazy.h"
 #include "kernel_float/macros.h"
+#include "kernel_float/matmul.h"
 #include "kernel_float/memory.h"
 #include "kernel_float/meta.h"
+#include "kernel_float/minifloat.h"
+#include "kernel_float/mixed.h"
+#include "kernel_float/packed.h"
 #include "kernel_float/prelude.h"
+#include "kernel_float/quantize.h"
 #include "kernel_float/reduce.h"
 #include "kernel_float/triops.h"
 #include "kernel_float/unops.h"
@@ -14,19 +14,72 @@ struct broadcast_extent_helper<E> {
     using type = E;
 };
 
+// Two dimensions can be broadcast if they are equal or if one of them is 1
+template<size_t A, size_t B>
+struct broadcast_dim_helper {};
+
 template<size_t N>
-struct broadcast_extent_helper<extent<N>, extent<N>> {
-    using type = extent<N>;
+struct broadcast_dim_helper<N, N> {
+    static constexpr size_t value = N;
 };
 
 template<size_t N>
-struct broadcast_extent_helper<extent<1>, extent<N>> {
-    using type = extent<N>;
+struct broadcast_dim_helper<1, N> {
+    static constexpr size_t value = N;
 };
 
 template<size_t N>
-struct broadcast_extent_helper<extent<N>, extent<1>> {
-    using type = extent<N>;
+struct broadcast_dim_helper<N, 1> {
+    static constexpr size_t value = N;
+};
+
+template<>
+struct broadcast_dim_helper<1, 1> {
+    static constexpr size_t value = 1;
+};
+
+// Prepends `K` dimensions of size 1 to the extent `E`
+template<size_t K, typename E>
+struct prepend_ones_helper {
+    using type = E;
+};
+
+template<size_t K, size_t... Ns>
+struct prepend_ones_helper<K, extent<Ns...>>: prepend_ones_helper<K - 1, extent<1, Ns...>> {};
+
+template<size_t... Ns>
+struct prepend_ones_helper<0, extent<Ns...>> {
+    using type = extent<Ns...>;
+};
+
+template<typename A, typename B>
+struct broadcast_equal_rank_helper;
+
+template<size_t... As, size_t... Bs>
+struct broadcast_equal_rank_helper<extent<As...>, extent<Bs...>> {
+    using type = extent<broadcast_dim_helper<As, Bs>::value...>;
+};
+
+// Extents of different rank are aligned on their last dimension, so `extent<N>` acts as a row of `extent<M, N>`
+template<typename A, typename B>
+struct broadcast_extent_helper<A, B>:
+    broadcast_equal_rank_helper<
+        typename prepend_ones_helper<(B::rank > A::rank ? B::rank - A::rank : 0), A>::type,
+        typename prepend_ones_helper<(A::rank > B::rank ? A::rank - B::rank : 0), B>::type> {};
+
+template<typename E>
+struct broadcast_extent_helper<E, E> {
+    using type = E;
+};
+
+template<size_t... Ns>
+struct broadcast_extent_helper<extent<1>, extent<Ns...>> {
+    using type = extent<Ns...>;
+};
+
+template<size_t... Ns>
+struct broadcast_extent_helper<extent<Ns...>, extent<1>> {
+    using type = extent<Ns...>;
 };
 
 template<>
@@ -54,11 +107,56 @@ static constexpr bool is_vector_broadcastable = is_broadcastable<vector_extent_t
 
 namespace detail {
 
+/**
+ * Returns the index into a vector of extent `From` of the element that is broadcast to index `i` of a vector of
+ * extent `To`.
+ */
+template<size_t... Fs, size_t... Ts>
+KERNEL_FLOAT_INLINE constexpr size_t broadcast_index(size_t i, extent<Fs...>, extent<Ts...>) {
+    constexpr size_t rank = sizeof...(Ts);
+    constexpr size_t padding = rank - sizeof...(Fs);
+    constexpr size_t from[] = {Fs...};
+    constexpr size_t to[] = {Ts...};
+
+    size_t result = 0;
+    size_t stride = 1;
+
+    for (size_t k = rank; k > 0; k--) {
+        size_t from_dim = k - 1 < padding ? 1 : from[k - 1 - padding];
+        size_t index = i % to[k - 1];
+        i /= to[k - 1];
+
+        if (from_dim != 1) {
+            result += index * stride;
+        }
+
+        stride *= from_dim;
+    }
+
+    return result;
+}
+
 template<typename T, typename From, typename To>
-struct broadcast_impl;
+struct broadcast_impl {
+    static_assert(is_broadcastable<From, To>, "cannot broadcast vector to the given extent");
+
+    KERNEL_FLOAT_INLINE static vector_storage<T, To::value>
+    call(const vector_storage<T, From::value>& input) {
+        vector_storage<T, To::value> output;
+
+#pragma unroll
+        for (size_t i = 0; i < To::value; i++) {
+            output.data()[i] = input.data()[broadcast_index(i, From {}, To {})];
+        }
+
+        return output;
+    }
+};
+
+template<typename T, size_t... Ns>
+struct broadcast_impl<T, extent<1>, extent<Ns...>> {
+    static constexpr size_t N = extent<Ns...>::value;
 
-template<typename T, size_t N>
-struct broadcast_impl<T, extent<1>, extent<N>> {
     KERNEL_FLOAT_INLINE static vector_storage<T, N> call(const vector_storage<T, 1>& input) {
         vector_storage<T, N> output;
         for (size_t i = 0; i < N; i++) {
@@ -68,9 +166,9 @@ struct broadcast_impl<T, extent<1>, extent<N>> {
     }
 };
 
-template<typename T, size_t N>
-struct broadcast_impl<T, extent<N>, extent<N>> {
-    KERNEL_FLOAT_INLINE static vector_storage<T, N> call(vector_storage<T, N> input) {
+template<typename T, typename E>
+struct broadcast_impl<T, E, E> {
+    KERNEL_FLOAT_INLINE static vector_storage<T, E::value> call(vector_storage<T, E::value> input) {
         return input;
     }
 };
@@ -88,6 +186,9 @@ struct broadcast_impl<T, extent<1>, extent<1>> {
  * Takes the given vector `input` and extends its size to a length of `N`. This is only valid if the size of `input`
  * is 1 or `N`.
  *
+ * For multi-dimensional extents, each dimension of `input` must be 1 or equal to the corresponding dimension of the
+ * new size, where missing leading dimensions are treated as 1.
+ *
  * Example
  * =======
  * ```
@@ -96,16 +197,40 @@ struct broadcast_impl<T, extent<1>, extent<1>> {
  *
  * vec<float, 5> b = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
  * vec<float, 5> y = broadcast<5>(b);  // Returns [1.0f, 2.0f, 3.0f, 4.0f, 5.0f]
+ *
+ * vector<float, extent<2, 1>> c = {1.0f, 2.0f};
+ * vector<float, extent<2, 3>> z = broadcast<2, 3>(c);  // Returns [[1.0f, 1.0f, 1.0f], [2.0f, 2.0f, 2.0f]]
  * ```
  */
-template<size_t N, typename V>
-KERNEL_FLOAT_INLINE vector<vector_value_type<V>, extent<N>>
-broadcast(const V& input, extent<N> new_size = {}) {
+template<size_t... Ns, typename V>
+KERNEL_FLOAT_INLINE vector<vector_value_type<V>, extent<Ns...>>
+broadcast(const V& input, extent<Ns...> new_size = {}) {
     using T = vector_value_type<V>;
-    return detail::broadcast_impl<T, vector_extent_type<V>, extent<N>>::call(
+    return detail::broadcast_impl<T, vector_extent_type<V>, extent<Ns...>>::call(
         into_vector_storage(input));
 }
 
+/**
+ * Returns the elements of `input` as a vector of the given (possibly multi-dimensional) extent `extent<Ns...>`. The
+ * number of elements must be the same. The elements are not moved, only the shape of the vector changes.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 6> a = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+ * vector<float, extent<2, 3>> m = reshape<2, 3>(a);  // Returns [[1.0f, 2.0f, 3.0f], [4.0f, 5.0f, 6.0f]]
+ * vec<float, 6> b = reshape<6>(m);
+ * ```
+ */
+template<size_t... Ns, typename V>
+KERNEL_FLOAT_INLINE vector<vector_value_type<V>, extent<Ns...>>
+reshape(const V& input, extent<Ns...> new_size = {}) {
+    static_assert(
+        vector_extent<V> == extent<Ns...>::value,
+        "reshape cannot change the number of elements");
+    return into_vector_storage(input);
+}
+
 /**
  * Takes the given vector `input` and extends its size to the same length as vector `other`. This is only valid if the
  * size of `input` is 1 or the same as `other`.
@@ -118,7 +243,7 @@ broadcast_like(const V& input, const R& other) {
 
 namespace detail {
 
-template<size_t N>
+template<size_t N, bool = is_unrolled(N)>
 struct apply_recur_impl;
 
 template<typename F, size_t N, typename Output, typename... Args>
@@ -128,7 +253,7 @@ struct apply_impl {
     }
 };
 
-template<size_t N>
+template<size_t N, bool>
 struct apply_recur_impl {
     static constexpr size_t K = round_up_to_power_of_two(N) / 2;
 
@@ -139,6 +264,23 @@ struct apply_recur_impl {
     }
 };
 
+// Large vectors are processed in chunks by a loop that is not unrolled
+template<size_t N>
+struct apply_recur_impl<N, false> {
+    static constexpr size_t K = unroll_chunk_size;
+    static constexpr size_t M = N - N % K;
+
+    template<typename F, typename Output, typename... Args>
+    KERNEL_FLOAT_INLINE static void call(F fun, Output* result, const Args*... inputs) {
+#pragma unroll 1
+        for (size_t i = 0; i < M; i += K) {
+            apply_impl<F, K, Output, Args...>::call(fun, result + i, (inputs + i)...);
+        }
+
+        apply_impl<F, N - M, Output, Args...>::call(fun, result + M, (inputs + M)...);
+    }
+};
+
 template<>
 struct apply_recur_impl<0> {
     template<typename F, typename Output, typename... Args>
@@ -157,6 +299,100 @@ template<typename F, size_t N, typename Output, typename... Args>
 struct apply_fastmath_impl: apply_impl<F, N, Output, Args...> {};
 }  // namespace detail
 
+/**
+ * Math policy that evaluates functions using their fast (but possibly less accurate) implementation, if available.
+ * A math policy can be passed as the first argument to `map`, `zip_common`, and the named math functions (such as
+ * `exp` or `divide`) to select the implementation for that call only.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {1.0f, 2.0f, 3.0f, 4.0f};
+ * vec<float, 4> a = exp(fast_math_policy {}, x);  // Approximate, even without KERNEL_FLOAT_FAST_MATH
+ * vec<float, 4> b = divide(fast_math_policy {}, x, 3.0f);
+ * ```
+ */
+struct fast_math_policy {
+    template<typename F, size_t N, typename Output, typename... Args>
+    using apply_impl = detail::apply_fastmath_impl<F, N, Output, Args...>;
+};
+
+/**
+ * Math policy that always evaluates functions using their accurate implementation, even if `KERNEL_FLOAT_FAST_MATH`
+ * is enabled. See `fast_math_policy`.
+ */
+struct precise_policy {
+    template<typename F, size_t N, typename Output, typename... Args>
+    using apply_impl = detail::apply_impl<F, N, Output, Args...>;
+};
+
+/**
+ * The math policy used if no policy is given: `fast_math_policy` if `KERNEL_FLOAT_FAST_MATH` is enabled and
+ * `precise_policy` otherwise.
+ */
+#if KERNEL_FLOAT_FAST_MATH
+using default_policy = fast_math_policy;
+#else
+using default_policy = precise_policy;
+#endif
+
+namespace detail {
+template<typename P>
+struct is_math_policy_impl {
+    static constexpr bool value = false;
+};
+
+template<>
+struct is_math_policy_impl<fast_math_policy> {
+    static constexpr bool value = true;
+};
+
+template<>
+struct is_math_policy_impl<precise_policy> {
+    static constexpr bool value = true;
+};
+}  // namespace detail
+
+template<typename P>
+static constexpr bool is_math_policy = detail::is_math_policy_impl<decay_t<P>>::value;
+
+namespace detail {
+template<typename P, typename F, size_t N, typename Output, typename... Args>
+using policy_apply_impl = typename P::template apply_impl<F, N, Output, Args...>;
+
+template<typename F, size_t N, typename Output, typename... Args>
+using default_apply_impl = policy_apply_impl<default_policy, F, N, Output, Args...>;
+
+/**
+ * Calls the binary function `F` with the scalar `value` as its left argument. Applying this function to a vector
+ * applies `F` to a scalar and a vector without first broadcasting the scalar into a vector of `N` copies.
+ */
+template<typename F, typename T>
+struct apply_scalar_left {
+    template<typename R>
+    KERNEL_FLOAT_INLINE result_t<F, T, R> operator()(R right) {
+        return fun(value, right);
+    }
+
+    F fun;
+    T value;
+};
+
+/**
+ * Calls the binary function `F` with the scalar `value` as its right argument. See `apply_scalar_left`.
+ */
+template<typename F, typename T>
+struct apply_scalar_right {
+    template<typename L>
+    KERNEL_FLOAT_INLINE result_t<F, L, T> operator()(L left) {
+        return fun(left, value);
+    }
+
+    F fun;
+    T value;
+};
+}  // namespace detail
+
 template<typename F, typename... Args>
 using map_type =
     vector<result_t<F, vector_value_type<Args>...>, broadcast_vector_extent_type<Args...>>;
@@ -173,16 +409,28 @@ using map_type =
  */
 template<typename F, typename... Args>
 KERNEL_FLOAT_INLINE map_type<F, Args...> map(F fun, const Args&... args) {
+    return map(default_policy {}, fun, args...);
+}
+
+/**
+ * Apply the function `F` to each element from the vector `input` using the given math policy (`fast_math_policy`
+ * or `precise_policy`) and return the results as a new vector.
+ *
+ * Examples
+ * ========
+ * ```
+ * vec<float, 4> input = {1.0f, 2.0f, 3.0f, 4.0f};
+ * vec<float, 4> output = map(fast_math_policy {}, ops::exp<float> {}, input); // Same as `fast_exp(input)`
+ * ```
+ */
+template<typename P, typename F, typename... Args, typename = enable_if_t<is_math_policy<P>>>
+KERNEL_FLOAT_INLINE map_type<F, Args...> map(P /*policy*/, F fun, const Args&... args) {
     using Output = result_t<F, vector_value_type<Args>...>;
     using E = broadcast_vector_extent_type<Args...>;
     vector_storage<Output, E::value> result;
 
-    // Use the `apply_fastmath_impl` if KERNEL_FLOAT_FAST_MATH is enabled
-#if KERNEL_FLOAT_FAST_MATH
-    using apply_impl = detail::apply_fastmath_impl<F, E::value, Output, vector_value_type<Args>...>;
-#else
-    using apply_impl = detail::apply_impl<F, E::value, Output, vector_value_type<Args>...>;
-#endif
+    using apply_impl =
+        detail::policy_apply_impl<P, F, E::value, Output, vector_value_type<Args>...>;
 
     apply_impl::call(
         fun,
@@ -200,18 +448,75 @@ KERNEL_FLOAT_INLINE map_type<F, Args...> map(F fun, const Args&... args) {
  */
 template<typename F, typename... Args>
 KERNEL_FLOAT_INLINE map_type<F, Args...> fast_map(F fun, const Args&... args) {
-    using Output = result_t<F, vector_value_type<Args>...>;
-    using E = broadcast_vector_extent_type<Args...>;
-    vector_storage<Output, E::value> result;
+    return map(fast_math_policy {}, fun, args...);
+}
 
-    detail::apply_fastmath_impl<F, E::value, Output, vector_value_type<Args>...>::call(
-        fun,
-        result.data(),
-        (detail::broadcast_impl<vector_value_type<Args>, vector_extent_type<Args>, E>::call(
-             into_vector_storage(args))
-             .data())...);
+namespace detail {
+template<typename F, typename T, typename E, typename... Args>
+struct map_inplace_impl {
+    KERNEL_FLOAT_INLINE static void call(F fun, T* data, const Args&... args) {
+        default_apply_impl<F, E::value, T, T, vector_value_type<Args>...>::call(
+            fun,
+            data,
+            data,
+            (broadcast_impl<vector_value_type<Args>, vector_extent_type<Args>, E>::call(
+                 into_vector_storage(args))
+                 .data())...);
+    }
+};
 
-    return result;
+// A single scalar argument is passed to `F` by value instead of being broadcast to a vector
+template<typename F, typename T, typename E, typename A>
+struct map_inplace_impl<F, T, E, A> {
+    using value_type = vector_value_type<A>;
+
+    KERNEL_FLOAT_INLINE static void call(F fun, T* data, const A& arg) {
+        call(fun, data, into_vector_storage(arg), vector_extent_type<A> {});
+    }
+
+  private:
+    template<typename AE>
+    KERNEL_FLOAT_INLINE static void
+    call(F fun, T* data, const vector_storage<value_type, AE::value>& arg, AE) {
+        default_apply_impl<F, E::value, T, T, value_type>::call(
+            fun,
+            data,
+            data,
+            broadcast_impl<value_type, AE, E>::call(arg).data());
+    }
+
+    KERNEL_FLOAT_INLINE static void
+    call(F fun, T* data, const vector_storage<value_type, 1>& arg, extent<1>) {
+        default_apply_impl<apply_scalar_right<F, value_type>, E::value, T, T>::call(
+            {fun, arg.data()[0]},
+            data,
+            data);
+    }
+};
+}  // namespace detail
+
+/**
+ * Apply the function `F` to each element of the vector `input` (together with the corresponding elements of the
+ * optional `args`) and write the results back into `input`. Unlike `map`, this does not create a new vector, which
+ * avoids keeping both the input and the output alive for large vectors. The `args` are broadcast to the extent of
+ * `input` and the results of `F` are converted to the element type of `input`.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {1.0f, 2.0f, 3.0f, 4.0f};
+ * map_inplace([](float a) { return a * a; }, x);  // x is now [1.0f, 4.0f, 9.0f, 16.0f]
+ * map_inplace([](float a, float b) { return a - b; }, x, 1.0f);  // x is now [0.0f, 3.0f, 8.0f, 15.0f]
+ * ```
+ */
+template<typename F, typename T, typename E, typename... Args>
+KERNEL_FLOAT_INLINE vector<T, E>& map_inplace(F fun, vector<T, E>& input, const Args&... args) {
+    static_assert(
+        is_same_type<broadcast_extent<E, vector_extent_type<Args>...>, E>,
+        "the arguments cannot be broadcast to the extent of the input vector");
+
+    detail::map_inplace_impl<F, T, E, Args...>::call(fun, input.data(), args...);
+    return input;
 }
 
 }  // namespace kernel_float
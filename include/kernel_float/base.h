@@ -87,8 +87,44 @@ template<size_t N>
 struct extent<N> {
     static constexpr size_t value = N;
     static constexpr size_t size = N;
+    static constexpr size_t rank = 1;
 };
 
+/**
+ * Multi-dimensional extent, for example `extent<M, N>` for a matrix of `M` rows and `N` columns. The elements are
+ * stored contiguously in row-major order, thus `value` is the total number of elements.
+ */
+template<size_t N, size_t M, size_t... Rest>
+struct extent<N, M, Rest...> {
+    static constexpr size_t value = N * extent<M, Rest...>::value;
+    static constexpr size_t size = value;
+    static constexpr size_t rank = 2 + sizeof...(Rest);
+};
+
+namespace detail {
+/**
+ * Returns the size of dimension `axis` of the given extent.
+ */
+template<size_t... Ns>
+KERNEL_FLOAT_INLINE constexpr size_t extent_dim(extent<Ns...>, size_t axis) {
+    constexpr size_t dims[] = {Ns...};
+    return dims[axis];
+}
+
+/**
+ * Returns the number of elements between two consecutive indices along dimension `axis` of the given extent.
+ */
+template<size_t... Ns>
+KERNEL_FLOAT_INLINE constexpr size_t extent_stride(extent<Ns...>, size_t axis) {
+    constexpr size_t dims[] = {Ns...};
+    size_t result = 1;
+    for (size_t i = axis + 1; i < sizeof...(Ns); i++) {
+        result *= dims[i];
+    }
+    return result;
+}
+}  // namespace detail
+
 namespace detail {
 // Indicates that elements of type `T` offer less precision than floats, thus operations
 // on elements of type `T` can be performed by upcasting them to ` float`.
@@ -103,6 +139,20 @@ struct allow_float_fallback<float> {
 };
 }  // namespace detail
 
+/**
+ * The type used to compute a chain of operations on elements of type `T`, see `lazy`. By default, this is `T`
+ * itself. Types without native arithmetic (such as `__half` on the host) are computed as `float` instead, such that
+ * the inputs are converted once and the result is rounded once, instead of converting before and after every
+ * operation. This struct can be specialized to change the compute type of `T`.
+ */
+template<typename T>
+struct compute_type_policy {
+    using type = T;
+};
+
+template<typename T>
+using compute_type = typename compute_type_policy<T>::type;
+
 template<typename T>
 struct into_vector_impl {
     using value_type = T;
@@ -26,11 +26,37 @@ struct into_vector_impl<__nv_bfloat162> {
     }
 };
 
+// Native bfloat16 arithmetic is only available on devices of compute capability 8.0 or higher
+#if KERNEL_FLOAT_CUDA_ARCH < 800
+template<>
+struct compute_type_policy<__nv_bfloat16> {
+    using type = float;
+};
+#endif
+
 namespace detail {
 template<>
 struct allow_float_fallback<__nv_bfloat16> {
     static constexpr bool value = true;
 };
+
+template<>
+struct rounding_traits<__nv_bfloat16> {
+    static constexpr bool value = true;
+    static constexpr int digits = 8;
+
+    KERNEL_FLOAT_INLINE static __nv_bfloat16 next_up(__nv_bfloat16 input) {
+        __nv_bfloat16_raw raw = input;
+        raw.x = next_float_bits<unsigned short>(raw.x, 0x8000, true);
+        return raw;
+    }
+
+    KERNEL_FLOAT_INLINE static __nv_bfloat16 next_down(__nv_bfloat16 input) {
+        __nv_bfloat16_raw raw = input;
+        raw.x = next_float_bits<unsigned short>(raw.x, 0x8000, false);
+        return raw;
+    }
+};
 };  // namespace detail
 
 #if KERNEL_FLOAT_IS_DEVICE
@@ -98,6 +124,38 @@ KERNEL_FLOAT_BF16_UNARY_FUN(rcp, ::hrcp, ::h2rcp)
             result[0] = r.x, result[1] = r.y;                                                     \
         }                                                                                         \
     };                                                                                            \
+    template<>                                                                                    \
+    struct apply_impl<                                                                            \
+        apply_scalar_left<ops::NAME<__nv_bfloat16>, __nv_bfloat16>,                               \
+        2,                                                                                        \
+        __nv_bfloat16,                                                                            \
+        __nv_bfloat16> {                                                                          \
+        KERNEL_FLOAT_INLINE static void call(                                                     \
+            apply_scalar_left<ops::NAME<__nv_bfloat16>, __nv_bfloat16> fun,                       \
+            __nv_bfloat16* result,                                                                \
+            const __nv_bfloat16* b) {                                                             \
+            __nv_bfloat162 r = FUN2(                                                              \
+                __bfloat162bfloat162(fun.value),                                                  \
+                __nv_bfloat162 {b[0], b[1]});                                                     \
+            result[0] = r.x, result[1] = r.y;                                                     \
+        }                                                                                         \
+    };                                                                                            \
+    template<>                                                                                    \
+    struct apply_impl<                                                                            \
+        apply_scalar_right<ops::NAME<__nv_bfloat16>, __nv_bfloat16>,                              \
+        2,                                                                                        \
+        __nv_bfloat16,                                                                            \
+        __nv_bfloat16> {                                                                          \
+        KERNEL_FLOAT_INLINE static void call(                                                     \
+            apply_scalar_right<ops::NAME<__nv_bfloat16>, __nv_bfloat16> fun,                      \
+            __nv_bfloat16* result,                                                                \
+            const __nv_bfloat16* a) {                                                             \
+            __nv_bfloat162 r = FUN2(                                                              \
+                __nv_bfloat162 {a[0], a[1]},                                                      \
+                __bfloat162bfloat162(fun.value));                                                 \
+            result[0] = r.x, result[1] = r.y;                                                     \
+        }                                                                                         \
+    };                                                                                            \
     }
 #else
 #define KERNEL_FLOAT_BF16_BINARY_FUN(NAME, FUN1, FUN2)
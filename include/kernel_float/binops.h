@@ -31,6 +31,84 @@ using zip_common_type = vector<
     result_t<F, promoted_vector_value_type<L, R>, promoted_vector_value_type<L, R>>,
     broadcast_vector_extent_type<L, R>>;
 
+namespace detail {
+template<typename P, typename F, typename T, typename O, typename E, typename LE, typename RE>
+struct zip_common_impl {
+    template<typename L, typename R>
+    KERNEL_FLOAT_INLINE static vector_storage<O, E::value>
+    call(F fun, const L& left, const R& right) {
+        vector_storage<O, E::value> result;
+
+        policy_apply_impl<P, F, E::value, O, T, T>::call(
+            fun,
+            result.data(),
+            convert_impl<vector_value_type<L>, LE, T, E>::call(into_vector_storage(left)).data(),
+            convert_impl<vector_value_type<R>, RE, T, E>::call(into_vector_storage(right)).data());
+
+        return result;
+    }
+};
+
+// If the left operand is a scalar, it is passed to `F` by value instead of being broadcast to a vector
+template<typename P, typename F, typename T, typename O, typename E, typename RE>
+struct zip_common_impl<P, F, T, O, E, extent<1>, RE> {
+    template<typename L, typename R>
+    KERNEL_FLOAT_INLINE static vector_storage<O, E::value>
+    call(F fun, const L& left, const R& right) {
+        vector_storage<O, E::value> result;
+        T value = convert_impl<vector_value_type<L>, extent<1>, T, extent<1>>::call(
+                      into_vector_storage(left))
+                      .data()[0];
+
+        policy_apply_impl<P, apply_scalar_left<F, T>, E::value, O, T>::call(
+            {fun, value},
+            result.data(),
+            convert_impl<vector_value_type<R>, RE, T, E>::call(into_vector_storage(right)).data());
+
+        return result;
+    }
+};
+
+// If the right operand is a scalar, it is passed to `F` by value instead of being broadcast to a vector
+template<typename P, typename F, typename T, typename O, typename E, typename LE>
+struct zip_common_impl<P, F, T, O, E, LE, extent<1>> {
+    template<typename L, typename R>
+    KERNEL_FLOAT_INLINE static vector_storage<O, E::value>
+    call(F fun, const L& left, const R& right) {
+        vector_storage<O, E::value> result;
+        T value = convert_impl<vector_value_type<R>, extent<1>, T, extent<1>>::call(
+                      into_vector_storage(right))
+                      .data()[0];
+
+        policy_apply_impl<P, apply_scalar_right<F, T>, E::value, O, T>::call(
+            {fun, value},
+            result.data(),
+            convert_impl<vector_value_type<L>, LE, T, E>::call(into_vector_storage(left)).data());
+
+        return result;
+    }
+};
+
+template<typename P, typename F, typename T, typename O, typename E>
+struct zip_common_impl<P, F, T, O, E, extent<1>, extent<1>> {
+    template<typename L, typename R>
+    KERNEL_FLOAT_INLINE static vector_storage<O, E::value>
+    call(F fun, const L& left, const R& right) {
+        vector_storage<O, E::value> result;
+
+        policy_apply_impl<P, F, E::value, O, T, T>::call(
+            fun,
+            result.data(),
+            convert_impl<vector_value_type<L>, extent<1>, T, E>::call(into_vector_storage(left))
+                .data(),
+            convert_impl<vector_value_type<R>, extent<1>, T, E>::call(into_vector_storage(right))
+                .data());
+
+        return result;
+    }
+};
+}  // namespace detail
+
 /**
  * Combines the elements from the two inputs (`left` and `right`)  element-wise, applying a provided binary
  * function (`fun`) to each pair of corresponding elements. The elements are promoted to a common type before applying
@@ -46,36 +124,43 @@ using zip_common_type = vector<
  */
 template<typename F, typename L, typename R>
 KERNEL_FLOAT_INLINE zip_common_type<F, L, R> zip_common(F fun, const L& left, const R& right) {
+    return zip_common(default_policy {}, fun, left, right);
+}
+
+/**
+ * Same as `zip_common(fun, left, right)`, but uses the given math policy (`fast_math_policy` or `precise_policy`)
+ * to apply `fun`.
+ */
+template<typename P, typename F, typename L, typename R, typename = enable_if_t<is_math_policy<P>>>
+KERNEL_FLOAT_INLINE zip_common_type<F, L, R>
+zip_common(P /*policy*/, F fun, const L& left, const R& right) {
     using T = promoted_vector_value_type<L, R>;
     using O = result_t<F, T, T>;
     using E = broadcast_vector_extent_type<L, R>;
+    using LE = vector_extent_type<L>;
+    using RE = vector_extent_type<R>;
 
-    vector_storage<O, E::value> result;
-
-// Use the `apply_fastmath_impl` if KERNEL_FLOAT_FAST_MATH is enabled
-#if KERNEL_FLOAT_FAST_MATH
-    using apply_impl = detail::apply_fastmath_impl<F, E::value, O, T, T>;
-#else
-    using apply_impl = detail::apply_impl<F, E::value, O, T, T>;
-#endif
-
-    apply_impl::call(
-        fun,
-        result.data(),
-        detail::convert_impl<vector_value_type<L>, vector_extent_type<L>, T, E>::call(
-            into_vector_storage(left))
-            .data(),
-        detail::convert_impl<vector_value_type<R>, vector_extent_type<R>, T, E>::call(
-            into_vector_storage(right))
-            .data());
-
-    return result;
+    return detail::zip_common_impl<P, F, T, O, E, LE, RE>::call(fun, left, right);
 }
 
 #define KERNEL_FLOAT_DEFINE_BINARY_FUN(NAME)                                               \
     template<typename L, typename R, typename C = promoted_vector_value_type<L, R>>        \
     KERNEL_FLOAT_INLINE zip_common_type<ops::NAME<C>, L, R> NAME(L&& left, R&& right) {    \
         return zip_common(ops::NAME<C> {}, std::forward<L>(left), std::forward<R>(right)); \
+    }                                                                                      \
+    template<                                                                              \
+        typename P,                                                                        \
+        typename L,                                                                        \
+        typename R,                                                                        \
+        typename C = promoted_vector_value_type<L, R>,                                     \
+        typename = enable_if_t<is_math_policy<P>>>                                         \
+    KERNEL_FLOAT_INLINE zip_common_type<ops::NAME<C>, L, R>                                \
+    NAME(P policy, L&& left, R&& right) {                                                  \
+        return zip_common(                                                                 \
+            policy,                                                                        \
+            ops::NAME<C> {},                                                               \
+            std::forward<L>(left),                                                         \
+            std::forward<R>(right));                                                       \
     }
 
 #define KERNEL_FLOAT_DEFINE_BINARY(NAME, EXPR, EXPR_F64, EXPR_F32)         \
@@ -172,8 +257,11 @@ static constexpr bool is_vector_assign_allowed =
         typename = enable_if_t<is_vector_assign_allowed<ops::NAME, T, E, R>>>        \
     KERNEL_FLOAT_INLINE vector<T, E>& operator OP(vector<T, E>& lhs, const R& rhs) { \
         using F = ops::NAME<T>;                                                      \
-        lhs = zip_common(F {}, lhs, rhs);                                            \
-        return lhs;                                                                  \
+        using RT = vector_value_type<R>;                                             \
+        using RE = vector_extent_type<R>;                                            \
+        vector<T, RE> right =                                                        \
+            detail::convert_impl<RT, RE, T, RE>::call(into_vector_storage(rhs));     \
+        return map_inplace(F {}, lhs, right);                                        \
     }
 
 KERNEL_FLOAT_DEFINE_BINARY_ASSIGN_OP(add, +=)
@@ -297,18 +385,47 @@ struct multiply<bool> {
 };  // namespace ops
 
 namespace detail {
+// Only floating-point division can be replaced by a multiplication with the reciprocal
+template<typename T, size_t N, bool = is_promoted_float<T>::value>
+struct fast_divide_impl: apply_impl<ops::divide<T>, N, T, T, T> {};
+
 template<typename T, size_t N>
-struct apply_fastmath_impl<ops::divide<T>, N, T, T, T> {
+struct fast_divide_impl<T, N, true> {
     KERNEL_FLOAT_INLINE static void
     call(ops::divide<T> fun, T* result, const T* lhs, const T* rhs) {
         T rhs_rcp[N];
 
         // Fast way to perform division is to multiply by the reciprocal
-        apply_fastmath_impl<ops::rcp<T>, N, T, T, T>::call({}, rhs_rcp, rhs);
+        apply_fastmath_impl<ops::rcp<T>, N, T, T>::call({}, rhs_rcp, rhs);
         apply_fastmath_impl<ops::multiply<T>, N, T, T, T>::call({}, result, lhs, rhs_rcp);
     }
 };
 
+template<typename T, size_t N>
+struct apply_fastmath_impl<ops::divide<T>, N, T, T, T>: fast_divide_impl<T, N> {};
+
+template<typename T, size_t N, bool = is_promoted_float<T>::value>
+struct fast_divide_scalar_impl: apply_impl<apply_scalar_right<ops::divide<T>, T>, N, T, T> {};
+
+template<typename T, size_t N>
+struct fast_divide_scalar_impl<T, N, true> {
+    KERNEL_FLOAT_INLINE static void
+    call(apply_scalar_right<ops::divide<T>, T> fun, T* result, const T* lhs) {
+        T rhs_rcp;
+
+        // Division by a scalar only requires a single reciprocal
+        apply_fastmath_impl<ops::rcp<T>, 1, T, T>::call({}, &rhs_rcp, &fun.value);
+        apply_fastmath_impl<apply_scalar_right<ops::multiply<T>, T>, N, T, T>::call(
+            {{}, rhs_rcp},
+            result,
+            lhs);
+    }
+};
+
+template<typename T, size_t N>
+struct apply_fastmath_impl<apply_scalar_right<ops::divide<T>, T>, N, T, T>:
+    fast_divide_scalar_impl<T, N> {};
+
 #if KERNEL_FLOAT_IS_DEVICE
 template<size_t N>
 struct apply_fastmath_impl<ops::divide<float>, N, float, float, float> {
@@ -320,6 +437,17 @@ struct apply_fastmath_impl<ops::divide<float>, N, float, float, float> {
         }
     }
 };
+
+template<size_t N>
+struct apply_fastmath_impl<apply_scalar_right<ops::divide<float>, float>, N, float, float> {
+    KERNEL_FLOAT_INLINE static void
+    call(apply_scalar_right<ops::divide<float>, float> fun, float* result, const float* lhs) {
+#pragma unroll
+        for (size_t i = 0; i < N; i++) {
+            result[i] = __fdividef(lhs[i], fun.value);
+        }
+    }
+};
 #endif
 }  // namespace detail
 
@@ -348,16 +476,10 @@ struct cross_impl {
     KERNEL_FLOAT_INLINE
     static vector<T, extent<3>>
     call(const vector_storage<T, 3>& av, const vector_storage<T, 3>& bv) {
-        auto a = av.data();
-        auto b = bv.data();
-        vector<T, extent<6>> v0 = {a[1], a[2], a[0], a[2], a[0], a[1]};
-        vector<T, extent<6>> v1 = {b[2], b[0], b[1], b[1], b[2], b[0]};
+        vector<T, extent<6>> v0 = shuffle<1, 2, 0, 2, 0, 1>(av);
+        vector<T, extent<6>> v1 = shuffle<2, 0, 1, 1, 2, 0>(bv);
         vector<T, extent<6>> rv = v0 * v1;
-
-        auto r = rv.data();
-        vector<T, extent<3>> r0 = {r[0], r[1], r[2]};
-        vector<T, extent<3>> r1 = {r[3], r[4], r[5]};
-        return r0 - r1;
+        return shuffle<0, 1, 2>(rv) - shuffle<3, 4, 5>(rv);
     }
 };
 };  // namespace detail
@@ -122,6 +122,74 @@ KERNEL_FLOAT_INLINE AssignConversionProxy<T, M> cast_to(T& input) {
     return AssignConversionProxy<T, M>(&input);
 }
 
+namespace detail {
+/**
+ * Counter-based generator of random bits: returns a hash of `seed` and `counter` (using the finalizer of
+ * MurmurHash3). Different counters give statistically independent bits, without requiring any state.
+ */
+KERNEL_FLOAT_INLINE unsigned int random_bits(unsigned int seed, unsigned int counter) {
+    unsigned int x = seed + (counter + 1) * 0x9E3779B9u;
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+}
+}  // namespace detail
+
+namespace ops {
+template<typename T, typename R>
+struct cast_stochastic {
+    KERNEL_FLOAT_INLINE R operator()(T input, unsigned int bits) {
+        using W = widest_promote_t<float, T>;
+        R lo = cast<T, R, RoundingMode::DOWN> {}(input);
+        R hi = cast<T, R, RoundingMode::UP> {}(input);
+
+        W x = cast<T, W> {}(input);
+        W lo_value = cast<R, W> {}(lo);
+        W hi_value = cast<R, W> {}(hi);
+
+        // Round up with a probability equal to the relative distance between `lo` and `x`. Uses 24 random bits.
+        W u = W(bits >> 8) * W(1.0 / 16777216.0);
+        return x - lo_value > u * (hi_value - lo_value) ? hi : lo;
+    }
+};
+}  // namespace ops
+
+/**
+ * Cast the elements of the given vector `input` to type `R` using stochastic rounding. Each element is rounded
+ * up or down with a probability proportional to its distance to those two values, meaning that the result is
+ * unbiased on average, unlike rounding to nearest.
+ *
+ * The random bits are a counter-based hash of `seed` and the index of each element, thus the result is
+ * deterministic for a given `seed`. Use a different `seed` for each call, for example, by combining the thread
+ * index and the iteration number.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 2> input = {1.0f, 1.0002f};
+ * vec<half, 2> result = cast_stochastic<half>(input, seed); // [1.0, 1.0 or 1.000977]
+ * ```
+ */
+template<typename R, typename V>
+KERNEL_FLOAT_INLINE vector<R, vector_extent_type<V>>
+cast_stochastic(const V& input, unsigned int seed) {
+    using E = vector_extent_type<V>;
+    vector_storage<unsigned int, E::value> bits;
+
+#pragma unroll
+    for (size_t i = 0; i < E::value; i++) {
+        bits.data()[i] = detail::random_bits(seed, (unsigned int)i);
+    }
+
+    return map(
+        ops::cast_stochastic<vector_value_type<V>, R> {},
+        input,
+        vector<unsigned int, E>(bits));
+}
+
 /**
  * Returns a vector containing `N` copies of `value`.
  *
@@ -212,6 +280,76 @@ KERNEL_FLOAT_INLINE vector<T, E> ones_like(const V& = {}) {
     return ones<T>(E {});
 }
 
+namespace detail {
+template<typename T, typename I>
+struct shuffle_impl;
+
+template<typename T, size_t... Is>
+struct shuffle_impl<T, index_sequence<Is...>> {
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static vector_storage<T, sizeof...(Is)>
+    call(const vector_storage<T, N>& input) {
+        static_assert(((Is < N) && ...), "shuffle index out of range");
+        return {input.data()[Is]...};
+    }
+};
+}  // namespace detail
+
+/**
+ * Returns a new vector where element `i` is element `Is[i]` of ``input``. The indices are compile-time constants,
+ * so the elements are simply renamed without any copying at runtime or bounds checks. Indices can be repeated and
+ * the result can have a different length than ``input``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {0.0f, 1.0f, 2.0f, 3.0f};
+ * vec<float, 4> a = shuffle<3, 2, 1, 0>(x);  // Returns [3.0f, 2.0f, 1.0f, 0.0f]
+ * vec<float, 2> b = shuffle<1, 1>(x);  // Returns [1.0f, 1.0f]
+ * ```
+ */
+template<size_t... Is, typename V>
+KERNEL_FLOAT_INLINE vector<vector_value_type<V>, extent<sizeof...(Is)>> shuffle(const V& input) {
+    static_assert(sizeof...(Is) > 0, "shuffle requires at least one index");
+    using T = vector_value_type<V>;
+    return detail::shuffle_impl<T, index_sequence<Is...>>::call(into_vector_storage(input));
+}
+
+/**
+ * Returns a new vector where element `i` is element `Is[i]` of the concatenation of ``left`` and ``right``. Thus,
+ * indices smaller than the length of ``left`` refer to ``left`` and other indices refer to ``right``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 2> x = {0.0f, 1.0f};
+ * vec<float, 2> y = {2.0f, 3.0f};
+ * vec<float, 4> z = shuffle<0, 2, 1, 3>(x, y);  // Returns [0.0f, 2.0f, 1.0f, 3.0f]
+ * ```
+ */
+template<size_t... Is, typename L, typename R, typename T = promoted_vector_value_type<L, R>>
+KERNEL_FLOAT_INLINE vector<T, extent<sizeof...(Is)>> shuffle(const L& left, const R& right) {
+    static_assert(sizeof...(Is) > 0, "shuffle requires at least one index");
+    static constexpr size_t NL = vector_extent<L>;
+    static constexpr size_t NR = vector_extent<R>;
+
+    vector_storage<T, NL> a = convert_storage<T, NL>(left);
+    vector_storage<T, NR> b = convert_storage<T, NR>(right);
+    vector_storage<T, NL + NR> items;
+
+#pragma unroll
+    for (size_t i = 0; i < NL; i++) {
+        items.data()[i] = a.data()[i];
+    }
+
+#pragma unroll
+    for (size_t i = 0; i < NR; i++) {
+        items.data()[NL + i] = b.data()[i];
+    }
+
+    return detail::shuffle_impl<T, index_sequence<Is...>>::call(items);
+}
+
 }  // namespace kernel_float
 
 #endif
@@ -24,11 +24,37 @@ struct into_vector_impl<__half2> {
     }
 };
 
+// There is no native half-precision arithmetic on the host, so chains of operations are computed in float
+#if !KERNEL_FLOAT_IS_DEVICE
+template<>
+struct compute_type_policy<__half> {
+    using type = float;
+};
+#endif
+
 namespace detail {
 template<>
 struct allow_float_fallback<__half> {
     static constexpr bool value = true;
 };
+
+template<>
+struct rounding_traits<__half> {
+    static constexpr bool value = true;
+    static constexpr int digits = 11;
+
+    KERNEL_FLOAT_INLINE static __half next_up(__half input) {
+        __half_raw raw = input;
+        raw.x = next_float_bits<unsigned short>(raw.x, 0x8000, true);
+        return raw;
+    }
+
+    KERNEL_FLOAT_INLINE static __half next_down(__half input) {
+        __half_raw raw = input;
+        raw.x = next_float_bits<unsigned short>(raw.x, 0x8000, false);
+        return raw;
+    }
+};
 };  // namespace detail
 
 #if KERNEL_FLOAT_IS_DEVICE
@@ -71,24 +97,44 @@ KERNEL_FLOAT_FP16_UNARY_FUN(trunc, ::htrunc, ::h2trunc)
 KERNEL_FLOAT_FP16_UNARY_FUN(rcp, ::hrcp, ::h2rcp)
 
 #if KERNEL_FLOAT_IS_DEVICE
-#define KERNEL_FLOAT_FP16_BINARY_FUN(NAME, FUN1, FUN2)                              \
-    namespace ops {                                                                 \
-    template<>                                                                      \
-    struct NAME<__half> {                                                           \
-        KERNEL_FLOAT_INLINE __half operator()(__half left, __half right) const {    \
-            return FUN1(left, right);                                               \
-        }                                                                           \
-    };                                                                              \
-    }                                                                               \
-    namespace detail {                                                              \
-    template<>                                                                      \
-    struct apply_impl<ops::NAME<__half>, 2, __half, __half, __half> {               \
-        KERNEL_FLOAT_INLINE static void                                             \
-        call(ops::NAME<__half>, __half* result, const __half* a, const __half* b) { \
-            __half2 r = FUN2(__half2 {a[0], a[1]}, __half2 {b[0], b[1]});           \
-            result[0] = r.x, result[1] = r.y;                                       \
-        }                                                                           \
-    };                                                                              \
+#define KERNEL_FLOAT_FP16_BINARY_FUN(NAME, FUN1, FUN2)                                    \
+    namespace ops {                                                                       \
+    template<>                                                                            \
+    struct NAME<__half> {                                                                 \
+        KERNEL_FLOAT_INLINE __half operator()(__half left, __half right) const {          \
+            return FUN1(left, right);                                                     \
+        }                                                                                 \
+    };                                                                                    \
+    }                                                                                     \
+    namespace detail {                                                                    \
+    template<>                                                                            \
+    struct apply_impl<ops::NAME<__half>, 2, __half, __half, __half> {                     \
+        KERNEL_FLOAT_INLINE static void                                                   \
+        call(ops::NAME<__half>, __half* result, const __half* a, const __half* b) {       \
+            __half2 r = FUN2(__half2 {a[0], a[1]}, __half2 {b[0], b[1]});                 \
+            result[0] = r.x, result[1] = r.y;                                             \
+        }                                                                                 \
+    };                                                                                    \
+    template<>                                                                            \
+    struct apply_impl<apply_scalar_left<ops::NAME<__half>, __half>, 2, __half, __half> {  \
+        KERNEL_FLOAT_INLINE static void call(                                             \
+            apply_scalar_left<ops::NAME<__half>, __half> fun,                             \
+            __half* result,                                                               \
+            const __half* b) {                                                            \
+            __half2 r = FUN2(__half2half2(fun.value), __half2 {b[0], b[1]});              \
+            result[0] = r.x, result[1] = r.y;                                             \
+        }                                                                                 \
+    };                                                                                    \
+    template<>                                                                            \
+    struct apply_impl<apply_scalar_right<ops::NAME<__half>, __half>, 2, __half, __half> { \
+        KERNEL_FLOAT_INLINE static void call(                                             \
+            apply_scalar_right<ops::NAME<__half>, __half> fun,                            \
+            __half* result,                                                               \
+            const __half* a) {                                                            \
+            __half2 r = FUN2(__half2 {a[0], a[1]}, __half2half2(fun.value));              \
+            result[0] = r.x, result[1] = r.y;                                             \
+        }                                                                                 \
+    };                                                                                    \
     }
 #else
 #define KERNEL_FLOAT_FP16_BINARY_FUN(NAME, FUN1, FUN2)
@@ -27,6 +27,47 @@ template<>
 struct allow_float_fallback<__nv_fp8_e5m2> {
     static constexpr bool value = true;
 };
+
+template<>
+struct rounding_traits<__nv_fp8_e4m3> {
+    static constexpr bool value = true;
+    static constexpr int digits = 4;
+
+    // There is no infinity for e4m3, so stepping beyond the largest value saturates.
+    KERNEL_FLOAT_INLINE static __nv_fp8_e4m3 step(__nv_fp8_e4m3 input, bool up) {
+        __nv_fp8_storage_t bits = next_float_bits<__nv_fp8_storage_t>(input.__x, 0x80, up);
+
+        if ((bits & 0x7F) != 0x7F) {
+            input.__x = bits;
+        }
+
+        return input;
+    }
+
+    KERNEL_FLOAT_INLINE static __nv_fp8_e4m3 next_up(__nv_fp8_e4m3 input) {
+        return step(input, true);
+    }
+
+    KERNEL_FLOAT_INLINE static __nv_fp8_e4m3 next_down(__nv_fp8_e4m3 input) {
+        return step(input, false);
+    }
+};
+
+template<>
+struct rounding_traits<__nv_fp8_e5m2> {
+    static constexpr bool value = true;
+    static constexpr int digits = 3;
+
+    KERNEL_FLOAT_INLINE static __nv_fp8_e5m2 next_up(__nv_fp8_e5m2 input) {
+        input.__x = next_float_bits<__nv_fp8_storage_t>(input.__x, 0x80, true);
+        return input;
+    }
+
+    KERNEL_FLOAT_INLINE static __nv_fp8_e5m2 next_down(__nv_fp8_e5m2 input) {
+        input.__x = next_float_bits<__nv_fp8_storage_t>(input.__x, 0x80, false);
+        return input;
+    }
+};
 }  // namespace detail
 }  // namespace kernel_float
 
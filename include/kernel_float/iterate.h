@@ -2,6 +2,7 @@
 #define KERNEL_FLOAT_ITERATE_H
 
 #include "base.h"
+#include "binops.h"
 #include "conversion.h"
 
 namespace kernel_float {
@@ -313,6 +314,596 @@ KERNEL_FLOAT_INLINE select_type<V, Is...> select(const V& input, const Is&... in
     return outputs;
 }
 
+namespace detail {
+template<typename T, size_t K, size_t N, typename I>
+struct lookup_impl {
+    KERNEL_FLOAT_INLINE static void call(T* output, const T* table, const I* indices) {
+#pragma unroll
+        for (size_t i = 0; i < N; i++) {
+            // The remainder is computed in the type of the index, such that negative indices wrap around as well
+            I remainder = I(indices[i] % I(K));
+            size_t index = size_t(remainder < I(0) ? remainder + I(K) : remainder);
+
+#if KERNEL_FLOAT_IS_DEVICE
+            // Indexing into a register array with a runtime index forces the array into local memory. Instead,
+            // the entry is selected using a chain of comparisons, which keeps the table in registers.
+            T result = table[0];
+
+#pragma unroll
+            for (size_t j = 1; j < K; j++) {
+                result = index == j ? table[j] : result;
+            }
+
+            output[i] = result;
+#else
+            output[i] = table[index];
+#endif
+        }
+    }
+};
+}  // namespace detail
+
+/**
+ * Returns a vector where element ``i`` is ``table[indices[i]]``. The ``table`` is a small vector (for example, an
+ * activation function or a decoding table of up to 32 entries) that is kept in registers. The indices are taken
+ * modulo the size of the table (where ``-1`` is the last entry), thus the lookup is never out of bounds.
+ *
+ * On the device, every lookup is performed by comparing the index against all entries of the table, which avoids
+ * spilling the table to local memory. This is efficient for small tables only.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> table = {0.0f, 0.5f, 1.0f, 1.5f};
+ * vec<int, 3> indices = {3, 0, 1};
+ * vec<float, 3> x = lookup(table, indices);  // Returns [1.5f, 0.0f, 0.5f]
+ * ```
+ */
+template<typename V, typename I>
+KERNEL_FLOAT_INLINE vector<vector_value_type<V>, vector_extent_type<I>>
+lookup(const V& table, const I& indices) {
+    using T = vector_value_type<V>;
+    static constexpr size_t K = vector_extent<V>;
+    static constexpr size_t N = vector_extent<I>;
+
+    vector_storage<T, N> result;
+    detail::lookup_impl<T, K, N, vector_value_type<I>>::call(
+        result.data(),
+        into_vector_storage(table).data(),
+        into_vector_storage(indices).data());
+    return result;
+}
+
+/**
+ * Permutes the elements of ``input`` according to ``indices``, which must be a vector of the same length. Element
+ * ``i`` of the result is ``input[indices[i]]``. Contrary to `select`, the indices are not bounds checked but taken
+ * modulo the length of ``input``. Use `shuffle` if the indices are known at compile time.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {10.0f, 20.0f, 30.0f, 40.0f};
+ * vec<int, 4> indices = {3, 2, 1, 0};
+ * vec<float, 4> y = permute(x, indices);  // Returns [40.0f, 30.0f, 20.0f, 10.0f]
+ * ```
+ */
+template<typename V, typename I>
+KERNEL_FLOAT_INLINE into_vector_type<V> permute(const V& input, const I& indices) {
+    static_assert(
+        vector_extent<V> == vector_extent<I>,
+        "the number of indices must equal the length of the input");
+    return lookup(input, indices);
+}
+
+namespace detail {
+template<size_t M, typename Map, typename = make_index_sequence<M>>
+struct index_map_sequence;
+
+template<size_t M, typename Map, size_t... Is>
+struct index_map_sequence<M, Map, index_sequence<Is...>> {
+    using type = index_sequence<Map::call(Is)...>;
+};
+
+/**
+ * Returns the `shuffle` of ``input`` where element `i` of the result is element `Map::call(i)` of ``input``.
+ */
+template<size_t M, typename Map, typename T, size_t N>
+KERNEL_FLOAT_INLINE vector_storage<T, M> shuffle_map(const vector_storage<T, N>& input) {
+    return shuffle_impl<T, typename index_map_sequence<M, Map>::type>::call(input);
+}
+
+template<size_t Offset, size_t Stride = 1>
+struct strided_index_map {
+    KERNEL_FLOAT_INLINE static constexpr size_t call(size_t i) {
+        return Offset + i * Stride;
+    }
+};
+
+template<size_t Offset, size_t N>
+struct rotate_index_map {
+    KERNEL_FLOAT_INLINE static constexpr size_t call(size_t i) {
+        return (i + Offset) % N;
+    }
+};
+
+template<size_t N>
+struct reverse_index_map {
+    KERNEL_FLOAT_INLINE static constexpr size_t call(size_t i) {
+        return N - 1 - i;
+    }
+};
+
+template<size_t N>
+struct interleave_index_map {
+    KERNEL_FLOAT_INLINE static constexpr size_t call(size_t i) {
+        return (i % 2) * N + i / 2;
+    }
+};
+}  // namespace detail
+
+/**
+ * Returns the elements of ``input`` at the positions ``Begin, Begin + 1, ..., End - 1``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 5> x = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f};
+ * vec<float, 3> y = slice<1, 4>(x);  // Returns [1.0f, 2.0f, 3.0f]
+ * ```
+ */
+template<size_t Begin, size_t End, typename V>
+KERNEL_FLOAT_INLINE vector<vector_value_type<V>, extent<End - Begin>> slice(const V& input) {
+    static_assert(Begin <= End && End <= vector_extent<V>, "invalid slice range");
+    return detail::shuffle_map<End - Begin, detail::strided_index_map<Begin>>(
+        into_vector_storage(input));
+}
+
+/**
+ * Splits ``input`` into `K` consecutive parts of equal length. The result is a vector of `K` vectors, which can be
+ * combined again using `flatten`.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {0.0f, 1.0f, 2.0f, 3.0f};
+ * vec<vec<float, 2>, 2> halves = split<2>(x);  // Returns [[0.0f, 1.0f], [2.0f, 3.0f]]
+ * vec<float, 2> lo = halves[0];
+ * ```
+ */
+template<size_t K, typename V>
+KERNEL_FLOAT_INLINE vector<vector<vector_value_type<V>, extent<vector_extent<V> / K>>, extent<K>>
+split(const V& input) {
+    using T = vector_value_type<V>;
+    static constexpr size_t N = vector_extent<V>;
+    static_assert(K > 0 && N % K == 0, "the length of the vector must be a multiple of K");
+
+    vector_storage<T, N> items = into_vector_storage(input);
+    vector_storage<vector<T, extent<N / K>>, K> result;
+
+#pragma unroll
+    for (size_t k = 0; k < K; k++) {
+#pragma unroll
+        for (size_t i = 0; i < N / K; i++) {
+            result.data()[k][i] = items.data()[k * (N / K) + i];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Interleaves the elements of ``left`` and ``right``, which must have the same length. This is the inverse of
+ * `deinterleave`.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 2> x = {0.0f, 2.0f};
+ * vec<float, 2> y = {1.0f, 3.0f};
+ * vec<float, 4> z = interleave(x, y);  // Returns [0.0f, 1.0f, 2.0f, 3.0f]
+ * ```
+ */
+template<typename L, typename R, typename T = promoted_vector_value_type<L, R>>
+KERNEL_FLOAT_INLINE vector<T, extent<2 * vector_extent<L>>>
+interleave(const L& left, const R& right) {
+    static constexpr size_t N = vector_extent<L>;
+    static_assert(N == vector_extent<R>, "the vectors to interleave must have the same length");
+
+    vector_storage<T, 2 * N> items;
+    vector_storage<T, N> a = convert_storage<T, N>(left);
+    vector_storage<T, N> b = convert_storage<T, N>(right);
+
+#pragma unroll
+    for (size_t i = 0; i < N; i++) {
+        items.data()[i] = a.data()[i];
+        items.data()[N + i] = b.data()[i];
+    }
+
+    return detail::shuffle_map<2 * N, detail::interleave_index_map<N>>(items);
+}
+
+/**
+ * Splits the elements of ``input`` into `K` vectors, where vector `k` contains the elements at the positions
+ * ``k, k + K, k + 2 * K, ...``. For the default `K = 2`, this returns the elements at the even and odd positions.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {0.0f, 1.0f, 2.0f, 3.0f};
+ * vec<vec<float, 2>, 2> y = deinterleave(x);  // Returns [[0.0f, 2.0f], [1.0f, 3.0f]]
+ * ```
+ */
+template<size_t K = 2, typename V>
+KERNEL_FLOAT_INLINE vector<vector<vector_value_type<V>, extent<vector_extent<V> / K>>, extent<K>>
+deinterleave(const V& input) {
+    using T = vector_value_type<V>;
+    static constexpr size_t N = vector_extent<V>;
+    static_assert(K > 0 && N % K == 0, "the length of the vector must be a multiple of K");
+
+    vector_storage<T, N> items = into_vector_storage(input);
+    vector_storage<vector<T, extent<N / K>>, K> result;
+
+#pragma unroll
+    for (size_t k = 0; k < K; k++) {
+#pragma unroll
+        for (size_t i = 0; i < N / K; i++) {
+            result.data()[k][i] = items.data()[i * K + k];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Rotates the elements of ``input`` to the left by `K` positions, such that element ``i`` of the result is element
+ * ``(i + K) % N`` of ``input``. A negative `K` rotates to the right.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {0.0f, 1.0f, 2.0f, 3.0f};
+ * vec<float, 4> y = rotate<1>(x);  // Returns [1.0f, 2.0f, 3.0f, 0.0f]
+ * vec<float, 4> z = rotate<-1>(x);  // Returns [3.0f, 0.0f, 1.0f, 2.0f]
+ * ```
+ */
+template<int K, typename V>
+KERNEL_FLOAT_INLINE into_vector_type<V> rotate(const V& input) {
+    static constexpr int N = int(vector_extent<V>);
+    static constexpr size_t offset = size_t(((K % N) + N) % N);
+    return detail::shuffle_map<N, detail::rotate_index_map<offset, N>>(
+        into_vector_storage(input));
+}
+
+/**
+ * Reverses the order of the elements of ``input``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 3> x = {0.0f, 1.0f, 2.0f};
+ * vec<float, 3> y = reverse(x);  // Returns [2.0f, 1.0f, 0.0f]
+ * ```
+ */
+template<typename V>
+KERNEL_FLOAT_INLINE into_vector_type<V> reverse(const V& input) {
+    static constexpr size_t N = vector_extent<V>;
+    return detail::shuffle_map<N, detail::reverse_index_map<N>>(into_vector_storage(input));
+}
+
+namespace detail {
+/**
+ * Generates the comparators of a sorting network of size `n` based on Batcher's odd-even merge sort and returns
+ * the number of comparators. If `n` is not a power of two, the comparators that refer to elements beyond `n` are
+ * dropped, which is equivalent to padding the input with positive infinity.
+ */
+KERNEL_FLOAT_INLINE
+constexpr size_t generate_sort_network(size_t n, size_t* lo = nullptr, size_t* hi = nullptr) {
+    size_t count = 0;
+
+    for (size_t p = 1; p < n; p += p) {
+        for (size_t k = p; k >= 1; k /= 2) {
+            for (size_t j = k % p; j + k < n; j += 2 * k) {
+                for (size_t i = 0; i < k && i + j + k < n; i++) {
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                        if (lo != nullptr && hi != nullptr) {
+                            lo[count] = i + j;
+                            hi[count] = i + j + k;
+                        }
+
+                        count++;
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Sorting network of size `N`. The comparators are generated at compile-time, thus all indices are constants
+ * after unrolling and the network contains no data-dependent control flow.
+ */
+template<size_t N>
+struct sort_network {
+    static constexpr size_t size = generate_sort_network(N);
+
+    struct comparators {
+        size_t lo[size > 0 ? size : 1] = {};
+        size_t hi[size > 0 ? size : 1] = {};
+    };
+
+    KERNEL_FLOAT_INLINE
+    static constexpr comparators build() {
+        comparators result;
+        generate_sort_network(N, result.lo, result.hi);
+        return result;
+    }
+
+    template<typename F>
+    KERNEL_FLOAT_INLINE static void call(F compare_exchange) {
+        constexpr comparators network = build();
+
+#pragma unroll
+        for (size_t c = 0; c < size; c++) {
+            compare_exchange(network.lo[c], network.hi[c]);
+        }
+    }
+};
+
+template<typename T, size_t N>
+struct sort_impl {
+    KERNEL_FLOAT_INLINE
+    static void call(T* data) {
+        sort_network<N>::call([&](size_t i, size_t j) {
+            T a = data[i];
+            T b = data[j];
+            data[i] = ops::min<T> {}(a, b);
+            data[j] = ops::max<T> {}(a, b);
+        });
+    }
+};
+
+template<typename K, typename T, size_t N, typename Less = ops::less<K>>
+struct sort_by_key_impl {
+    KERNEL_FLOAT_INLINE
+    static void call(K* keys, T* values) {
+        sort_network<N>::call([&](size_t i, size_t j) {
+            K a = keys[i];
+            K b = keys[j];
+            T x = values[i];
+            T y = values[j];
+            bool swap = Less {}(b, a);
+
+            keys[i] = swap ? b : a;
+            keys[j] = swap ? a : b;
+            values[i] = swap ? y : x;
+            values[j] = swap ? x : y;
+        });
+    }
+};
+}  // namespace detail
+
+/**
+ * Sorts the elements of the vector `input` in ascending order. The sort is performed using a sorting network
+ * that is generated at compile-time from `ops::min` and `ops::max`, thus it does not contain any branches or
+ * data-dependent control flow. This makes it suitable for sorting small vectors (for example, `N <= 32`) that
+ * reside in registers.
+ *
+ * Note that NaN values are not preserved since `min` and `max` ignore NaNs.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 5> x = {5, 0, 2, 1, 0};
+ * vec<int, 5> y = sort(x);  // Returns [0, 0, 1, 2, 5]
+ * ```
+ */
+template<typename V>
+KERNEL_FLOAT_INLINE into_vector_type<V> sort(const V& input) {
+    using T = vector_value_type<V>;
+    vector_storage<T, vector_extent<V>> result = into_vector_storage(input);
+    detail::sort_impl<T, vector_extent<V>>::call(result.data());
+    return result;
+}
+
+/**
+ * Sorts the elements of `values` by the corresponding elements of `keys` in ascending order and returns the
+ * reordered `values`. Like `sort`, this uses a compile-time sorting network without data-dependent control flow.
+ * The order of elements having equal keys is not specified.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 3> keys = {3.0f, 1.0f, 2.0f};
+ * vec<int, 3> values = {10, 20, 30};
+ * vec<int, 3> y = sort_by_key(keys, values);  // Returns [20, 30, 10]
+ * ```
+ */
+template<
+    typename K,
+    typename V,
+    typename E = broadcast_vector_extent_type<K, V>,
+    typename T = vector_value_type<V>>
+KERNEL_FLOAT_INLINE vector<T, E> sort_by_key(const K& keys, const V& values) {
+    using KeyType = vector_value_type<K>;
+    vector_storage<KeyType, E::value> key_storage = convert_storage<KeyType>(keys, E {});
+    vector_storage<T, E::value> value_storage = convert_storage<T>(values, E {});
+
+    detail::sort_by_key_impl<KeyType, T, E::value>::call(key_storage.data(), value_storage.data());
+    return value_storage;
+}
+
+/**
+ * Returns the median of the elements of the vector `input`. If the vector has an even number of elements, the
+ * lower of the two middle elements is returned. See `sort` for details on the implementation.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 5> x = {5, 0, 2, 1, 0};
+ * int y = median(x);  // Returns 1
+ * ```
+ */
+template<typename V>
+KERNEL_FLOAT_INLINE vector_value_type<V> median(const V& input) {
+    static constexpr size_t N = vector_extent<V>;
+    static_assert(N > 0, "cannot take the median of an empty vector");
+
+    using T = vector_value_type<V>;
+    vector_storage<T, N> result = into_vector_storage(input);
+    detail::sort_impl<T, N>::call(result.data());
+    return result.data()[(N - 1) / 2];
+}
+
+/**
+ * The result of `top_k`: the `K` largest values in descending order together with their indices.
+ */
+template<typename T, size_t K, typename I = int>
+struct top_k_result {
+    vector<T, extent<K>> values;
+    vector<I, extent<K>> indices;
+};
+
+namespace detail {
+template<typename T, typename I>
+struct top_k_order {
+    static constexpr I invalid_index = I(-1);
+
+    // Returns `true` if the entry `(a, i)` should be ordered before entry `(b, j)`. Entries having an invalid
+    // index are empty slots and are always ordered last.
+    KERNEL_FLOAT_INLINE
+    static bool call(T a, I i, T b, I j) {
+        return i != invalid_index && (j == invalid_index || ops::greater<T> {}(a, b));
+    }
+
+    KERNEL_FLOAT_INLINE
+    static void compare_exchange(T* values, I* indices, size_t x, size_t y) {
+        T a = values[x];
+        T b = values[y];
+        I i = indices[x];
+        I j = indices[y];
+        bool swap = call(b, j, a, i);
+
+        values[x] = swap ? b : a;
+        values[y] = swap ? a : b;
+        indices[x] = swap ? j : i;
+        indices[y] = swap ? i : j;
+    }
+};
+
+template<typename T, typename I, size_t N>
+struct top_k_sort_impl {
+    KERNEL_FLOAT_INLINE
+    static void call(T* values, I* indices) {
+        sort_network<N>::call([&](size_t x, size_t y) {
+            top_k_order<T, I>::compare_exchange(values, indices, x, y);
+        });
+    }
+};
+}  // namespace detail
+
+/**
+ * Returns the `K` largest elements of the vector `input` in descending order together with their indices. The
+ * selection is performed using a compile-time sorting network (see `sort`).
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 5> x = {5.0f, 0.0f, 2.0f, 1.0f, 7.0f};
+ * top_k_result<float, 2> y = top_k<2>(x);  // values=[7.0f, 5.0f], indices=[4, 0]
+ * ```
+ */
+template<size_t K, typename I = int, typename V, typename T = vector_value_type<V>>
+KERNEL_FLOAT_INLINE top_k_result<T, K, I> top_k(const V& input) {
+    static constexpr size_t N = vector_extent<V>;
+    static_assert(K <= N, "K cannot exceed the size of the vector");
+
+    vector_storage<T, N> values = into_vector_storage(input);
+    vector_storage<I, N> indices = range<I, N>();
+    detail::top_k_sort_impl<T, I, N>::call(values.data(), indices.data());
+
+    top_k_result<T, K, I> result;
+
+#pragma unroll
+    for (size_t i = 0; i < K; i++) {
+        result.values[i] = values.data()[i];
+        result.indices[i] = indices.data()[i];
+    }
+
+    return result;
+}
+
+/**
+ * Merges two results of `top_k` into the `K` largest elements of both. Since both inputs are sorted, the `K`
+ * largest elements are obtained by comparing `a[i]` against `b[K - 1 - i]`, which results in a bitonic sequence
+ * that is then sorted using a sorting network. This can be used to combine the partial results of multiple threads.
+ */
+template<typename T, size_t K, typename I>
+KERNEL_FLOAT_INLINE top_k_result<T, K, I>
+merge_top_k(const top_k_result<T, K, I>& a, const top_k_result<T, K, I>& b) {
+    using order = detail::top_k_order<T, I>;
+    top_k_result<T, K, I> result;
+
+#pragma unroll
+    for (size_t i = 0; i < K; i++) {
+        T x = a.values[i];
+        T y = b.values[K - 1 - i];
+        I xi = a.indices[i];
+        I yi = b.indices[K - 1 - i];
+        bool take_b = order::call(y, yi, x, xi);
+
+        result.values[i] = take_b ? y : x;
+        result.indices[i] = take_b ? yi : xi;
+    }
+
+    detail::top_k_sort_impl<T, I, K>::call(result.values.data(), result.indices.data());
+    return result;
+}
+
+/**
+ * Returns the `K` largest elements of the elements ``ptr[begin]``, ``ptr[begin + stride]``, ... up to ``ptr[n]``
+ * (exclusive), together with their indices. The indices are relative to ``ptr`` (not to ``begin``), so only results
+ * for the same ``ptr`` should be merged. The elements are kept in a sorted buffer in registers and each new element
+ * is inserted using a single pass of compare-exchange operations.
+ *
+ * Each thread can process a different range of the data and the partial results of multiple threads can be
+ * combined using ``merge_top_k``. If fewer than `K` elements are processed, the remaining slots have the index
+ * `I(-1)`.
+ *
+ * ```
+ * // Grid-stride loop where each thread processes a subset of the `n` elements
+ * size_t index = blockIdx.x * blockDim.x + threadIdx.x;
+ * size_t stride = gridDim.x * blockDim.x;
+ * top_k_result<float, 8> partial = top_k<8>(scores, n, index, stride);
+ * ```
+ */
+template<size_t K, typename I = int, typename T>
+KERNEL_FLOAT_INLINE top_k_result<T, K, I>
+top_k(const T* ptr, size_t n, size_t begin = 0, size_t stride = 1) {
+    using order = detail::top_k_order<T, I>;
+    static_assert(K > 0, "K must be at least one");
+
+    top_k_result<T, K, I> result;
+    result.indices = fill<K>(order::invalid_index);
+
+    for (size_t i = begin; i < n; i += stride) {
+        T value = ptr[i];
+
+        if (order::call(value, I(i), result.values[K - 1], result.indices[K - 1])) {
+            result.values[K - 1] = value;
+            result.indices[K - 1] = I(i);
+
+#pragma unroll
+            for (size_t j = K - 1; j > 0; j--) {
+                order::compare_exchange(result.values.data(), result.indices.data(), j - 1, j);
+            }
+        }
+    }
+
+    return result;
+}
+
 }  // namespace kernel_float
 
 #endif
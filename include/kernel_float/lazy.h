@@ -0,0 +1,271 @@
+#ifndef KERNEL_FLOAT_LAZY_H
+#define KERNEL_FLOAT_LAZY_H
+
+#include "base.h"
+#include "binops.h"
+#include "triops.h"
+
+namespace kernel_float {
+namespace detail {
+
+/**
+ * Leaf of a lazy expression: a vector of extent `E` that is broadcast to the extent of the whole expression when
+ * its elements are requested. Scalars are stored as a single element and are never copied `N` times.
+ */
+template<typename T, typename E>
+struct lazy_leaf {
+    using value_type = T;
+    using compute_value_type = T;
+    using extent_type = E;
+
+    template<typename To>
+    KERNEL_FLOAT_INLINE T eval(size_t i) const {
+        return storage.data()[broadcast_index(i, E {}, To {})];
+    }
+
+    vector_storage<T, E::value> storage;
+};
+
+/**
+ * Returns element `i` of the expression `X` evaluated over extent `To`, converted to type `T`. Since every node
+ * already computes in its own compute type, only the leaves of an expression perform an actual conversion.
+ */
+template<typename T, typename To, typename X>
+KERNEL_FLOAT_INLINE T lazy_value(const X& expr, size_t i) {
+    return ops::cast<typename X::compute_value_type, T> {}(expr.template eval<To>(i));
+}
+
+template<typename V>
+using lazy_leaf_type = lazy_leaf<vector_value_type<V>, vector_extent_type<V>>;
+
+template<typename L, typename R>
+using lazy_promoted_type = promote_t<typename L::value_type, typename R::value_type>;
+
+// The type in which a binary node computes its result, which can be wider than its `value_type`.
+template<typename L, typename R>
+using lazy_compute_type = kernel_float::compute_type<lazy_promoted_type<L, R>>;
+
+template<typename F, typename L, typename R>
+struct lazy_binary_eval {
+    using T = lazy_compute_type<L, R>;
+
+    template<typename To>
+    KERNEL_FLOAT_INLINE static result_t<F, T, T> call(const L& left, const R& right, size_t i) {
+        return F {}(lazy_value<T, To>(left, i), lazy_value<T, To>(right, i));
+    }
+};
+
+template<typename F, typename L, typename R>
+struct lazy_binary {
+    using value_type = lazy_promoted_type<L, R>;
+    using compute_value_type = result_t<F, lazy_compute_type<L, R>, lazy_compute_type<L, R>>;
+    using extent_type = broadcast_extent<typename L::extent_type, typename R::extent_type>;
+
+    template<typename To>
+    KERNEL_FLOAT_INLINE compute_value_type eval(size_t i) const {
+        return lazy_binary_eval<F, L, R>::template call<To>(left, right, i);
+    }
+
+    L left;
+    R right;
+};
+
+// `a * b + c` is contracted into `fma(a, b, c)`
+template<typename T, typename A, typename B, typename C>
+struct lazy_binary_eval<ops::add<T>, lazy_binary<ops::multiply<T>, A, B>, C> {
+    template<typename To>
+    KERNEL_FLOAT_INLINE static T
+    call(const lazy_binary<ops::multiply<T>, A, B>& left, const C& right, size_t i) {
+        return ops::fma<T> {}(
+            lazy_value<T, To>(left.left, i),
+            lazy_value<T, To>(left.right, i),
+            lazy_value<T, To>(right, i));
+    }
+};
+
+// `c + a * b` is contracted into `fma(a, b, c)`
+template<typename T, typename C, typename A, typename B>
+struct lazy_binary_eval<ops::add<T>, C, lazy_binary<ops::multiply<T>, A, B>> {
+    template<typename To>
+    KERNEL_FLOAT_INLINE static T
+    call(const C& left, const lazy_binary<ops::multiply<T>, A, B>& right, size_t i) {
+        return ops::fma<T> {}(
+            lazy_value<T, To>(right.left, i),
+            lazy_value<T, To>(right.right, i),
+            lazy_value<T, To>(left, i));
+    }
+};
+
+// `a * b + c * d` is contracted into `fma(a, b, c * d)`
+template<typename T, typename A, typename B, typename C, typename D>
+struct lazy_binary_eval<
+    ops::add<T>,
+    lazy_binary<ops::multiply<T>, A, B>,
+    lazy_binary<ops::multiply<T>, C, D>> {
+    template<typename To>
+    KERNEL_FLOAT_INLINE static T call(
+        const lazy_binary<ops::multiply<T>, A, B>& left,
+        const lazy_binary<ops::multiply<T>, C, D>& right,
+        size_t i) {
+        return ops::fma<T> {}(
+            lazy_value<T, To>(left.left, i),
+            lazy_value<T, To>(left.right, i),
+            lazy_value<T, To>(right, i));
+    }
+};
+
+// `a * b - c` is contracted into `fma(a, b, -c)`
+template<typename T, typename A, typename B, typename C>
+struct lazy_binary_eval<ops::subtract<T>, lazy_binary<ops::multiply<T>, A, B>, C> {
+    template<typename To>
+    KERNEL_FLOAT_INLINE static T
+    call(const lazy_binary<ops::multiply<T>, A, B>& left, const C& right, size_t i) {
+        return ops::fma<T> {}(
+            lazy_value<T, To>(left.left, i),
+            lazy_value<T, To>(left.right, i),
+            ops::negate<T> {}(lazy_value<T, To>(right, i)));
+    }
+};
+
+/**
+ * Evaluates all elements of the expression `X`. Each element is computed in the compute type of the expression and
+ * only rounded to its value type once at the very end.
+ */
+template<typename X>
+KERNEL_FLOAT_INLINE vector_storage<typename X::value_type, X::extent_type::value>
+lazy_eval(const X& expr) {
+    using E = typename X::extent_type;
+    using T = typename X::value_type;
+    vector_storage<T, E::value> result;
+
+#pragma unroll
+    for (size_t i = 0; i < E::value; i++) {
+        result.data()[i] = lazy_value<T, E>(expr, i);
+    }
+
+    return result;
+}
+
+}  // namespace detail
+
+/**
+ * A vector expression that has not been evaluated yet. See `lazy` on how to construct these expressions.
+ */
+template<typename X>
+struct lazy_expr {
+    using value_type = typename X::value_type;
+    using extent_type = typename X::extent_type;
+
+    /**
+     * Evaluates this expression and returns the result as a vector.
+     */
+    KERNEL_FLOAT_INLINE
+    vector<value_type, extent_type> eval() const {
+        return detail::lazy_eval(expr);
+    }
+
+    X expr;
+};
+
+template<typename X>
+struct into_vector_impl<lazy_expr<X>> {
+    using value_type = typename X::value_type;
+    using extent_type = typename X::extent_type;
+
+    KERNEL_FLOAT_INLINE
+    static vector_storage<value_type, extent_type::value> call(const lazy_expr<X>& input) {
+        return detail::lazy_eval(input.expr);
+    }
+};
+
+/**
+ * Wraps the given vector (or scalar) into a lazy expression. Arithmetic operators (`+`, `-`, `*`, `/`) on lazy
+ * expressions do not compute anything, they build an expression tree instead. The expression is evaluated in a
+ * single loop over the elements when it is converted to a vector (or by calling `eval()`).
+ *
+ * Compared to regular vector operators, this avoids materializing intermediate vectors and broadcast copies of
+ * scalars. Elements are only converted at the leaves of the expression, and the whole expression is computed in
+ * the compute type of its element type (see `compute_type_policy`) and rounded once at the end. Additionally, the
+ * patterns `a * b + c`, `c + a * b`, and `a * b - c` are contracted into a single `fma`, which means that the
+ * result can differ in the last bit from the non-lazy version. This is why lazy evaluation is opt-in.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 8> a, b, c;
+ * vec<float, 8> x = lazy(a) * b + c;  // Evaluates `fma(a[i], b[i], c[i])` for each element
+ * vec<float, 8> y = (lazy(a) * 2.0f - 1.0f) * c;  // No temporary vectors
+ * ```
+ */
+template<typename V>
+KERNEL_FLOAT_INLINE lazy_expr<detail::lazy_leaf_type<V>> lazy(const V& input) {
+    return {{into_vector_storage(input)}};
+}
+
+/**
+ * Evaluates the given lazy expression and returns the result as a vector.
+ */
+template<typename X>
+KERNEL_FLOAT_INLINE vector<typename X::value_type, typename X::extent_type>
+eval(const lazy_expr<X>& input) {
+    return input.eval();
+}
+
+#define KERNEL_FLOAT_DEFINE_LAZY_OP(NAME, OP)                                                   \
+    template<typename L, typename R, typename C = detail::lazy_compute_type<L, R>>          \
+    KERNEL_FLOAT_INLINE lazy_expr<detail::lazy_binary<ops::NAME<C>, L, R>> operator OP(         \
+        const lazy_expr<L>& left,                                                               \
+        const lazy_expr<R>& right) {                                                            \
+        return {{left.expr, right.expr}};                                                       \
+    }                                                                                           \
+    template<                                                                                   \
+        typename L,                                                                             \
+        typename R,                                                                             \
+        typename E,                                                                             \
+        typename Leaf = detail::lazy_leaf<R, E>,                                                \
+        typename C = detail::lazy_compute_type<L, Leaf>>                                    \
+    KERNEL_FLOAT_INLINE lazy_expr<detail::lazy_binary<ops::NAME<C>, L, Leaf>> operator OP(      \
+        const lazy_expr<L>& left,                                                               \
+        const vector<R, E>& right) {                                                            \
+        return {{left.expr, lazy(right).expr}};                                                 \
+    }                                                                                           \
+    template<                                                                                   \
+        typename L,                                                                             \
+        typename E,                                                                             \
+        typename R,                                                                             \
+        typename Leaf = detail::lazy_leaf<L, E>,                                                \
+        typename C = detail::lazy_compute_type<Leaf, R>>                                    \
+    KERNEL_FLOAT_INLINE lazy_expr<detail::lazy_binary<ops::NAME<C>, Leaf, R>> operator OP(      \
+        const vector<L, E>& left,                                                               \
+        const lazy_expr<R>& right) {                                                            \
+        return {{lazy(left).expr, right.expr}};                                                 \
+    }                                                                                           \
+    template<                                                                                   \
+        typename L,                                                                             \
+        typename R,                                                                             \
+        typename Leaf = detail::lazy_leaf_type<R>,                                              \
+        typename C = detail::lazy_compute_type<L, Leaf>>                                    \
+    KERNEL_FLOAT_INLINE lazy_expr<detail::lazy_binary<ops::NAME<C>, L, Leaf>> operator OP(      \
+        const lazy_expr<L>& left,                                                               \
+        const R& right) {                                                                       \
+        return {{left.expr, lazy(right).expr}};                                                 \
+    }                                                                                           \
+    template<                                                                                   \
+        typename L,                                                                             \
+        typename R,                                                                             \
+        typename Leaf = detail::lazy_leaf_type<L>,                                              \
+        typename C = detail::lazy_compute_type<Leaf, R>>                                    \
+    KERNEL_FLOAT_INLINE lazy_expr<detail::lazy_binary<ops::NAME<C>, Leaf, R>> operator OP(      \
+        const L& left,                                                                          \
+        const lazy_expr<R>& right) {                                                            \
+        return {{lazy(left).expr, right.expr}};                                                 \
+    }
+
+KERNEL_FLOAT_DEFINE_LAZY_OP(add, +)
+KERNEL_FLOAT_DEFINE_LAZY_OP(subtract, -)
+KERNEL_FLOAT_DEFINE_LAZY_OP(multiply, *)
+KERNEL_FLOAT_DEFINE_LAZY_OP(divide, /)
+
+}  // namespace kernel_float
+
+#endif  // KERNEL_FLOAT_LAZY_H
@@ -67,4 +67,20 @@
 #define KERNEL_FLOAT_FAST_MATH (0)
 #endif
 
+// Promotion policies, see `promote_t`. By default, combining two floating-point types results in the widest of the
+// two (for example, `half + float` gives `float`). With `KERNEL_FLOAT_PROMOTE_NARROWEST`, the narrowest of the two
+// is used instead (`half + float` gives `half`), which reduces register usage and memory traffic.
+#define KERNEL_FLOAT_PROMOTE_WIDEST (0)
+#define KERNEL_FLOAT_PROMOTE_NARROWEST (1)
+
+#ifndef KERNEL_FLOAT_PROMOTION_POLICY
+#define KERNEL_FLOAT_PROMOTION_POLICY KERNEL_FLOAT_PROMOTE_WIDEST
+#endif
+
+// Vectors with more elements than this limit are processed using loops over small chunks, instead of fully
+// unrolling the operation. This limits compile time and code size for very large vectors.
+#ifndef KERNEL_FLOAT_UNROLL_LIMIT
+#define KERNEL_FLOAT_UNROLL_LIMIT (64)
+#endif
+
 #endif  //KERNEL_FLOAT_MACROS_H
@@ -0,0 +1,148 @@
+#ifndef KERNEL_FLOAT_MATMUL_H
+#define KERNEL_FLOAT_MATMUL_H
+
+#include "base.h"
+#include "binops.h"
+#include "conversion.h"
+#include "triops.h"
+
+namespace kernel_float {
+namespace detail {
+
+/**
+ * The dimensions of the product of a matrix (or vector) of extent `A` with a matrix (or vector) of extent `B`.
+ */
+template<typename A, typename B>
+struct matmul_extent_helper {};
+
+// matrix-matrix
+template<size_t M, size_t K, size_t N>
+struct matmul_extent_helper<extent<M, K>, extent<K, N>> {
+    static constexpr size_t rows = M;
+    static constexpr size_t inner = K;
+    static constexpr size_t cols = N;
+    using type = extent<M, N>;
+};
+
+// matrix-vector
+template<size_t M, size_t K>
+struct matmul_extent_helper<extent<M, K>, extent<K>> {
+    static constexpr size_t rows = M;
+    static constexpr size_t inner = K;
+    static constexpr size_t cols = 1;
+    using type = extent<M>;
+};
+
+// vector-matrix
+template<size_t K, size_t N>
+struct matmul_extent_helper<extent<K>, extent<K, N>> {
+    static constexpr size_t rows = 1;
+    static constexpr size_t inner = K;
+    static constexpr size_t cols = N;
+    using type = extent<N>;
+};
+
+template<typename T, size_t M, size_t K, size_t N>
+struct matmul_impl {
+    KERNEL_FLOAT_INLINE static void call(T* result, const T* a, const T* b) {
+        // Outer product formulation: every step broadcasts a column of `a` and a row of `b` and accumulates
+        // them into `result` using FMAs. This keeps all `M * N` accumulators independent.
+#pragma unroll
+        for (size_t i = 0; i < M; i++) {
+#pragma unroll
+            for (size_t j = 0; j < N; j++) {
+                result[i * N + j] = ops::multiply<T> {}(a[i * K], b[j]);
+            }
+        }
+
+#pragma unroll
+        for (size_t k = 1; k < K; k++) {
+#pragma unroll
+            for (size_t i = 0; i < M; i++) {
+#pragma unroll
+                for (size_t j = 0; j < N; j++) {
+                    result[i * N + j] =
+                        ops::fma<T> {}(a[i * K + k], b[k * N + j], result[i * N + j]);
+                }
+            }
+        }
+    }
+};
+
+template<typename T, size_t M, size_t N>
+struct matmul_impl<T, M, 0, N> {
+    KERNEL_FLOAT_INLINE static void call(T* result, const T* a, const T* b) {
+#pragma unroll
+        for (size_t i = 0; i < M * N; i++) {
+            result[i] = T {};
+        }
+    }
+};
+}  // namespace detail
+
+template<typename A, typename B>
+using matmul_extent =
+    typename detail::matmul_extent_helper<vector_extent_type<A>, vector_extent_type<B>>::type;
+
+/**
+ * Computes the matrix product of ``a`` and ``b``. The arguments must be matrices of extent `extent<M, K>` and
+ * `extent<K, N>`, in which case the result has extent `extent<M, N>`. Either argument can also be a vector
+ * of `K` elements for a matrix-vector or vector-matrix product.
+ *
+ * The product is fully unrolled and computed using `M * N` independent FMAs per step, which makes this function
+ * suitable for small tiles held in registers (for example, 4x8 by 8x4).
+ *
+ * Example
+ * =======
+ * ```
+ * vector<float, extent<2, 3>> a = {1, 2, 3, 4, 5, 6};
+ * vector<float, extent<3, 2>> b = {1, 0, 0, 1, 1, 1};
+ * vector<float, extent<2, 2>> c = matmul(a, b);  // Returns [[4, 5], [10, 11]]
+ *
+ * vec<float, 3> x = {1, 1, 1};
+ * vec<float, 2> y = matmul(a, x);  // Returns [6, 15]
+ * ```
+ */
+template<typename A, typename B, typename T = promoted_vector_value_type<A, B>>
+KERNEL_FLOAT_INLINE vector<T, matmul_extent<A, B>> matmul(const A& a, const B& b) {
+    using helper = detail::matmul_extent_helper<vector_extent_type<A>, vector_extent_type<B>>;
+    static constexpr size_t M = helper::rows;
+    static constexpr size_t K = helper::inner;
+    static constexpr size_t N = helper::cols;
+
+    vector_storage<T, M * N> result;
+    detail::matmul_impl<T, M, K, N>::call(
+        result.data(),
+        convert_storage<T, M * K>(reshape<M * K>(a)).data(),
+        convert_storage<T, K * N>(reshape<K * N>(b)).data());
+
+    return result;
+}
+
+/**
+ * Computes the outer product of the vectors ``a`` and ``b``. If ``a`` has `M` elements and ``b`` has `N`
+ * elements, the result is a matrix of extent `extent<M, N>` where element `(i, j)` equals `a[i] * b[j]`.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 2> a = {1, 2};
+ * vec<int, 3> b = {3, 4, 5};
+ * vector<int, extent<2, 3>> c = outer(a, b);  // Returns [[3, 4, 5], [6, 8, 10]]
+ * ```
+ */
+template<typename A, typename B, typename T = promoted_vector_value_type<A, B>>
+KERNEL_FLOAT_INLINE vector<T, extent<vector_extent<A>, vector_extent<B>>>
+outer(const A& a, const B& b) {
+    static constexpr size_t M = vector_extent<A>;
+    static constexpr size_t N = vector_extent<B>;
+
+    return zip_common(
+        ops::multiply<T> {},
+        reshape<M, 1>(convert_storage<T, M>(a)),
+        reshape<1, N>(convert_storage<T, N>(b)));
+}
+
+}  // namespace kernel_float
+
+#endif  // KERNEL_FLOAT_MATMUL_H
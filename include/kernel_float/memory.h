@@ -4,6 +4,7 @@
 #include "binops.h"
 #include "conversion.h"
 #include "iterate.h"
+#include "reduce.h"
 
 namespace kernel_float {
 namespace detail {
@@ -113,7 +114,10 @@ constexpr size_t gcd(size_t a, size_t b) {
 }
 
 template<typename T, size_t N, size_t alignment, typename = void>
-struct copy_aligned_impl {
+struct copy_aligned_impl;
+
+template<typename T, size_t N, size_t alignment, bool = is_unrolled(N)>
+struct copy_aligned_recur_impl {
     static constexpr size_t K = N > 8 ? 8 : (N > 4 ? 4 : (N > 2 ? 2 : 1));
     static constexpr size_t alignment_K = gcd(alignment, sizeof(T) * K);
 
@@ -130,6 +134,37 @@ struct copy_aligned_impl {
     }
 };
 
+// Large vectors are copied in chunks by a loop that is not unrolled
+template<typename T, size_t N, size_t alignment>
+struct copy_aligned_recur_impl<T, N, alignment, false> {
+    static constexpr size_t K = unroll_chunk_size;
+    static constexpr size_t M = N - N % K;
+    static constexpr size_t alignment_K = gcd(alignment, sizeof(T) * K);
+
+    KERNEL_FLOAT_INLINE
+    static void load(T* output, const T* input) {
+#pragma unroll 1
+        for (size_t i = 0; i < M; i += K) {
+            copy_aligned_impl<T, K, alignment_K>::load(output + i, input + i);
+        }
+
+        copy_aligned_impl<T, N - M, alignment_K>::load(output + M, input + M);
+    }
+
+    KERNEL_FLOAT_INLINE
+    static void store(T* output, const T* input) {
+#pragma unroll 1
+        for (size_t i = 0; i < M; i += K) {
+            copy_aligned_impl<T, K, alignment_K>::store(output + i, input + i);
+        }
+
+        copy_aligned_impl<T, N - M, alignment_K>::store(output + M, input + M);
+    }
+};
+
+template<typename T, size_t N, size_t alignment, typename>
+struct copy_aligned_impl: copy_aligned_recur_impl<T, N, alignment> {};
+
 template<typename T, size_t alignment>
 struct copy_aligned_impl<T, 0, alignment> {
     KERNEL_FLOAT_INLINE
@@ -285,6 +320,75 @@ KERNEL_FLOAT_INLINE void write_aligned(T* ptr, const V& values) {
         convert_storage<T, N>(values).data());
 }
 
+namespace detail {
+template<typename T, typename R>
+static constexpr size_t convert_buffer_width =
+    KERNEL_FLOAT_MAX_ALIGNMENT / (sizeof(T) > sizeof(R) ? sizeof(T) : sizeof(R)) > 0
+    ? KERNEL_FLOAT_MAX_ALIGNMENT / (sizeof(T) > sizeof(R) ? sizeof(T) : sizeof(R))
+    : 1;
+
+template<size_t N, typename T>
+KERNEL_FLOAT_INLINE size_t elements_until_aligned(const T* ptr) {
+    size_t offset = (reinterpret_cast<size_t>(ptr) / sizeof(T)) % N;
+    return offset == 0 ? 0 : N - offset;
+}
+}  // namespace detail
+
+/**
+ * Converts the ``n`` elements of the buffer ``src`` to type ``R`` and stores them in the buffer ``dst``.
+ *
+ * The buffers are processed in chunks of ``N`` elements, which by default is the number of elements that fit
+ * into ``KERNEL_FLOAT_MAX_ALIGNMENT`` bytes. This means the conversion can use the specialized implementations
+ * for multiple elements at once (for example, the packed conversions of ``__half2`` or fp8x2) and that ``dst`` is
+ * written using aligned vector stores. The unaligned head and the tail of the buffers are converted one element
+ * at a time. The buffers should not overlap.
+ *
+ * The work can be split over multiple threads using ``thread_index`` and ``thread_count``, where each thread
+ * processes every ``thread_count``-th chunk.
+ *
+ * ```
+ * // Convert on the host
+ * convert_buffer(output, input, n);
+ *
+ * // Convert on the GPU where every thread processes a subset of the buffer
+ * size_t index = blockIdx.x * blockDim.x + threadIdx.x;
+ * size_t count = gridDim.x * blockDim.x;
+ * convert_buffer(output, input, n, index, count);
+ * ```
+ */
+template<typename R, typename T, size_t N = detail::convert_buffer_width<T, R>>
+KERNEL_FLOAT_INLINE void convert_buffer(
+    R* dst,
+    const T* src,
+    size_t n,
+    size_t thread_index = 0,
+    size_t thread_count = 1) {
+    size_t head = detail::elements_until_aligned<N>(dst);
+    head = head < n ? head : n;
+
+    for (size_t i = thread_index; i < head; i += thread_count) {
+        dst[i] = ops::cast<T, R> {}(src[i]);
+    }
+
+    size_t num_chunks = (n - head) / N;
+    R* dst_body = dst + head;
+    const T* src_body = src + head;
+
+    if (detail::elements_until_aligned<N>(src_body) == 0) {
+        for (size_t i = thread_index; i < num_chunks; i += thread_count) {
+            write_aligned<N>(dst_body + i * N, convert<R, N>(read_aligned<N>(src_body + i * N)));
+        }
+    } else {
+        for (size_t i = thread_index; i < num_chunks; i += thread_count) {
+            write_aligned<N>(dst_body + i * N, convert<R, N>(read<N>(src_body + i * N)));
+        }
+    }
+
+    for (size_t i = head + num_chunks * N + thread_index; i < n; i += thread_count) {
+        dst[i] = ops::cast<T, R> {}(src[i]);
+    }
+}
+
 /**
  * @brief A reference wrapper that allows reading/writing a vector of type `T`and length `N` with optional data
  * conversion.
@@ -343,6 +447,21 @@ struct vector_ref {
         return *this;
     }
 
+    /**
+     * Applies the function `fun` to each element and writes the results back to the underlying raw pointer. The
+     * elements are updated in place using `map_inplace`, so no second vector is created.
+     *
+     * @param fun The function to apply to each element.
+     * @param args Optional additional arguments passed to `fun`, which are broadcast to `N` elements.
+     */
+    template<typename F, typename... Args>
+    KERNEL_FLOAT_INLINE vector_ref apply(F fun, const Args&... args) const {
+        vector_type values = read();
+        map_inplace(fun, values, args...);
+        write(values);
+        return *this;
+    }
+
     /**
      * Gets the raw data pointer managed by this vector_ref
      */
@@ -381,19 +500,42 @@ struct vector_ref<T, N, const U, Align> {
     pointer_type data_ = nullptr;
 };
 
-#define KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(OP, OP_ASSIGN)                 \
-    template<typename T, size_t N, typename U, size_t Align, typename V> \
-    KERNEL_FLOAT_INLINE vector_ref<T, N, U, Align> operator OP_ASSIGN(   \
-        vector_ref<T, N, U, Align> ptr,                                  \
-        const V& value) {                                                \
-        ptr.write(ptr.read() OP value);                                  \
-        return ptr;                                                      \
-    }
-
-KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(+, +=)
-KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(-, -=)
-KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(*, *=)
-KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(/, /=)
+// The elements are updated in place if `vector OP_ASSIGN value` is allowed. Otherwise, for example if `value` has
+// a wider type, the result of `vector OP value` is converted back when it is written.
+#define KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(NAME, OP, OP_ASSIGN)                                \
+    template<                                                                                 \
+        typename T,                                                                           \
+        size_t N,                                                                             \
+        typename U,                                                                           \
+        size_t Align,                                                                         \
+        typename V,                                                                           \
+        enable_if_t<is_vector_assign_allowed<ops::NAME, decay_t<T>, extent<N>, V>, int> = 0>  \
+    KERNEL_FLOAT_INLINE vector_ref<T, N, U, Align> operator OP_ASSIGN(                        \
+        vector_ref<T, N, U, Align> ptr,                                                       \
+        const V& value) {                                                                     \
+        auto values = ptr.read();                                                             \
+        values OP_ASSIGN value;                                                               \
+        ptr.write(values);                                                                    \
+        return ptr;                                                                           \
+    }                                                                                         \
+    template<                                                                                 \
+        typename T,                                                                           \
+        size_t N,                                                                             \
+        typename U,                                                                           \
+        size_t Align,                                                                         \
+        typename V,                                                                           \
+        enable_if_t<!is_vector_assign_allowed<ops::NAME, decay_t<T>, extent<N>, V>, int> = 0> \
+    KERNEL_FLOAT_INLINE vector_ref<T, N, U, Align> operator OP_ASSIGN(                        \
+        vector_ref<T, N, U, Align> ptr,                                                       \
+        const V& value) {                                                                     \
+        ptr.write(ptr.read() OP value);                                                       \
+        return ptr;                                                                           \
+    }
+
+KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(add, +, +=)
+KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(subtract, -, -=)
+KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(multiply, *, *=)
+KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(divide, /, /=)
 
 /**
  * A wrapper for a pointer that enables vectorized access and supports type conversions..
@@ -583,6 +725,52 @@ KERNEL_FLOAT_INLINE vector_ptr<T, N> assert_aligned(T* ptr) {
 }
 /// @endcond
 
+/**
+ * Compute the count, mean, and sum of squared deviations (``m2``) of the elements of the vectors ``ptr[begin]``,
+ * ``ptr[begin + stride]``, ``ptr[begin + 2 * stride]``, ... up to ``ptr[end]`` (exclusive). The data is read only
+ * once, which makes this function suitable for normalizing data in a single pass over memory.
+ *
+ * Each thread can process a different range of the data and the partial results of multiple threads can be
+ * combined using ``merge_moments``.
+ *
+ * ```
+ * // Grid-stride loop where each thread processes a subset of the `n` vectors
+ * size_t index = blockIdx.x * blockDim.x + threadIdx.x;
+ * size_t stride = gridDim.x * blockDim.x;
+ * running_moments<float> partial = moments(ptr, index, n, stride);
+ * ```
+ */
+template<typename T, size_t N, typename U, typename A = widest_promote_t<float, T>>
+KERNEL_FLOAT_INLINE running_moments<A>
+moments(vector_ptr<T, N, U> ptr, size_t begin, size_t end, size_t stride = 1) {
+    A count = A(0);
+    vector_storage<A, N> mean;
+    vector_storage<A, N> m2;
+
+    // All lanes have seen the same number of elements, so the division only needs to be performed once per vector
+    for (size_t i = begin; i < end; i += stride) {
+        vector_storage<A, N> values = convert_storage<A, N>(ptr.read(i));
+        count = count + A(1);
+        A inv_count = A(1) / count;
+
+#pragma unroll
+        for (size_t j = 0; j < N; j++) {
+            A delta = values.data()[j] - mean.data()[j];
+            mean.data()[j] = mean.data()[j] + delta * inv_count;
+            m2.data()[j] = m2.data()[j] + delta * (values.data()[j] - mean.data()[j]);
+        }
+    }
+
+    vector_storage<running_moments<A>, N> lanes;
+
+#pragma unroll
+    for (size_t j = 0; j < N; j++) {
+        lanes.data()[j] = {count, mean.data()[j], m2.data()[j]};
+    }
+
+    return reduce(ops::merge_moments<A> {}, lanes);
+}
+
 template<typename T, size_t N = 1, typename U = T>
 using vec_ptr = vector_ptr<T, N, U>;
 
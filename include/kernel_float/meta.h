@@ -11,8 +11,22 @@ struct index_sequence {
 };
 
 namespace detail {
+template<typename L, size_t Offset, typename R>
+struct concat_index_sequence;
+
+template<size_t... Ls, size_t Offset, size_t... Rs>
+struct concat_index_sequence<index_sequence<Ls...>, Offset, index_sequence<Rs...>> {
+    using type = index_sequence<Ls..., (Offset + Rs)...>;
+};
+
+// Sequences longer than the predefined ones below are built by concatenating two halves.
 template<size_t N>
-struct make_index_sequence_impl {};
+struct make_index_sequence_impl {
+    using type = typename concat_index_sequence<
+        typename make_index_sequence_impl<N / 2>::type,
+        N / 2,
+        typename make_index_sequence_impl<N - N / 2>::type>::type;
+};
 
 // Benchmarks show that it is much faster to predefine all possible index sequences instead of doing something
 // recursive with variadic templates.
@@ -79,6 +93,14 @@ using decay_t = typename detail::decay_impl<T>::type;
 template<typename A, typename B>
 struct promote_type {};
 
+namespace detail {
+// Set to true for all floating-point types by `KERNEL_FLOAT_DEFINE_PROMOTED_FLOAT`
+template<typename T>
+struct is_promoted_float {
+    static constexpr bool value = false;
+};
+}  // namespace detail
+
 template<typename T>
 struct promote_type<T, T> {
     using type = T;
@@ -127,6 +149,12 @@ KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(long double, float)
 KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(long double, double)
 
 #define KERNEL_FLOAT_DEFINE_PROMOTED_FLOAT(T)                \
+    namespace detail {                                       \
+    template<>                                               \
+    struct is_promoted_float<T> {                            \
+        static constexpr bool value = true;                  \
+    };                                                       \
+    }                                                        \
     KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(T, char)               \
     KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(T, signed char)        \
     KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(T, signed short)       \
@@ -211,9 +239,6 @@ struct multi_promote_type<A, B, C, Rest...>:
 
 }  // namespace detail
 
-template<typename... Ts>
-using promote_t = typename detail::multi_promote_type<decay_t<Ts>...>::type;
-
 namespace detail {
 
 template<typename A, typename B>
@@ -270,6 +295,73 @@ struct enable_if_impl<true, T> {
 template<bool C, typename T = void>
 using enable_if_t = typename detail::enable_if_impl<C, T>::type;
 
+namespace detail {
+/**
+ * Promotes `A` and `B` like `promote_type`, except that combining two different floating-point types results in
+ * the narrowest of the two instead of the widest. Used if `KERNEL_FLOAT_PROMOTION_POLICY` is set to
+ * `KERNEL_FLOAT_PROMOTE_NARROWEST`.
+ */
+template<typename A, typename B, typename = void>
+struct narrow_promote_type: promote_type<A, B> {};
+
+template<typename A, typename B>
+struct narrow_promote_type<
+    A,
+    B,
+    enable_if_t<
+        is_promoted_float<A>::value && is_promoted_float<B>::value && !is_same_type<A, B>
+        && is_same_type<typename promote_type<A, B>::type, A>>> {
+    using type = B;
+};
+
+template<typename A, typename B>
+struct narrow_promote_type<
+    A,
+    B,
+    enable_if_t<
+        is_promoted_float<A>::value && is_promoted_float<B>::value && !is_same_type<A, B>
+        && is_same_type<typename promote_type<A, B>::type, B>>> {
+    using type = A;
+};
+
+#if KERNEL_FLOAT_PROMOTION_POLICY == KERNEL_FLOAT_PROMOTE_NARROWEST
+template<typename A, typename B>
+struct policy_promote_type: narrow_promote_type<A, B> {};
+#else
+template<typename A, typename B>
+struct policy_promote_type: promote_type<A, B> {};
+#endif
+
+template<typename... Ts>
+struct multi_policy_promote_type;
+
+template<typename T>
+struct multi_policy_promote_type<T> {
+    using type = T;
+};
+
+template<typename A, typename B>
+struct multi_policy_promote_type<A, B>: policy_promote_type<A, B> {};
+
+template<typename A, typename B, typename C, typename... Rest>
+struct multi_policy_promote_type<A, B, C, Rest...>:
+    multi_policy_promote_type<typename policy_promote_type<A, B>::type, C, Rest...> {};
+}  // namespace detail
+
+/**
+ * The type to which the types `Ts...` are promoted when they are combined in an operation, according to the
+ * promotion policy selected by `KERNEL_FLOAT_PROMOTION_POLICY`.
+ */
+template<typename... Ts>
+using promote_t = typename detail::multi_policy_promote_type<decay_t<Ts>...>::type;
+
+/**
+ * The widest type of the types `Ts...`, regardless of the promotion policy. Use this for intermediate values that
+ * must not lose precision, such as accumulators.
+ */
+template<typename... Ts>
+using widest_promote_t = typename detail::multi_promote_type<decay_t<Ts>...>::type;
+
 template<typename T, typename...>
 using identity_t = T;
 
@@ -282,6 +374,17 @@ constexpr size_t round_up_to_power_of_two(size_t n) {
     return result;
 }
 
+namespace detail {
+// The number of elements processed per iteration for vectors that are not fully unrolled
+static constexpr size_t unroll_chunk_size = 8;
+
+// Returns `true` if operations on `N` elements should be fully unrolled, see `KERNEL_FLOAT_UNROLL_LIMIT`
+KERNEL_FLOAT_INLINE
+constexpr bool is_unrolled(size_t n) {
+    return n <= KERNEL_FLOAT_UNROLL_LIMIT || n < 2 * unroll_chunk_size;
+}
+}  // namespace detail
+
 }  // namespace kernel_float
 
 #endif
@@ -0,0 +1,274 @@
+#ifndef KERNEL_FLOAT_MINIFLOAT_H
+#define KERNEL_FLOAT_MINIFLOAT_H
+
+#include <cstring>
+
+#include "macros.h"
+#include "vector.h"
+
+namespace kernel_float {
+namespace detail {
+KERNEL_FLOAT_INLINE unsigned int float_to_bits(float value) {
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(float));
+    return bits;
+}
+
+KERNEL_FLOAT_INLINE float bits_to_float(unsigned int bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+
+/**
+ * Describes a floating-point format of at most 8 bits that is implemented in software. The format has
+ * `ExponentBits` exponent bits, `MantissaBits` mantissa bits, and the given exponent `Bias`. `NanCode` is the bit
+ * pattern of NaN (or -1 if the format has no NaN). None of the formats have infinities, thus conversions saturate
+ * to the largest finite value. Conversions operate directly on the bits of the `float` (rebiasing the exponent and
+ * rounding the mantissa to nearest even), so they do not call any math library functions.
+ */
+template<
+    int ExponentBits,
+    int MantissaBits,
+    int Bias,
+    bool IsSigned = true,
+    int NanCode = -1,
+    bool HasSubnormals = true>
+struct minifloat_format {
+    static constexpr int digits = MantissaBits + 1;
+    static constexpr unsigned int sign_bit = IsSigned ? 1u << (ExponentBits + MantissaBits) : 0u;
+    static constexpr unsigned int magnitude_mask = (1u << (ExponentBits + MantissaBits)) - 1;
+    static constexpr unsigned int max_code =
+        magnitude_mask - (NanCode == int(magnitude_mask) ? 1 : 0);
+
+    static constexpr float pow2(int e) {
+        return e == 0 ? 1.0f : (e > 0 ? 2.0f * pow2(e - 1) : 0.5f * pow2(e + 1));
+    }
+
+    static constexpr float max_value =
+        float((max_code & ((1u << MantissaBits) - 1)) | (1u << MantissaBits))
+        * pow2(int(max_code >> MantissaBits) - Bias - MantissaBits);
+
+    /**
+     * Returns the bit pattern of the next representable value above (if `up`) or below `bits`. Since there are no
+     * infinities, the largest and smallest values are returned unchanged. NaN is also returned unchanged.
+     */
+    KERNEL_FLOAT_INLINE static unsigned int next_code(unsigned int bits, bool up) {
+        unsigned int magnitude = bits & magnitude_mask;
+        bool negative = (bits & sign_bit) != 0;
+
+        if (int(bits) == NanCode) {
+            return bits;
+        }
+
+        if (!IsSigned) {
+            return up ? (bits < max_code ? bits + 1 : bits) : (bits > 0 ? bits - 1 : bits);
+        }
+
+        if (magnitude == 0) {
+            return up ? 1 : (sign_bit | 1);
+        }
+
+        // Towards zero, negative zero is avoided since its bit pattern might be NaN
+        if (negative == up) {
+            return magnitude > 1 ? bits - 1 : 0;
+        }
+
+        return magnitude < max_code ? bits + 1 : bits;
+    }
+
+    KERNEL_FLOAT_INLINE static float decode(unsigned int bits) {
+        if (int(bits) == NanCode) {
+            return bits_to_float(0x7FC00000u);
+        }
+
+        unsigned int sign = bits & sign_bit ? 0x80000000u : 0u;
+        unsigned int exponent = (bits & magnitude_mask) >> MantissaBits;
+        unsigned int mantissa = bits & ((1u << MantissaBits) - 1);
+
+        if (exponent == 0 && HasSubnormals) {
+            // Subnormals are multiples of the smallest subnormal, this product is exact
+            float value = float(mantissa) * pow2(1 - Bias - MantissaBits);
+            return bits_to_float(float_to_bits(value) | sign);
+        }
+
+        // Rebias the exponent and move the mantissa to the most significant bits of the float mantissa
+        int float_exponent = int(exponent) - Bias + 127;
+
+        if (float_exponent > 0) {
+            return bits_to_float(
+                sign | (unsigned(float_exponent) << 23) | (mantissa << (23 - MantissaBits)));
+        }
+
+        // Below the normal range of float (only for e8m0), the implicit leading one becomes part of a float subnormal
+        unsigned int significand = mantissa | (1u << MantissaBits);
+        return bits_to_float(sign | (significand << (22 - MantissaBits + float_exponent)));
+    }
+
+    KERNEL_FLOAT_INLINE static unsigned int encode(float input) {
+        if (input != input) {
+            return NanCode >= 0 ? unsigned(NanCode) : 0;
+        }
+
+        unsigned int input_bits = float_to_bits(input);
+        bool negative = (input_bits >> 31) != 0;
+        unsigned int code = 0;
+
+        if (negative && !IsSigned) {
+            code = 0;
+        } else if (bits_to_float(input_bits & 0x7FFFFFFFu) >= max_value) {
+            code = max_code;
+        } else {
+            unsigned int magnitude_bits = input_bits & 0x7FFFFFFFu;
+            int exponent_offset = Bias - 127;
+
+            // Float subnormals are normalized first, multiplying by 2^24 is exact
+            if (magnitude_bits < 0x800000u) {
+                magnitude_bits = float_to_bits(bits_to_float(magnitude_bits) * 16777216.0f);
+                exponent_offset -= 24;
+            }
+
+            // The exponent of `input`, rebiased to the exponent of this format
+            int exponent = int(magnitude_bits >> 23) + exponent_offset;
+            unsigned int fraction = magnitude_bits & 0x7FFFFFu;
+            unsigned int value = 0;
+            int shift = 32;
+
+            if (exponent >= (HasSubnormals ? 1 : 0)) {
+                // The exponent and mantissa are rounded together, so rounding up carries over into the exponent
+                value = (unsigned(exponent) << 23) | fraction;
+                shift = 23 - MantissaBits;
+            } else if (HasSubnormals) {
+                // Subnormal: shift the significand (including the implicit leading one) to the smallest subnormal
+                value = fraction | 0x800000u;
+                shift = 24 - MantissaBits - exponent;
+            }
+
+            // Round to nearest with ties to even. Values below half of the smallest subnormal become zero.
+            if (shift < 25) {
+                unsigned int round_bit = 1u << (shift - 1);
+                code = (value + round_bit - 1 + ((value >> shift) & 1)) >> shift;
+            }
+        }
+
+        // Negative zero might not exist if its bit pattern is used for NaN
+        if (negative && !(code == 0 && NanCode == int(sign_bit))) {
+            code |= sign_bit;
+        }
+
+        return code;
+    }
+};
+}  // namespace detail
+
+#define KERNEL_FLOAT_DEFINE_MINIFLOAT(NAME, ...)                                         \
+    struct NAME {                                                                        \
+        using format_type = detail::minifloat_format<__VA_ARGS__>;                       \
+                                                                                         \
+        NAME() = default;                                                                \
+                                                                                         \
+        KERNEL_FLOAT_INLINE                                                              \
+        explicit NAME(float value) :                                                     \
+            bits((unsigned char)format_type::encode(value)) {}                           \
+                                                                                         \
+        KERNEL_FLOAT_INLINE                                                              \
+        explicit operator float() const {                                                \
+            return format_type::decode(bits);                                            \
+        }                                                                                \
+                                                                                         \
+        unsigned char bits;                                                              \
+    };                                                                                   \
+                                                                                         \
+    namespace ops {                                                                      \
+    template<>                                                                           \
+    struct cast<float, NAME> {                                                           \
+        KERNEL_FLOAT_INLINE NAME operator()(float input) noexcept {                      \
+            return NAME(input);                                                          \
+        }                                                                                \
+    };                                                                                   \
+                                                                                         \
+    template<>                                                                           \
+    struct cast<NAME, float> {                                                           \
+        KERNEL_FLOAT_INLINE float operator()(NAME input) noexcept {                      \
+            return float(input);                                                         \
+        }                                                                                \
+    };                                                                                   \
+    }                                                                                    \
+                                                                                         \
+    namespace detail {                                                                   \
+    template<>                                                                           \
+    struct allow_float_fallback<NAME> {                                                  \
+        static constexpr bool value = true;                                              \
+    };                                                                                   \
+                                                                                         \
+    template<>                                                                           \
+    struct rounding_traits<NAME> {                                                       \
+        static constexpr bool value = true;                                              \
+        static constexpr int digits = NAME::format_type::digits;                         \
+                                                                                         \
+        KERNEL_FLOAT_INLINE static NAME next_up(NAME input) {                            \
+            input.bits = (unsigned char)NAME::format_type::next_code(input.bits, true);  \
+            return input;                                                                \
+        }                                                                                \
+                                                                                         \
+        KERNEL_FLOAT_INLINE static NAME next_down(NAME input) {                          \
+            input.bits = (unsigned char)NAME::format_type::next_code(input.bits, false); \
+            return input;                                                                \
+        }                                                                                \
+    };                                                                                   \
+    }                                                                                    \
+                                                                                         \
+    KERNEL_FLOAT_DEFINE_PROMOTED_FLOAT(NAME)                                             \
+    KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(float, NAME)                                       \
+    KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(double, NAME)
+
+/**
+ * 8-bit float with 4 exponent bits and 3 mantissa bits, without infinities or negative zero. NaN is `0x80`.
+ */
+KERNEL_FLOAT_DEFINE_MINIFLOAT(fp8_e4m3fnuz, 4, 3, 8, true, 0x80)
+
+/**
+ * 8-bit float with 5 exponent bits and 2 mantissa bits, without infinities or negative zero. NaN is `0x80`.
+ */
+KERNEL_FLOAT_DEFINE_MINIFLOAT(fp8_e5m2fnuz, 5, 2, 16, true, 0x80)
+
+/**
+ * 6-bit float (OCP MX) with 3 exponent bits and 2 mantissa bits, stored in the lower bits of a byte.
+ */
+KERNEL_FLOAT_DEFINE_MINIFLOAT(fp6_e3m2, 3, 2, 3)
+
+/**
+ * 6-bit float (OCP MX) with 2 exponent bits and 3 mantissa bits, stored in the lower bits of a byte.
+ */
+KERNEL_FLOAT_DEFINE_MINIFLOAT(fp6_e2m3, 2, 3, 1)
+
+/**
+ * 8-bit unsigned power of two (OCP MX scale format), representing `2^(bits - 127)`. NaN is `0xFF`.
+ */
+KERNEL_FLOAT_DEFINE_MINIFLOAT(fp8_e8m0, 8, 0, 127, false, 0xFF, false)
+
+}  // namespace kernel_float
+
+#if KERNEL_FLOAT_FP16_AVAILABLE
+#include "fp16.h"
+
+namespace kernel_float {
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__half, fp8_e4m3fnuz)
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__half, fp8_e5m2fnuz)
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__half, fp6_e3m2)
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__half, fp6_e2m3)
+}  // namespace kernel_float
+#endif  // KERNEL_FLOAT_FP16_AVAILABLE
+
+#if KERNEL_FLOAT_BF16_AVAILABLE
+#include "bf16.h"
+
+namespace kernel_float {
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__nv_bfloat16, fp8_e4m3fnuz)
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__nv_bfloat16, fp8_e5m2fnuz)
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__nv_bfloat16, fp6_e3m2)
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__nv_bfloat16, fp6_e2m3)
+}  // namespace kernel_float
+#endif  // KERNEL_FLOAT_BF16_AVAILABLE
+
+#endif  // KERNEL_FLOAT_MINIFLOAT_H
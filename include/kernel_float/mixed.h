@@ -0,0 +1,187 @@
+#ifndef KERNEL_FLOAT_MIXED_H
+#define KERNEL_FLOAT_MIXED_H
+
+#include "base.h"
+#include "binops.h"
+#include "conversion.h"
+#include "lazy.h"
+#include "vector.h"
+
+namespace kernel_float {
+
+/**
+ * Vector of `N` elements that is stored using type `U`, but behaves as a vector of type `T` in all computations.
+ * For example, a `mixed_vec<float, half, 8>` occupies the registers (and memory) of eight half-precision values,
+ * while all arithmetic on it is performed in single precision.
+ *
+ * Reading a `mixed_vec` (using `get()`, `operator[]`, or by passing it to any function that accepts vectors)
+ * converts the elements to `T`, which is exact whenever `U` is narrower than `T`. The result of a computation is
+ * of type `vec<T, N>` and is only rounded to `U` when it is explicitly committed using `commit` (or assignment).
+ * This is the value counterpart of `vector_ptr<T, N, U>`, which makes the same distinction for memory.
+ *
+ * Example
+ * =======
+ * ```
+ * mixed_vec<float, half, 8> acc;
+ * vec<float, 8> x = acc * 2.0f + 1.0f;  // Computed in float, no rounding to half
+ * acc.commit(x);  // Rounded to half exactly once
+ * acc += x;  // Same as `acc.commit(acc.get() + x)`
+ * ```
+ */
+template<typename T, typename U, size_t N>
+struct mixed_vec {
+    using value_type = T;
+    using storage_type = U;
+    using extent_type = extent<N>;
+
+    mixed_vec() = default;
+
+    /**
+     * Constructs a `mixed_vec` by converting the given values (or scalar, which is broadcast) to the storage type.
+     */
+    template<typename V, enable_if_t<!is_same_type<decay_t<V>, mixed_vec>, int> = 0>
+    KERNEL_FLOAT_INLINE explicit mixed_vec(const V& values) :
+        storage_(convert_storage<U, N>(values)) {}
+
+    /**
+     * Returns the number of elements in this vector.
+     */
+    KERNEL_FLOAT_INLINE
+    static constexpr size_t size() {
+        return N;
+    }
+
+    /**
+     * Returns the elements of this vector converted to the compute type `T`.
+     */
+    KERNEL_FLOAT_INLINE
+    vector<T, extent<N>> get() const {
+        return convert_storage<T, N>(storage_);
+    }
+
+    /**
+     * Returns the element at index `i` converted to the compute type `T`.
+     */
+    KERNEL_FLOAT_INLINE
+    T operator[](size_t i) const {
+        return ops::cast<U, T> {}(storage_[i]);
+    }
+
+    /**
+     * Rounds the given values (or scalar, which is broadcast) to the storage type `U` and stores them in this vector.
+     */
+    template<typename V>
+    KERNEL_FLOAT_INLINE void commit(const V& values) {
+        storage_ = convert_storage<U, N>(values);
+    }
+
+    /**
+     * Shorthand for `commit(values)`.
+     */
+    template<typename V, enable_if_t<!is_same_type<decay_t<V>, mixed_vec>, int> = 0>
+    KERNEL_FLOAT_INLINE mixed_vec& operator=(const V& values) {
+        commit(values);
+        return *this;
+    }
+
+    /**
+     * Returns the elements as they are stored, without any conversion. Use this to write them to memory.
+     */
+    KERNEL_FLOAT_INLINE
+    vector<U, extent<N>>& storage() {
+        return storage_;
+    }
+
+    /**
+     * Returns the elements as they are stored, without any conversion. Use this to write them to memory.
+     */
+    KERNEL_FLOAT_INLINE
+    const vector<U, extent<N>>& storage() const {
+        return storage_;
+    }
+
+  private:
+    vector<U, extent<N>> storage_;
+};
+
+template<typename T, typename U, size_t N>
+struct into_vector_impl<mixed_vec<T, U, N>> {
+    using value_type = T;
+    using extent_type = extent<N>;
+
+    KERNEL_FLOAT_INLINE
+    static vector_storage<T, N> call(const mixed_vec<T, U, N>& input) {
+        return input.get();
+    }
+};
+
+// Vector operators already accept a `mixed_vec` as their other operand. These overloads add the cases where neither
+// operand is a `vector`, and disambiguate the cases where the other operand is a `vector` or a `lazy_expr` (both of
+// which also define operators that accept any type as their other operand).
+#define KERNEL_FLOAT_DEFINE_MIXED_OP(OP)                                           \
+    template<typename L, typename LU, typename R, typename RU, size_t N>           \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const mixed_vec<L, LU, N>& left,                                           \
+        const mixed_vec<R, RU, N>& right) -> decltype(left.get() OP right.get()) { \
+        return left.get() OP right.get();                                          \
+    }                                                                              \
+    template<typename L, typename LU, size_t N, typename R, typename E>            \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const mixed_vec<L, LU, N>& left,                                           \
+        const vector<R, E>& right) -> decltype(left.get() OP right) {              \
+        return left.get() OP right;                                                \
+    }                                                                              \
+    template<typename L, typename E, typename R, typename RU, size_t N>            \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const vector<L, E>& left,                                                  \
+        const mixed_vec<R, RU, N>& right) -> decltype(left OP right.get()) {       \
+        return left OP right.get();                                                \
+    }                                                                              \
+    template<typename L, typename LU, size_t N, typename R>                        \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const mixed_vec<L, LU, N>& left,                                           \
+        const lazy_expr<R>& right) -> decltype(left.get() OP right) {              \
+        return left.get() OP right;                                                \
+    }                                                                              \
+    template<typename L, typename R, typename RU, size_t N>                        \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const lazy_expr<L>& left,                                                  \
+        const mixed_vec<R, RU, N>& right) -> decltype(left OP right.get()) {       \
+        return left OP right.get();                                                \
+    }                                                                              \
+    template<typename L, typename LU, size_t N, typename R>                        \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const mixed_vec<L, LU, N>& left,                                           \
+        const R& right) -> decltype(left.get() OP right) {                         \
+        return left.get() OP right;                                                \
+    }                                                                              \
+    template<typename L, typename R, typename RU, size_t N>                        \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const L& left,                                                             \
+        const mixed_vec<R, RU, N>& right) -> decltype(left OP right.get()) {       \
+        return left OP right.get();                                                \
+    }
+
+KERNEL_FLOAT_DEFINE_MIXED_OP(+)
+KERNEL_FLOAT_DEFINE_MIXED_OP(-)
+KERNEL_FLOAT_DEFINE_MIXED_OP(*)
+KERNEL_FLOAT_DEFINE_MIXED_OP(/)
+
+// The operation is computed in `T` and the result is rounded to the storage type once, like `commit(get() OP value)`.
+#define KERNEL_FLOAT_DEFINE_MIXED_ASSIGN_OP(OP, OP_ASSIGN)      \
+    template<typename T, typename U, size_t N, typename V>      \
+    KERNEL_FLOAT_INLINE mixed_vec<T, U, N>& operator OP_ASSIGN( \
+        mixed_vec<T, U, N>& left,                               \
+        const V& right) {                                       \
+        left.commit(left.get() OP right);                       \
+        return left;                                            \
+    }
+
+KERNEL_FLOAT_DEFINE_MIXED_ASSIGN_OP(+, +=)
+KERNEL_FLOAT_DEFINE_MIXED_ASSIGN_OP(-, -=)
+KERNEL_FLOAT_DEFINE_MIXED_ASSIGN_OP(*, *=)
+KERNEL_FLOAT_DEFINE_MIXED_ASSIGN_OP(/, /=)
+
+}  // namespace kernel_float
+
+#endif  // KERNEL_FLOAT_MIXED_H
@@ -0,0 +1,188 @@
+#ifndef KERNEL_FLOAT_PACKED_H
+#define KERNEL_FLOAT_PACKED_H
+
+#include "base.h"
+#include "conversion.h"
+#include "memory.h"
+
+namespace kernel_float {
+
+/**
+ * Two signed 4-bit integers in the range [-8, 7] packed into a single byte. The first value is stored in the lower
+ * four bits and the second value in the upper four bits.
+ */
+struct int4x2 {
+    unsigned char bits;
+};
+
+/**
+ * Two unsigned 4-bit integers in the range [0, 15] packed into a single byte. The first value is stored in the lower
+ * four bits and the second value in the upper four bits.
+ */
+struct uint4x2 {
+    unsigned char bits;
+};
+
+/**
+ * Two 4-bit floating-point numbers in the e2m1 format (1 sign bit, 2 exponent bits, 1 mantissa bit) packed into a
+ * single byte. The representable magnitudes are 0, 0.5, 1, 1.5, 2, 3, 4, and 6. There are no infinities or NaNs.
+ */
+struct fp4x2_e2m1 {
+    unsigned char bits;
+};
+
+namespace detail {
+template<typename P>
+struct packed_traits;
+
+template<>
+struct packed_traits<int4x2> {
+    using value_type = int;
+
+    KERNEL_FLOAT_INLINE static int decode(unsigned int nibble) {
+        return int(nibble ^ 0x8) - 8;
+    }
+
+    // Saturates before converting to `int`, since that conversion is undefined for values out of range (and NaN)
+    template<typename F>
+    KERNEL_FLOAT_INLINE static unsigned int encode(F value) {
+        int result = value >= F(7) ? 7 : value > F(-8) ? int(value) : -8;
+        return (unsigned int)(result) & 0xF;
+    }
+};
+
+template<>
+struct packed_traits<uint4x2> {
+    using value_type = int;
+
+    KERNEL_FLOAT_INLINE static int decode(unsigned int nibble) {
+        return int(nibble);
+    }
+
+    template<typename F>
+    KERNEL_FLOAT_INLINE static unsigned int encode(F value) {
+        int result = value >= F(15) ? 15 : value > F(0) ? int(value) : 0;
+        return (unsigned int)(result);
+    }
+};
+
+template<>
+struct packed_traits<fp4x2_e2m1> {
+    using value_type = float;
+
+    KERNEL_FLOAT_INLINE static float decode(unsigned int nibble) {
+        // The magnitude is (1 + m / 2) * 2^(e - 1) for normal numbers and m / 2 for the subnormal numbers
+        unsigned int e = (nibble >> 1) & 0x3;
+        unsigned int m = nibble & 0x1;
+        float magnitude = e == 0 ? float(m) * 0.5f : float(2 + m) * float(1 << e) * 0.25f;
+        return nibble & 0x8 ? -magnitude : magnitude;
+    }
+
+    KERNEL_FLOAT_INLINE static unsigned int encode(float value) {
+        // Round to nearest with ties to even by counting the midpoints below `x`. Values larger than the largest
+        // value (6.0) saturate.
+        float x = ::fabsf(value);
+        unsigned int code = (x > 0.25f) + (x >= 0.75f) + (x > 1.25f) + (x >= 1.75f) + (x > 2.5f)
+            + (x >= 3.5f) + (x > 5.0f);
+        return ::signbit(value) ? code | 0x8 : code;
+    }
+};
+}  // namespace detail
+
+/**
+ * Unpacks a vector of `N` packed values (`int4x2`, `uint4x2`, or `fp4x2_e2m1`) into a vector of `2 * N` elements
+ * of type `R`.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<uint4x2, 2> packed = {uint4x2 {0x21}, uint4x2 {0x43}};
+ * vec<float, 4> values = unpack<float>(packed); // returns [1, 2, 3, 4]
+ * ```
+ */
+template<typename R, typename V>
+KERNEL_FLOAT_INLINE vector<R, extent<2 * vector_extent<V>>> unpack(const V& input) {
+    using P = vector_value_type<V>;
+    using traits = detail::packed_traits<P>;
+    using T = typename traits::value_type;
+    static constexpr size_t N = vector_extent<V>;
+
+    vector_storage<P, N> packed = into_vector_storage(input);
+    vector_storage<R, 2 * N> result;
+
+#pragma unroll
+    for (size_t i = 0; i < N; i++) {
+        unsigned int bits = packed.data()[i].bits;
+        result.data()[2 * i + 0] = ops::cast<T, R> {}(traits::decode(bits & 0xF));
+        result.data()[2 * i + 1] = ops::cast<T, R> {}(traits::decode(bits >> 4));
+    }
+
+    return result;
+}
+
+/**
+ * Packs a vector of `2 * N` elements into a vector of `N` packed values of type `P` (`int4x2`, `uint4x2`, or
+ * `fp4x2_e2m1`). Values outside the representable range saturate. Conversion to `int4x2` and `uint4x2` truncates
+ * towards zero (NaN becomes the smallest value), while conversion to `fp4x2_e2m1` rounds to nearest.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> values = {1.0f, -2.0f, 0.7f, 100.0f};
+ * vec<fp4x2_e2m1, 2> packed = pack<fp4x2_e2m1>(values); // represents [1, -2, 0.5, 6]
+ * ```
+ */
+template<typename P, typename V>
+KERNEL_FLOAT_INLINE vector<P, extent<vector_extent<V> / 2>> pack(const V& input) {
+    using traits = detail::packed_traits<P>;
+    using F = widest_promote_t<float, vector_value_type<V>>;
+    static constexpr size_t N = vector_extent<V> / 2;
+    static_assert(vector_extent<V> % 2 == 0, "the number of elements to pack must be even");
+
+    // The values are encoded in floating-point, such that they saturate before they are converted to an integer
+    vector_storage<F, 2 * N> values = convert_storage<F, 2 * N>(input);
+    vector_storage<P, N> result;
+
+#pragma unroll
+    for (size_t i = 0; i < N; i++) {
+        unsigned int lo = traits::encode(values.data()[2 * i + 0]);
+        unsigned int hi = traits::encode(values.data()[2 * i + 1]);
+        result.data()[i] = P {(unsigned char)(lo | (hi << 4))};
+    }
+
+    return result;
+}
+
+/**
+ * Loads `N` elements stored as `N / 2` packed values starting at `ptr` and unpacks them into a vector of type `R`.
+ * It is assumed that ``ptr`` is aligned such that the `N / 2` bytes can be loaded at once, see `read_aligned`.
+ *
+ * ```
+ * // Load 32 int4 weights (16 bytes) as floats
+ * vec<float, 32> weights = read_packed<float, 32>(ptr);
+ * ```
+ */
+template<typename R, size_t N, typename P>
+KERNEL_FLOAT_INLINE vector<R, extent<N>> read_packed(const P* ptr) {
+    static_assert(N % 2 == 0, "the number of elements to read must be even");
+    return unpack<R>(read_aligned<N / 2>(ptr));
+}
+
+/**
+ * Packs the elements of `values` and stores them as `N / 2` packed values starting at `ptr`. It is assumed that
+ * ``ptr`` is aligned such that the `N / 2` bytes can be stored at once, see `write_aligned`.
+ *
+ * ```
+ * vec<float, 32> weights = ...;
+ * write_packed(ptr, weights);
+ * ```
+ */
+template<typename P, typename V>
+KERNEL_FLOAT_INLINE void write_packed(P* ptr, const V& values) {
+    static constexpr size_t N = vector_extent<V>;
+    write_aligned<N / 2>(ptr, pack<P>(values));
+}
+
+}  // namespace kernel_float
+
+#endif  // KERNEL_FLOAT_PACKED_H
@@ -0,0 +1,531 @@
+#ifndef KERNEL_FLOAT_QUANTIZE_H
+#define KERNEL_FLOAT_QUANTIZE_H
+
+#include "base.h"
+#include "conversion.h"
+#include "memory.h"
+#include "minifloat.h"
+#include "packed.h"
+#include "unops.h"
+
+namespace kernel_float {
+
+namespace detail {
+/**
+ * The range of values that can be represented by the integer type `T`.
+ */
+template<typename T>
+struct quantize_limits {
+    static constexpr bool is_signed = T(-1) < T(0);
+    static constexpr T min = is_signed ? T(1ULL << (8 * sizeof(T) - 1)) : T(0);
+    static constexpr T max = T(~min);
+};
+}  // namespace detail
+
+namespace ops {
+template<typename R>
+struct quantize {
+    template<typename T, typename S, typename Z>
+    KERNEL_FLOAT_INLINE R operator()(T input, S scale, Z zero_point) {
+        using W = widest_promote_t<float, T, S>;
+        using limits = detail::quantize_limits<R>;
+
+        W x = cast<T, W> {}(input) / cast<S, W> {}(scale);
+        x = detail::round_to_integral<RoundingMode::NEAREST>(x) + cast<Z, W> {}(zero_point);
+
+        // Saturate to the range of `R`. This also maps NaN to the lowest value.
+        if (!(x > W(limits::min))) {
+            return limits::min;
+        }
+
+        if (x >= W(limits::max)) {
+            return limits::max;
+        }
+
+        return R(x);
+    }
+};
+
+template<typename R>
+struct dequantize {
+    template<typename T, typename S, typename Z>
+    KERNEL_FLOAT_INLINE R operator()(T input, S scale, Z zero_point) {
+        using W = widest_promote_t<float, R, S>;
+        W x = cast<T, W> {}(input) - cast<Z, W> {}(zero_point);
+        return cast<W, R> {}(x * cast<S, W> {}(scale));
+    }
+};
+}  // namespace ops
+
+/**
+ * Quantizes the elements of `input` to the integer type `R` (for example, `int8_t` or `uint8_t`) by computing
+ * `round(input / scale) + zero_point`. Rounding is to nearest with ties to even and values outside the range of
+ * `R` saturate to its minimum or maximum value.
+ *
+ * The `scale` and `zero_point` can be scalars (one scale for the entire vector) or vectors (one scale per
+ * element).
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> input = {-1.0f, 0.25f, 0.5f, 100.0f};
+ * vec<int8_t, 4> q = quantize<int8_t>(input, 0.1f);  // returns [-10, 2, 5, 127]
+ * vec<uint8_t, 4> p = quantize<uint8_t>(input, 0.1f, 128);  // returns [118, 130, 133, 255]
+ * ```
+ */
+template<typename R, typename V, typename S, typename Z = int>
+KERNEL_FLOAT_INLINE map_type<ops::quantize<R>, V, S, Z>
+quantize(const V& input, const S& scale, const Z& zero_point = {}) {
+    return map(ops::quantize<R> {}, input, scale, zero_point);
+}
+
+/**
+ * Dequantizes the elements of `input` to type `R` by computing `(input - zero_point) * scale`. This is the
+ * inverse of `quantize`.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int8_t, 3> input = {-10, 2, 127};
+ * vec<float, 3> x = dequantize(input, 0.1f);  // returns [-1.0f, 0.2f, 12.7f]
+ * ```
+ */
+template<typename R = float, typename V, typename S, typename Z = int>
+KERNEL_FLOAT_INLINE map_type<ops::dequantize<R>, V, S, Z>
+dequantize(const V& input, const S& scale, const Z& zero_point = {}) {
+    return map(ops::dequantize<R> {}, input, scale, zero_point);
+}
+
+namespace detail {
+template<typename F, typename R, typename T, typename S, typename Z>
+KERNEL_FLOAT_INLINE void quantize_buffer_impl(
+    F fun,
+    R* dst,
+    const T* src,
+    size_t n,
+    const S* scales,
+    const Z* zero_points,
+    size_t channels,
+    size_t thread_index,
+    size_t thread_count) {
+    size_t channel = thread_index % channels;
+    size_t channel_step = thread_count % channels;
+
+    // Keep track of the channel incrementally to avoid a modulo for every element
+    for (size_t i = thread_index; i < n; i += thread_count) {
+        Z zero_point = zero_points != nullptr ? zero_points[channel] : Z {};
+        dst[i] = fun(src[i], scales[channel], zero_point);
+
+        channel += channel_step;
+        channel = channel >= channels ? channel - channels : channel;
+    }
+}
+}  // namespace detail
+
+/**
+ * Quantizes the ``n`` elements of the buffer ``src`` to type ``R`` and stores them in the buffer ``dst``, see
+ * `quantize`. The buffer is assumed to consist of ``channels`` interleaved channels (i.e., element ``i`` belongs
+ * to channel ``i % channels``) and each channel has its own scale and zero point. If ``zero_points`` is a null
+ * pointer, the zero points are zero. Use ``channels = 1`` to use a single scale for the entire buffer.
+ *
+ * The work can be split over multiple threads using ``thread_index`` and ``thread_count``, where each thread
+ * processes every ``thread_count``-th element.
+ *
+ * ```
+ * // Quantize RGB pixels using one scale and zero point per color channel
+ * float scales[3] = {0.02f, 0.03f, 0.01f};
+ * int zero_points[3] = {128, 120, 110};
+ * quantize_buffer(output, input, num_pixels * 3, scales, zero_points, 3);
+ * ```
+ */
+template<typename R, typename T, typename S, typename Z = int>
+KERNEL_FLOAT_INLINE void quantize_buffer(
+    R* dst,
+    const T* src,
+    size_t n,
+    const S* scales,
+    const Z* zero_points = nullptr,
+    size_t channels = 1,
+    size_t thread_index = 0,
+    size_t thread_count = 1) {
+    detail::quantize_buffer_impl(
+        ops::quantize<R> {},
+        dst,
+        src,
+        n,
+        scales,
+        zero_points,
+        channels,
+        thread_index,
+        thread_count);
+}
+
+/**
+ * Dequantizes the ``n`` elements of the buffer ``src`` to type ``R`` and stores them in the buffer ``dst``. This
+ * is the inverse of `quantize_buffer` and accepts the same per-channel ``scales`` and ``zero_points``.
+ */
+template<typename R, typename T, typename S, typename Z = int>
+KERNEL_FLOAT_INLINE void dequantize_buffer(
+    R* dst,
+    const T* src,
+    size_t n,
+    const S* scales,
+    const Z* zero_points = nullptr,
+    size_t channels = 1,
+    size_t thread_index = 0,
+    size_t thread_count = 1) {
+    detail::quantize_buffer_impl(
+        ops::dequantize<R> {},
+        dst,
+        src,
+        n,
+        scales,
+        zero_points,
+        channels,
+        thread_index,
+        thread_count);
+}
+
+namespace detail {
+/**
+ * Describes how a block of ``N`` elements of type `E` is loaded from and stored to memory by `block_scaled_ptr`.
+ * The default implementation is for integer types, where values are rounded to nearest and saturated.
+ */
+template<typename E>
+struct block_scaled_traits {
+    static constexpr size_t elements_per_item = 1;
+    static constexpr float max_value = float(quantize_limits<E>::max);
+
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static vector_storage<float, N> load(const E* ptr) {
+        return convert_storage<float, N>(read_aligned<N>(ptr));
+    }
+
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static void store(E* ptr, const vector_storage<float, N>& values) {
+        write_aligned<N>(ptr, quantize<E>(values, 1.0f));
+    }
+};
+
+template<typename E>
+struct block_scaled_float_traits {
+    static constexpr size_t elements_per_item = 1;
+
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static vector_storage<float, N> load(const E* ptr) {
+        return convert_storage<float, N>(read_aligned<N>(ptr));
+    }
+
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static void store(E* ptr, const vector_storage<float, N>& values) {
+        write_aligned<N>(ptr, convert_storage<E, N>(values));
+    }
+};
+
+template<typename P, bool RoundToIntegral>
+struct block_scaled_packed_traits {
+    static constexpr size_t elements_per_item = 2;
+
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static vector_storage<float, N> load(const P* ptr) {
+        return unpack<float>(read_aligned<N / 2>(ptr));
+    }
+
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static void store(P* ptr, vector_storage<float, N> values) {
+        // `pack` truncates towards zero for integer formats, round to nearest first
+        if (RoundToIntegral) {
+#pragma unroll
+            for (size_t i = 0; i < N; i++) {
+                values.data()[i] = round_to_integral<RoundingMode::NEAREST>(values.data()[i]);
+            }
+        }
+
+        write_aligned<N / 2>(ptr, pack<P>(values));
+    }
+};
+
+#define KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(T, MAX_VALUE)         \
+    template<>                                                       \
+    struct block_scaled_traits<T>: block_scaled_float_traits<T> {    \
+        static constexpr float max_value = MAX_VALUE;                \
+    };
+
+KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(fp8_e4m3fnuz, fp8_e4m3fnuz::format_type::max_value)
+KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(fp8_e5m2fnuz, fp8_e5m2fnuz::format_type::max_value)
+KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(fp6_e3m2, fp6_e3m2::format_type::max_value)
+KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(fp6_e2m3, fp6_e2m3::format_type::max_value)
+
+template<>
+struct block_scaled_traits<int4x2>: block_scaled_packed_traits<int4x2, true> {
+    static constexpr float max_value = 7.0f;
+};
+
+template<>
+struct block_scaled_traits<uint4x2>: block_scaled_packed_traits<uint4x2, true> {
+    static constexpr float max_value = 15.0f;
+};
+
+template<>
+struct block_scaled_traits<fp4x2_e2m1>: block_scaled_packed_traits<fp4x2_e2m1, false> {
+    static constexpr float max_value = 6.0f;
+};
+}  // namespace detail
+
+/**
+ * A pointer to block-scaled data (for example, the MXFP8, MXFP4, or block-int8 formats), where every block of
+ * `BlockSize` consecutive elements of type `E` shares a single scale of type `S`. The elements are stored in the
+ * buffer ``data`` and the scales are stored in the buffer ``scales`` (one scale per block).
+ *
+ * Reading block ``i`` returns a `vec<T, BlockSize>` that has already been multiplied by the scale of the block.
+ * Writing block ``i`` computes the scale from the largest absolute value (amax) of the block, such that the amax
+ * maps onto the largest value representable by `E`, and stores both the scale and the scaled elements. If `S` has
+ * lower precision than float (for example, `fp8_e8m0`), the scale is rounded up and the elements are scaled using
+ * the rounded scale. For `fp8_e8m0`, this gives the scale ``2^ceil(log2(amax / max_value))``.
+ *
+ * `E` can be an integer type (e.g., ``int8_t``), one of the minifloat types (e.g., `fp8_e4m3fnuz`), ``__nv_fp8_e4m3``
+ * and ``__nv_fp8_e5m2``, or one of the packed types (`int4x2`, `uint4x2`, or `fp4x2_e2m1`), in which case every
+ * element of ``data`` holds two values. It is assumed that ``data`` is aligned to the size of a block.
+ *
+ * Example
+ * =======
+ * ```
+ * // MXFP4 weights: blocks of 32 values in fp4 (16 bytes) with one power-of-two scale
+ * block_scaled_ptr<float, 32, fp4x2_e2m1, fp8_e8m0> weights(data, scales);
+ * vec<float, 32> w = weights.read(block);
+ *
+ * // Block-int8: blocks of 32 values in int8 with one float scale
+ * block_scaled_ptr<float, 32, int8_t> output(data, scales);
+ * output.write(block, values);
+ * ```
+ */
+template<typename T, size_t BlockSize, typename E, typename S = float>
+struct block_scaled_ptr {
+    using value_type = decay_t<T>;
+    using element_type = decay_t<E>;
+    using scale_type = decay_t<S>;
+    using traits = detail::block_scaled_traits<element_type>;
+
+    static constexpr size_t block_size = BlockSize;
+    static constexpr size_t items_per_block = BlockSize / traits::elements_per_item;
+    static_assert(
+        BlockSize % traits::elements_per_item == 0,
+        "invalid block size for element type");
+
+    /**
+     * Default constructor sets the pointers to `NULL`.
+     */
+    block_scaled_ptr() = default;
+
+    /**
+     * Constructs a block-scaled pointer from the buffer of elements and the buffer of scales.
+     */
+    KERNEL_FLOAT_INLINE block_scaled_ptr(E* data, S* scales) : data_(data), scales_(scales) {}
+
+    /**
+     * Returns the scale of block ``index`` as a float.
+     */
+    KERNEL_FLOAT_INLINE float scale(size_t index) const {
+        return ops::cast<scale_type, float> {}(scales_[index]);
+    }
+
+    /**
+     * Reads block ``index`` and multiplies its elements by the scale of the block.
+     */
+    KERNEL_FLOAT_INLINE vector<value_type, extent<BlockSize>> read(size_t index) const {
+        vector_storage<float, BlockSize> values =
+            traits::template load<BlockSize>(data_ + index * items_per_block);
+        float s = scale(index);
+
+#pragma unroll
+        for (size_t i = 0; i < BlockSize; i++) {
+            values.data()[i] = values.data()[i] * s;
+        }
+
+        return convert_storage<value_type, BlockSize>(values);
+    }
+
+    /**
+     * Shorthand for `read(index)`.
+     */
+    KERNEL_FLOAT_INLINE vector<value_type, extent<BlockSize>> operator[](size_t index) const {
+        return read(index);
+    }
+
+    /**
+     * Writes ``values`` to block ``index``. The scale of the block is computed from the largest absolute value of
+     * ``values`` and is stored as well.
+     */
+    template<typename V>
+    KERNEL_FLOAT_INLINE void write(size_t index, const V& values) const {
+        vector_storage<float, BlockSize> items = convert_storage<float, BlockSize>(values);
+        float amax = kernel_float::amax(items);
+
+        // The scale is rounded up, since a scale that is rounded down would saturate the largest elements. The
+        // elements are scaled using the scale as it is stored.
+        scale_type s = ops::cast<float, scale_type, RoundingMode::UP> {}(amax / traits::max_value);
+        float actual_scale = ops::cast<scale_type, float> {}(s);
+        float inv_scale = actual_scale > 0.0f ? 1.0f / actual_scale : 0.0f;
+
+#pragma unroll
+        for (size_t i = 0; i < BlockSize; i++) {
+            items.data()[i] = items.data()[i] * inv_scale;
+        }
+
+        traits::template store<BlockSize>(data_ + index * items_per_block, items);
+        scales_[index] = s;
+    }
+
+    /**
+     * Gets the pointer to the elements.
+     */
+    KERNEL_FLOAT_INLINE E* get() const {
+        return data_;
+    }
+
+    /**
+     * Gets the pointer to the scales.
+     */
+    KERNEL_FLOAT_INLINE S* scales() const {
+        return scales_;
+    }
+
+  private:
+    E* data_ = nullptr;
+    S* scales_ = nullptr;
+};
+
+/**
+ * Returns the largest absolute value (amax) of the ``n`` elements of the buffer ``src``.
+ *
+ * The work can be split over multiple threads using ``thread_index`` and ``thread_count``, where each thread
+ * processes every ``thread_count``-th element. The results of the threads must then be combined by taking their
+ * maximum.
+ */
+template<typename T>
+KERNEL_FLOAT_INLINE float
+amax_buffer(const T* src, size_t n, size_t thread_index = 0, size_t thread_count = 1) {
+    float result = 0.0f;
+
+    for (size_t i = thread_index; i < n; i += thread_count) {
+        result = ::fmaxf(result, ::fabsf(ops::cast<T, float> {}(src[i])));
+    }
+
+    return result;
+}
+
+/**
+ * Converts the ``n`` elements of the buffer ``src`` to type ``R`` after multiplying them by ``scale`` and stores
+ * them in the buffer ``dst``. Returns the largest absolute value (amax) of the elements of ``src``, which is
+ * computed in the same pass and can be used to compute the scale of the next cast (see `delayed_scaling`).
+ *
+ * The work can be split over multiple threads in the same way as for `amax_buffer`.
+ *
+ * ```
+ * delayed_scaling<__nv_fp8_e4m3> scaling;
+ *
+ * // Every step: cast using the current scale and record the amax for the next step
+ * float scale = scaling.scale();
+ * scaling.update(cast_scaled_buffer(output, input, n, scale));
+ * ```
+ */
+template<typename R, typename T>
+KERNEL_FLOAT_INLINE float cast_scaled_buffer(
+    R* dst,
+    const T* src,
+    size_t n,
+    float scale,
+    size_t thread_index = 0,
+    size_t thread_count = 1) {
+    float result = 0.0f;
+
+    for (size_t i = thread_index; i < n; i += thread_count) {
+        float value = ops::cast<T, float> {}(src[i]);
+        result = ::fmaxf(result, ::fabsf(value));
+        dst[i] = ops::cast<float, R> {}(value * scale);
+    }
+
+    return result;
+}
+
+/**
+ * Computes the scale for casting to the reduced-precision type `E` (for example, ``__nv_fp8_e4m3``) from the
+ * history of the amax of the last `HistoryLength` steps ("delayed scaling"). The scale maps the largest amax in
+ * the history onto the largest value representable by `E`, so values are only clipped if the amax grows faster
+ * than the history can follow.
+ *
+ * Example
+ * =======
+ * ```
+ * delayed_scaling<__nv_fp8_e4m3, 16> scaling;
+ *
+ * float scale = scaling.scale();  // 1.0 until an amax has been recorded
+ * float amax = cast_scaled_buffer(output, input, n, scale);
+ * scaling.update(amax);
+ *
+ * // The original values are `output[i] / scale`
+ * ```
+ */
+template<typename E, size_t HistoryLength = 16>
+struct delayed_scaling {
+    static_assert(HistoryLength > 0, "the history length cannot be zero");
+    static constexpr float max_value = detail::block_scaled_traits<decay_t<E>>::max_value;
+
+    /**
+     * Records the amax of the current step, replacing the oldest entry of the history.
+     */
+    KERNEL_FLOAT_INLINE void update(float amax) {
+        history_[position_] = amax;
+        position_ = position_ + 1 < HistoryLength ? position_ + 1 : 0;
+    }
+
+    /**
+     * Returns the largest amax in the history.
+     */
+    KERNEL_FLOAT_INLINE float amax() const {
+        float result = 0.0f;
+
+#pragma unroll
+        for (size_t i = 0; i < HistoryLength; i++) {
+            result = ::fmaxf(result, history_[i]);
+        }
+
+        return result;
+    }
+
+    /**
+     * Returns the factor by which values should be multiplied before casting them to `E`. Returns one if the
+     * history is empty (or contains only zeros or non-finite values).
+     */
+    KERNEL_FLOAT_INLINE float scale() const {
+        float a = amax();
+        return a > 0.0f && ::isfinite(a) ? max_value / a : 1.0f;
+    }
+
+    /**
+     * Returns the factor by which values should be multiplied after casting them back from `E`. This is the
+     * inverse of `scale`.
+     */
+    KERNEL_FLOAT_INLINE float inverse_scale() const {
+        return 1.0f / scale();
+    }
+
+  private:
+    float history_[HistoryLength] = {};
+    size_t position_ = 0;
+};
+
+}  // namespace kernel_float
+
+#if KERNEL_FLOAT_FP8_AVAILABLE
+#include "fp8.h"
+
+namespace kernel_float {
+namespace detail {
+KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(__nv_fp8_e4m3, 448.0f)
+KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(__nv_fp8_e5m2, 57344.0f)
+}  // namespace detail
+}  // namespace kernel_float
+#endif  // KERNEL_FLOAT_FP8_AVAILABLE
+
+#endif  // KERNEL_FLOAT_QUANTIZE_H
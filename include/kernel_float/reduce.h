@@ -1,12 +1,14 @@
 #ifndef KERNEL_FLOAT_REDUCE_H
 #define KERNEL_FLOAT_REDUCE_H
 
+#include <cstring>
+
 #include "binops.h"
 
 namespace kernel_float {
 namespace detail {
 
-template<size_t N>
+template<size_t N, bool = is_unrolled(N)>
 struct reduce_recur_impl;
 
 template<typename F, size_t N, typename T, typename = void>
@@ -16,7 +18,7 @@ struct reduce_impl {
     }
 };
 
-template<size_t N>
+template<size_t N, bool>
 struct reduce_recur_impl {
     static constexpr size_t K = round_up_to_power_of_two(N) / 2;
 
@@ -36,6 +38,37 @@ struct reduce_recur_impl {
     }
 };
 
+// Large vectors are reduced into `K` partial results by a loop that is not unrolled
+template<size_t N>
+struct reduce_recur_impl<N, false> {
+    static constexpr size_t K = unroll_chunk_size;
+    static constexpr size_t M = N - N % K;
+
+    template<typename F, typename T>
+    KERNEL_FLOAT_INLINE static T call(F fun, const T* input) {
+        vector_storage<T, K> partial;
+
+#pragma unroll
+        for (size_t i = 0; i < K; i++) {
+            partial.data()[i] = input[i];
+        }
+
+#pragma unroll 1
+        for (size_t i = K; i < M; i += K) {
+            apply_impl<F, K, T, T, T>::call(fun, partial.data(), partial.data(), input + i);
+        }
+
+        T result = reduce_impl<F, K, T>::call(fun, partial.data());
+
+#pragma unroll
+        for (size_t i = M; i < N; i++) {
+            result = fun(result, input[i]);
+        }
+
+        return result;
+    }
+};
+
 template<>
 struct reduce_recur_impl<0> {};
 
@@ -78,6 +111,63 @@ KERNEL_FLOAT_INLINE vector_value_type<V> reduce(F fun, const V& input) {
         into_vector_storage(input).data());
 }
 
+namespace detail {
+template<typename E, size_t Axis, typename Is = make_index_sequence<E::rank>>
+struct reduce_axis_extent_helper;
+
+template<size_t... Ns, size_t Axis, size_t... Is>
+struct reduce_axis_extent_helper<extent<Ns...>, Axis, index_sequence<Is...>> {
+    using type = extent<(Is == Axis ? 1 : Ns)...>;
+};
+}  // namespace detail
+
+/**
+ * The extent `E` where dimension `Axis` has been reduced to size 1.
+ */
+template<typename E, size_t Axis>
+using reduce_axis_extent = typename detail::reduce_axis_extent_helper<E, Axis>::type;
+
+/**
+ * Reduce the elements of the multi-dimensional vector ``input`` along dimension `Axis` using the function ``fun``.
+ * The reduced dimension is kept with size 1, so the result can be broadcast against ``input``.
+ *
+ * Example
+ * =======
+ * ```
+ * vector<int, extent<2, 3>> x = {1, 2, 3, 4, 5, 6};
+ * vector<int, extent<1, 3>> y = reduce_axis<0>(ops::add<int> {}, x);  // returns [[5, 7, 9]]
+ * vector<int, extent<2, 1>> z = reduce_axis<1>(ops::add<int> {}, x);  // returns [[6], [15]]
+ * ```
+ */
+template<size_t Axis, typename F, typename V>
+KERNEL_FLOAT_INLINE vector<vector_value_type<V>, reduce_axis_extent<vector_extent_type<V>, Axis>>
+reduce_axis(F fun, const V& input) {
+    using T = vector_value_type<V>;
+    using E = vector_extent_type<V>;
+    static_assert(Axis < E::rank, "axis out of range");
+    static constexpr size_t dim = detail::extent_dim(E {}, Axis);
+    static constexpr size_t stride = detail::extent_stride(E {}, Axis);
+    static constexpr size_t N = E::value / dim;
+
+    vector_storage<T, E::value> items = into_vector_storage(input);
+    vector_storage<T, N> result;
+
+#pragma unroll
+    for (size_t i = 0; i < N; i++) {
+        size_t offset = (i / stride) * (dim * stride) + i % stride;
+        vector_storage<T, dim> lane;
+
+#pragma unroll
+        for (size_t k = 0; k < dim; k++) {
+            lane.data()[k] = items.data()[offset + k * stride];
+        }
+
+        result.data()[i] = detail::reduce_impl<F, dim, T>::call(fun, lane.data());
+    }
+
+    return result;
+}
+
 /**
  * Find the minimum element in the given vector ``input``.
  *
@@ -108,6 +198,44 @@ KERNEL_FLOAT_INLINE T max(const V& input) {
     return reduce(ops::max<T> {}, input);
 }
 
+namespace detail {
+// `ops::abs` is only defined for floating-point types. For signed integers, the magnitude of the most negative value
+// is not representable and saturates to the largest value. Unsigned values are returned as-is.
+template<typename T, typename = void>
+struct amax_abs {
+    KERNEL_FLOAT_INLINE T operator()(T input) {
+        T min_value = T(1ULL << (8 * sizeof(T) - 1));
+        T max_value = T(-(min_value + T(1)));
+        return input < T(0) ? (input == min_value ? max_value : T(-input)) : input;
+    }
+};
+
+template<typename T>
+struct amax_abs<T, enable_if_t<is_promoted_float<T>::value>> {
+    KERNEL_FLOAT_INLINE T operator()(T input) {
+        return ops::abs<T> {}(input);
+    }
+};
+}  // namespace detail
+
+/**
+ * Find the largest absolute value (amax) of the elements in the given vector ``input``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {5.0f, -7.0f, 2.0f, 1.0f};
+ * float y = amax(x);  // Returns 7
+ * ```
+ *
+ * For signed integers, the magnitude of the most negative value (e.g., ``INT_MIN``) cannot be represented and
+ * saturates to the largest value (e.g., ``INT_MAX``).
+ */
+template<typename V, typename T = vector_value_type<V>>
+KERNEL_FLOAT_INLINE T amax(const V& input) {
+    return reduce(ops::max<T> {}, map(detail::amax_abs<T> {}, input));
+}
+
 /**
  * Sum the items in the given vector ``input``.
  *
@@ -138,13 +266,128 @@ KERNEL_FLOAT_INLINE T product(const V& input) {
     return reduce(ops::multiply<T> {}, input);
 }
 
+namespace detail {
+KERNEL_FLOAT_INLINE int popcount(unsigned long long input) {
+#if KERNEL_FLOAT_IS_DEVICE
+    return __popcll(input);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(input);
+#else
+    int result = 0;
+    for (; input != 0; input &= input - 1) {
+        result++;
+    }
+    return result;
+#endif
+}
+
+template<size_t N>
+struct bitmask_impl {
+    static_assert(N <= 64, "bitmask only supports vectors of at most 64 elements");
+    static_assert(sizeof(bool) == 1, "bitmask requires bool to be one byte");
+
+    KERNEL_FLOAT_INLINE static unsigned long long call(const bool* input) {
+        unsigned long long result = 0;
+
+#pragma unroll
+        for (size_t i = 0; i < N; i += 8) {
+            // A bool is stored as a byte that is either 0 or 1. The multiplication moves the lowest bit of each of
+            // the eight bytes in `word` into the top byte.
+            unsigned long long word = 0;
+            memcpy(&word, input + i, N - i < 8 ? N - i : 8);
+            result |= ((word * 0x0102040810204080ULL) >> 56) << i;
+        }
+
+        return result;
+    }
+};
+
+template<size_t N, bool = (N <= 64)>
+struct bool_reduce_impl {
+    KERNEL_FLOAT_INLINE static bool all(const bool* input) {
+        return reduce_impl<ops::bit_and<bool>, N, bool>::call(ops::bit_and<bool> {}, input);
+    }
+
+    KERNEL_FLOAT_INLINE static bool any(const bool* input) {
+        return reduce_impl<ops::bit_or<bool>, N, bool>::call(ops::bit_or<bool> {}, input);
+    }
+
+    KERNEL_FLOAT_INLINE static int count(const bool* input) {
+        int result = 0;
+
+#pragma unroll
+        for (size_t i = 0; i < N; i++) {
+            result += input[i] ? 1 : 0;
+        }
+
+        return result;
+    }
+};
+
+// For at most 64 elements, the reductions become a single comparison or popcount on the bitmask
+template<size_t N>
+struct bool_reduce_impl<N, true> {
+    static constexpr unsigned long long full_mask = N == 64 ? ~0ULL : (1ULL << (N % 64)) - 1;
+
+    KERNEL_FLOAT_INLINE static bool all(const bool* input) {
+        return bitmask_impl<N>::call(input) == full_mask;
+    }
+
+    KERNEL_FLOAT_INLINE static bool any(const bool* input) {
+        return bitmask_impl<N>::call(input) != 0;
+    }
+
+    KERNEL_FLOAT_INLINE static int count(const bool* input) {
+        return popcount(bitmask_impl<N>::call(input));
+    }
+};
+}  // namespace detail
+
+/**
+ * Returns a bitmask where bit ``i`` is set if element ``i`` of the given vector ``input`` is non-zero. The vector
+ * can have at most 64 elements.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 5> x = {5, 0, 2, 1, 0};
+ * unsigned long long mask = bitmask(x);  // Returns 0b01101
+ * ```
+ */
+template<typename V>
+KERNEL_FLOAT_INLINE unsigned long long bitmask(const V& input) {
+    return detail::bitmask_impl<vector_extent<V>>::call(cast<bool>(input).data());
+}
+
+/**
+ * Returns a vector of ``N`` booleans where element ``i`` is ``true`` if bit ``i`` of ``mask`` is set. This is the
+ * inverse of ``bitmask``. Elements beyond the first 64 are ``false``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<bool, 4> x = from_bitmask<4>(0b0110);  // Returns [false, true, true, false]
+ * ```
+ */
+template<size_t N>
+KERNEL_FLOAT_INLINE vector<bool, extent<N>> from_bitmask(unsigned long long mask, extent<N> = {}) {
+    vector_storage<bool, N> result;
+
+#pragma unroll
+    for (size_t i = 0; i < N; i++) {
+        result.data()[i] = i < 64 && ((mask >> i) & 1) != 0;
+    }
+
+    return result;
+}
+
 /**
  * Check if all elements in the given vector ``input`` are non-zero. An element ``v`` is considered
  * non-zero if ``bool(v)==true``.
  */
 template<typename V>
 KERNEL_FLOAT_INLINE bool all(const V& input) {
-    return reduce(ops::bit_and<bool> {}, cast<bool>(input));
+    return detail::bool_reduce_impl<vector_extent<V>>::all(cast<bool>(input).data());
 }
 
 /**
@@ -153,7 +396,7 @@ KERNEL_FLOAT_INLINE bool all(const V& input) {
  */
 template<typename V>
 KERNEL_FLOAT_INLINE bool any(const V& input) {
-    return reduce(ops::bit_or<bool> {}, cast<bool>(input));
+    return detail::bool_reduce_impl<vector_extent<V>>::any(cast<bool>(input).data());
 }
 
 /**
@@ -169,7 +412,7 @@ KERNEL_FLOAT_INLINE bool any(const V& input) {
  */
 template<typename T = int, typename V>
 KERNEL_FLOAT_INLINE T count(const V& input) {
-    return sum(cast<T>(cast<bool>(input)));
+    return T(detail::bool_reduce_impl<vector_extent<V>>::count(cast<bool>(input).data()));
 }
 
 namespace detail {
@@ -275,6 +518,120 @@ template<typename V, typename T = vector_value_type<V>>
 KERNEL_FLOAT_INLINE T mag(const V& input) {
     return detail::magnitude_impl<T, vector_extent<V>>::call(into_vector_storage(input).data());
 }
+
+/**
+ * Running statistics (count, mean, and sum of squared deviations ``m2``) of a sequence of values, as computed by
+ * Welford's algorithm. Two partial results can be combined using ``merge_moments``, which makes it possible to
+ * compute the statistics of a large dataset in parallel and then merge the results.
+ */
+template<typename T>
+struct running_moments {
+    T count = T(0);
+    T mean = T(0);
+    T m2 = T(0);
+
+    /**
+     * Add a single value to these statistics.
+     */
+    KERNEL_FLOAT_INLINE
+    void push(T value) {
+        count = count + T(1);
+        T delta = value - mean;
+        mean = mean + delta / count;
+        m2 = m2 + delta * (value - mean);
+    }
+
+    /**
+     * Returns the population variance (``m2 / count``).
+     */
+    KERNEL_FLOAT_INLINE
+    T variance() const {
+        return count > T(0) ? m2 / count : T(0);
+    }
+
+    /**
+     * Returns the sample variance (``m2 / (count - 1)``).
+     */
+    KERNEL_FLOAT_INLINE
+    T sample_variance() const {
+        return count > T(1) ? m2 / (count - T(1)) : T(0);
+    }
+
+    /**
+     * Returns the population standard deviation.
+     */
+    KERNEL_FLOAT_INLINE
+    T stddev() const {
+        return ops::sqrt<T> {}(variance());
+    }
+};
+
+namespace ops {
+template<typename T>
+struct merge_moments {
+    KERNEL_FLOAT_INLINE running_moments<T>
+    operator()(const running_moments<T>& a, const running_moments<T>& b) {
+        T count = a.count + b.count;
+
+        if (count == T(0)) {
+            return a;
+        }
+
+        T delta = b.mean - a.mean;
+        T factor = b.count / count;
+
+        running_moments<T> result;
+        result.count = count;
+        result.mean = a.mean + delta * factor;
+        result.m2 = a.m2 + b.m2 + delta * delta * a.count * factor;
+        return result;
+    }
+};
+
+template<typename T>
+struct into_moments {
+    template<typename U>
+    KERNEL_FLOAT_INLINE running_moments<T> operator()(U value) {
+        return {T(1), ops::cast<U, T> {}(value), T(0)};
+    }
+};
+}  // namespace ops
+
+/**
+ * Combine the statistics of two disjoint sets of values into the statistics of their union. This uses the
+ * parallel formulation of Welford's algorithm by Chan et al.
+ *
+ * Example
+ * =======
+ * ```
+ * running_moments<float> a = moments(vec<float, 2>(1.0f, 2.0f));
+ * running_moments<float> b = moments(vec<float, 2>(3.0f, 4.0f));
+ * running_moments<float> c = merge_moments(a, b);  // count=4, mean=2.5, m2=5
+ * ```
+ */
+template<typename T>
+KERNEL_FLOAT_INLINE running_moments<T>
+merge_moments(const running_moments<T>& a, const running_moments<T>& b) {
+    return ops::merge_moments<T> {}(a, b);
+}
+
+/**
+ * Compute the count, mean, and sum of squared deviations (``m2``) of the elements in the given vector ``input``
+ * in a single pass. The statistics are accumulated in type ``A``, which is at least ``float``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {1.0f, 2.0f, 3.0f, 4.0f};
+ * running_moments<float> m = moments(x);
+ * float mean = m.mean;  // Returns 2.5
+ * float var = m.variance();  // Returns 1.25
+ * ```
+ */
+template<typename V, typename A = widest_promote_t<float, vector_value_type<V>>>
+KERNEL_FLOAT_INLINE running_moments<A> moments(const V& input) {
+    return reduce(ops::merge_moments<A> {}, map(ops::into_moments<A> {}, input));
+}
 }  // namespace kernel_float
 
 #endif  //KERNEL_FLOAT_REDUCE_H
@@ -11,6 +11,20 @@ namespace ops {
 
 template<typename T, typename R, RoundingMode m = RoundingMode::ANY, typename = void>
 struct cast;
+}  // namespace ops
+
+namespace detail {
+template<typename T, typename R, RoundingMode m, typename = void>
+struct cast_rounding;
+}
+
+namespace ops {
+template<typename T, typename R, RoundingMode m, typename>
+struct cast {
+    KERNEL_FLOAT_INLINE R operator()(T input) noexcept {
+        return detail::cast_rounding<T, R, m>::call(input);
+    }
+};
 
 template<typename T, RoundingMode m>
 struct cast<T, T, m> {
@@ -62,6 +76,242 @@ struct cast<T, R, RoundingMode::ANY> {
 
 }  // namespace ops
 
+namespace detail {
+/**
+ * Describes a floating-point type for conversions that must round in a specific `RoundingMode`. Specializations
+ * give the number of significand bits and how to step to the next representable value.
+ */
+template<typename T>
+struct rounding_traits {
+    static constexpr bool value = false;
+};
+
+template<>
+struct rounding_traits<float> {
+    static constexpr bool value = true;
+    static constexpr int digits = 24;
+
+    KERNEL_FLOAT_INLINE static float next_up(float input) {
+        return ::nextafterf(input, HUGE_VALF);
+    }
+
+    KERNEL_FLOAT_INLINE static float next_down(float input) {
+        return ::nextafterf(input, -HUGE_VALF);
+    }
+};
+
+template<>
+struct rounding_traits<double> {
+    static constexpr bool value = true;
+    static constexpr int digits = 53;
+
+    KERNEL_FLOAT_INLINE static double next_up(double input) {
+        return ::nextafter(input, HUGE_VAL);
+    }
+
+    KERNEL_FLOAT_INLINE static double next_down(double input) {
+        return ::nextafter(input, -HUGE_VAL);
+    }
+};
+
+// Steps the bit pattern of a sign-magnitude floating-point value to the next representable value.
+template<typename U>
+KERNEL_FLOAT_INLINE U next_float_bits(U bits, U sign_mask, bool up) {
+    if ((bits & U(~sign_mask)) == 0) {
+        return up ? U(1) : U(sign_mask | 1);
+    }
+
+    bool negative = (bits & sign_mask) != 0;
+    return negative == up ? U(bits - 1) : U(bits + 1);
+}
+
+template<typename T>
+static constexpr bool is_rounding_float =
+    rounding_traits<T>::value || allow_float_fallback<T>::value;
+
+template<RoundingMode M>
+KERNEL_FLOAT_INLINE float round_to_integral(float input) {
+    switch (M) {
+        case RoundingMode::DOWN:
+            return ::floorf(input);
+        case RoundingMode::UP:
+            return ::ceilf(input);
+        case RoundingMode::TOWARD_ZERO:
+            return ::truncf(input);
+        default: {
+            // Round half to even without depending on the floating-point environment.
+            float result = ::floorf(input);
+            float diff = input - result;
+            bool odd = ::fmodf(result, 2.0f) != 0.0f;
+            return diff > 0.5f || (diff == 0.5f && odd) ? result + 1.0f : result;
+        }
+    }
+}
+
+template<RoundingMode M>
+KERNEL_FLOAT_INLINE double round_to_integral(double input) {
+    switch (M) {
+        case RoundingMode::DOWN:
+            return ::floor(input);
+        case RoundingMode::UP:
+            return ::ceil(input);
+        case RoundingMode::TOWARD_ZERO:
+            return ::trunc(input);
+        default: {
+            double result = ::floor(input);
+            double diff = input - result;
+            bool odd = ::fmod(result, 2.0) != 0.0;
+            return diff > 0.5 || (diff == 0.5 && odd) ? result + 1.0 : result;
+        }
+    }
+}
+
+/**
+ * Rounds the integer `input` to `Digits` significant bits using rounding mode `M`. The result is returned as a
+ * `double`, which represents it exactly.
+ */
+template<int Digits, RoundingMode M, typename T>
+KERNEL_FLOAT_INLINE double round_integer_to_digits(T input) {
+    bool negative = input < T(0);
+    unsigned long long magnitude = (unsigned long long)(input);
+    magnitude = negative ? 0ULL - magnitude : magnitude;
+
+    int shift = 0;
+    while ((magnitude >> shift) >= (1ULL << Digits)) {
+        shift++;
+    }
+
+    unsigned long long result = magnitude >> shift;
+
+    if (shift > 0) {
+        unsigned long long remainder = magnitude & ((1ULL << shift) - 1);
+        unsigned long long half = 1ULL << (shift - 1);
+        bool inexact = remainder != 0;
+        bool round_up;
+
+        switch (M) {
+            case RoundingMode::DOWN:
+                round_up = negative && inexact;
+                break;
+            case RoundingMode::UP:
+                round_up = !negative && inexact;
+                break;
+            case RoundingMode::TOWARD_ZERO:
+                round_up = false;
+                break;
+            default:
+                round_up = remainder > half || (remainder == half && (result & 1));
+                break;
+        }
+
+        result += round_up ? 1 : 0;
+    }
+
+    double value = double(result) * double(1ULL << shift);
+    return negative ? -value : value;
+}
+
+// Integer to integer: the rounding mode is irrelevant.
+template<typename T, typename R, RoundingMode M>
+struct cast_rounding<T, R, M, enable_if_t<!is_rounding_float<T> && !is_rounding_float<R>>> {
+    KERNEL_FLOAT_INLINE static R call(T input) {
+        return ops::cast<T, R> {}(input);
+    }
+};
+
+// Floating-point to integer: round to an integral value first, after which the conversion is exact.
+template<typename T, typename R, RoundingMode M>
+struct cast_rounding<
+    T,
+    R,
+    M,
+    enable_if_t<allow_float_fallback<T>::value && !is_rounding_float<R>>> {
+    KERNEL_FLOAT_INLINE static R call(T input) {
+        float value = round_to_integral<M>(ops::cast<T, float> {}(input));
+        return ops::cast<float, R> {}(value);
+    }
+};
+
+template<typename R, RoundingMode M>
+struct cast_rounding<double, R, M, enable_if_t<!is_rounding_float<R>>> {
+    KERNEL_FLOAT_INLINE static R call(double input) {
+        return ops::cast<double, R> {}(round_to_integral<M>(input));
+    }
+};
+
+// Integer to floating-point: round to the precision of `R`, after which the conversion is exact.
+template<typename T, typename R, RoundingMode M>
+struct cast_rounding<T, R, M, enable_if_t<!is_rounding_float<T> && rounding_traits<R>::value>> {
+    KERNEL_FLOAT_INLINE static R call(T input) {
+        double value = round_integer_to_digits<rounding_traits<R>::digits, M>(input);
+        return cast_rounding<double, R, M>::call(value);
+    }
+};
+
+template<RoundingMode M>
+struct cast_rounding<double, double, M> {
+    KERNEL_FLOAT_INLINE static double call(double input) {
+        return input;
+    }
+};
+
+/**
+ * Floating-point to floating-point: convert using the default conversion and then correct the result by at most
+ * one step. All types involved can be represented exactly by `double`, so the correction is exact.
+ */
+template<typename T, typename R, RoundingMode M>
+struct cast_rounding<T, R, M, enable_if_t<is_rounding_float<T> && rounding_traits<R>::value>> {
+    KERNEL_FLOAT_INLINE static R call(T input) {
+        using traits = rounding_traits<R>;
+        double value = ops::cast<T, double> {}(input);
+        R result = ops::cast<T, R> {}(input);
+        double approx = ops::cast<R, double> {}(result);
+
+        // Exact result or NaN
+        if (approx == value || value != value) {
+            return result;
+        }
+
+        R lo = approx < value ? result : traits::next_down(result);
+        R hi = approx < value ? traits::next_up(result) : result;
+
+        switch (M) {
+            case RoundingMode::DOWN:
+                return lo;
+            case RoundingMode::UP:
+                return hi;
+            case RoundingMode::TOWARD_ZERO:
+                return value < 0 ? hi : lo;
+            default:
+                break;
+        }
+
+        // Infinity is treated as if it were the next value after the largest finite value.
+        double lo_value = ops::cast<R, double> {}(lo);
+        double hi_value = ops::cast<R, double> {}(hi);
+
+        if (::isinf(hi_value)) {
+            hi_value = 2 * lo_value - ops::cast<R, double> {}(traits::next_down(lo));
+        }
+
+        if (::isinf(lo_value)) {
+            lo_value = 2 * hi_value - ops::cast<R, double> {}(traits::next_up(hi));
+        }
+
+        if (value - lo_value != hi_value - value) {
+            return value - lo_value < hi_value - value ? lo : hi;
+        }
+
+        // Tie: pick the value with an even significand. The value with the smallest magnitude is a
+        // multiple of the distance between `lo` and `hi`.
+        bool lo_smallest = ::fabs(lo_value) < ::fabs(hi_value);
+        double smallest = lo_smallest ? lo_value : hi_value;
+        bool smallest_even = ::fmod(smallest / (hi_value - lo_value), 2.0) == 0.0;
+        return lo_smallest == smallest_even ? lo : hi;
+    }
+};
+}  // namespace detail
+
 /**
  * Cast the elements of the given vector `input` to a different type `R`.
  *
@@ -89,6 +339,13 @@ KERNEL_FLOAT_INLINE vector<R, vector_extent_type<V>> cast(const V& input) {
     KERNEL_FLOAT_INLINE vector<vector_value_type<V>, vector_extent_type<V>> NAME(const V& input) { \
         using F = ops::NAME<vector_value_type<V>>;                                                 \
         return map(F {}, input);                                                                   \
+    }                                                                                              \
+    template<typename P, typename V, typename = enable_if_t<is_math_policy<P>>>                    \
+    KERNEL_FLOAT_INLINE vector<vector_value_type<V>, vector_extent_type<V>> NAME(                  \
+        P policy,                                                                                  \
+        const V& input) {                                                                          \
+        using F = ops::NAME<vector_value_type<V>>;                                                 \
+        return map(policy, F {}, input);                                                           \
     }
 
 #define KERNEL_FLOAT_DEFINE_UNARY(NAME, EXPR)       \
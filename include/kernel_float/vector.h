@@ -18,7 +18,7 @@ namespace kernel_float {
  * `vector<T, extent<N>, vector_storage<T, E>>`.
  *
  * @tparam T The type of the values stored within the vector.
- * @tparam E The size of this vector. Should be of type `extent<N>`.
+ * @tparam E The size of this vector. Should be of type `extent<N>` or, for multi-dimensional vectors, `extent<M, N>`.
  * @tparam S The object's storage class. Should be the type `vector_storage<T, E>`
  */
 template<typename T, typename E, class S>
@@ -40,14 +40,27 @@ struct vector: public S {
     vector(const value_type& input = {}) :
         storage_type(detail::broadcast_impl<T, extent<1>, E>::call(input)) {}
 
-    // For all other arguments, we convert it using `convert_storage` according to broadcast rules
-    template<typename U, enable_if_t<is_implicit_convertible<vector_value_type<U>, T>, int> = 0>
+    // For all other arguments, we convert it using `convert_storage` according to broadcast rules. The storage
+    // type is excluded since it has no shape of its own, which matters for multi-dimensional extents.
+    template<
+        typename U,
+        enable_if_t<
+            is_implicit_convertible<vector_value_type<U>, T>
+                && !is_same_type<decay_t<U>, storage_type>,
+            int> = 0>
     KERNEL_FLOAT_INLINE vector(U&& input) :
-        storage_type(convert_storage<T>(input, extent_type {})) {}
+        storage_type(detail::convert_impl<vector_value_type<U>, vector_extent_type<U>, T, E>::call(
+            into_vector_storage(input))) {}
 
-    template<typename U, enable_if_t<!is_implicit_convertible<vector_value_type<U>, T>, int> = 0>
+    template<
+        typename U,
+        enable_if_t<
+            !is_implicit_convertible<vector_value_type<U>, T>
+                && !is_same_type<decay_t<U>, storage_type>,
+            int> = 0>
     KERNEL_FLOAT_INLINE explicit vector(U&& input) :
-        storage_type(convert_storage<T>(input, extent_type {})) {}
+        storage_type(detail::convert_impl<vector_value_type<U>, vector_extent_type<U>, T, E>::call(
+            into_vector_storage(input))) {}
 
     // List of `N` (where N >= 2), simply pass forward to the storage
     template<
@@ -0,0 +1,8 @@
+#include "kernel_float.h"
+namespace kf = kernel_float;
+
+__global__ void convert_buffer(output_type* output, const input_type* input, int n) {
+    size_t index = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t count = gridDim.x * blockDim.x;
+    kf::convert_buffer(output, input, n, index, count);
+}
@@ -0,0 +1,63 @@
+#!/usr/bin/env python
+import os
+
+import numpy
+from kernel_tuner import tune_kernel
+
+# Specify the compiler flags Kernel Tuner should use to compile our kernel
+ROOT_DIR = os.path.dirname(os.path.abspath(__file__)) + "/../"
+flags = [f"-I{ROOT_DIR}/include", "-std=c++17"]
+
+# Size in bytes of each type that is benchmarked
+TYPE_SIZES = {
+    "double": 8,
+    "float": 4,
+    "half": 2,
+    "__nv_bfloat16": 2,
+    "__nv_fp8_e4m3": 1,
+    "__nv_fp8_e5m2": 1,
+}
+
+
+def tune():
+    # Prepare the buffers. They are allocated as raw bytes, large enough for the widest type
+    size = 100000000
+    n = numpy.int32(size)
+    output = numpy.zeros(size * 8, dtype=numpy.uint8)
+    input = numpy.zeros(size * 8, dtype=numpy.uint8)
+
+    args = [output, input, n]
+
+    # Benchmark every pair of types and different thread block sizes
+    tune_params = dict()
+    tune_params["block_size_x"] = [128, 256, 512]
+    tune_params["input_type"] = list(TYPE_SIZES)
+    tune_params["output_type"] = list(TYPE_SIZES)
+    tune_params["elements_per_thread"] = [8, 32, 128]
+
+    # The kernel does not use `elements_per_thread` directly. It only reduces the number of threads that are
+    # launched, so that each thread converts roughly this many elements in its grid-stride loop.
+    grid_div_x = ["block_size_x", "elements_per_thread"]
+
+    # The bandwidth counts both the bytes that are read and the bytes that are written
+    def bandwidth(p):
+        num_bytes = size * (TYPE_SIZES[p["input_type"]] + TYPE_SIZES[p["output_type"]])
+        return num_bytes / (p["time"] / 1e3) / 1e9
+
+    metrics = {"GB/s": bandwidth}
+
+    results, env = tune_kernel(
+        "convert_buffer",
+        "convert_buffer.cu",
+        size,
+        args,
+        tune_params,
+        grid_div_x=grid_div_x,
+        metrics=metrics,
+        lang="cupy",
+        compiler_options=flags
+    )
+
+
+if __name__ == "__main__":
+    tune()
@@ -0,0 +1,106 @@
+// Host benchmark of `convert_buffer`. For each pair of types, the buffer is converted by a number of host threads
+// (using `thread_index` and `thread_count`) and the throughput is reported in GB/s, counting both the bytes that are
+// read and the bytes that are written. The GPU version of this benchmark is `convert_buffer.py`.
+//
+// Build and run from this directory:
+//   g++ -O3 -std=c++17 -pthread -I../include -I${CUDA_HOME}/include convert_buffer_host.cpp -o convert_buffer_host
+//   ./convert_buffer_host
+#include <cuda_bf16.h>
+#include <cuda_fp16.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "kernel_float.h"
+namespace kf = kernel_float;
+
+static constexpr size_t size = 32 * 1024 * 1024;
+static constexpr int repeats = 5;
+
+template<typename T>
+struct type_name;
+
+#define DEFINE_TYPE_NAME(T)                      \
+    template<>                                   \
+    struct type_name<T> {                        \
+        static constexpr const char* value = #T; \
+    };
+
+DEFINE_TYPE_NAME(double)
+DEFINE_TYPE_NAME(float)
+DEFINE_TYPE_NAME(__half)
+DEFINE_TYPE_NAME(__nv_bfloat16)
+
+// Returns the best throughput (in GB/s) out of `repeats` runs using `thread_count` host threads
+template<typename R, typename T>
+double benchmark(R* output, const T* input, size_t thread_count) {
+    double best_seconds = 0.0;
+
+    for (int r = 0; r < repeats; r++) {
+        auto before = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> threads;
+        for (size_t thread_index = 0; thread_index < thread_count; thread_index++) {
+            threads.emplace_back([=] {  //
+                kf::convert_buffer(output, input, size, thread_index, thread_count);
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - before;
+
+        if (r == 0 || seconds.count() < best_seconds) {
+            best_seconds = seconds.count();
+        }
+    }
+
+    return double(size * (sizeof(T) + sizeof(R))) / best_seconds / 1e9;
+}
+
+template<typename T, typename... Rs>
+void benchmark_input(char* output, const float* values, size_t max_threads) {
+    std::unique_ptr<T[]> input(new T[size]);
+    kf::convert_buffer(input.get(), values, size);
+
+    for (size_t thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+        for (double gbs :
+             {benchmark(reinterpret_cast<Rs*>(output), input.get(), thread_count)...}) {
+            printf("%15.2f", gbs);
+        }
+
+        printf("  %-14s %3zu threads\n", type_name<T>::value, thread_count);
+    }
+}
+
+template<typename... Ts>
+void benchmark_all() {
+    std::unique_ptr<float[]> values(new float[size]);
+    for (size_t i = 0; i < size; i++) {
+        values[i] = float(i % 1000) * 0.25f - 125.0f;
+    }
+
+    // The output buffer is allocated as raw bytes, large enough for the widest type
+    std::unique_ptr<char[]> output(new char[size * std::max({sizeof(Ts)...})]);
+    size_t max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    printf("Throughput (GB/s) for each output type (columns) and input type (rows)\n");
+    for (const char* name : {type_name<Ts>::value...}) {
+        printf("%15s", name);
+    }
+    printf("\n");
+
+    int unused[] = {(benchmark_input<Ts, Ts...>(output.get(), values.get(), max_threads), 0)...};
+    (void)unused;
+}
+
+int main() {
+    benchmark_all<double, float, __half, __nv_bfloat16>();
+    return 0;
+}
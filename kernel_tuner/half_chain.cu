@@ -0,0 +1,21 @@
+#include "kernel_float.h"
+namespace kf = kernel_float;
+
+__global__ void half_chain(
+        kf::vec<float_type, elements_per_thread>* output,
+        const kf::vec<float_type, elements_per_thread>* a,
+        const kf::vec<float_type, elements_per_thread>* b,
+        const kf::vec<float_type, elements_per_thread>* c,
+        int n
+) {
+    int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i * elements_per_thread < n) {
+#if use_lazy
+        // Evaluated in `kf::compute_type<float_type>` and rounded once at the end
+        output[i] = (kf::lazy(a[i]) * b[i] + c[i]) * a[i] - b[i];
+#else
+        // Every intermediate vector is rounded to `float_type`
+        output[i] = (a[i] * b[i] + c[i]) * a[i] - b[i];
+#endif
+    }
+}
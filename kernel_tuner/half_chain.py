@@ -0,0 +1,66 @@
+#!/usr/bin/env python
+import os
+
+import numpy
+from kernel_tuner import tune_kernel
+from kernel_tuner.accuracy import TunablePrecision, AccuracyObserver
+
+# Specify the compiler flags Kernel Tuner should use to compile our kernel
+ROOT_DIR = os.path.dirname(os.path.abspath(__file__)) + "/../"
+flags = [f"-I{ROOT_DIR}/include", "-std=c++17"]
+
+def tune():
+
+    # Prepare input data
+    size = 100000000
+    n = numpy.int32(size)
+    a = numpy.random.randn(size).astype(numpy.float64)
+    b = numpy.random.randn(size).astype(numpy.float64)
+    c = numpy.random.randn(size).astype(numpy.float64)
+    y = numpy.zeros_like(a)
+
+    # Prepare the argument list of the kernel
+    args = [
+        TunablePrecision("float_type", y),
+        TunablePrecision("float_type", a),
+        TunablePrecision("float_type", b),
+        TunablePrecision("float_type", c),
+        n,
+    ]
+
+    # Define the reference answer to compute the kernel output against
+    answer = [(a * b + c) * a - b, None, None, None, None]
+
+    # Define the tunable parameters. `use_lazy` selects between eager evaluation (rounding after every
+    # operation) and a lazy expression (computed in `kf::compute_type<float_type>` and rounded once).
+    tune_params = dict()
+    tune_params["block_size_x"] = [64, 128, 256, 512]
+    tune_params["float_type"] = ["half", "float"]
+    tune_params["elements_per_thread"] = [2, 4, 8]
+    tune_params["use_lazy"] = [0, 1]
+
+    # Observers will measure the error using either RMSE or MRE as error metric
+    observers = [
+        AccuracyObserver("RMSE", "error_rmse"),
+        AccuracyObserver("MRE", "error_relative"),
+    ]
+
+    # The metrics here are only to ensure Kernel Tuner prints them to the console
+    metrics = dict(RMSE=lambda p: p["error_rmse"], MRE=lambda p: p["error_relative"])
+
+    results, env = tune_kernel(
+        "half_chain",
+        "half_chain.cu",
+        size,
+        args,
+        tune_params,
+        answer=answer,
+        observers=observers,
+        metrics=metrics,
+        lang="cupy",
+        compiler_options=flags
+    )
+
+
+if __name__ == "__main__":
+    tune()
@@ -0,0 +1,98 @@
+// Host benchmark of `half_chain`: compares eager evaluation of an elementwise chain on `vec<__half, N>` (which
+// converts to float and back after every operation) with a `lazy` expression (which is computed in
+// `kf::compute_type<__half>`, i.e. float on the host, and rounded once). On the device, `__half` is computed natively,
+// which is what `half_chain.py` measures.
+//
+// Build and run from this directory:
+//   g++ -O3 -std=c++17 -I../include -I${CUDA_HOME}/include half_chain_host.cpp -o half_chain_host
+//   ./half_chain_host
+#include <cuda_fp16.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+
+#include "kernel_float.h"
+namespace kf = kernel_float;
+
+static constexpr size_t size = 16 * 1024 * 1024;
+static constexpr int repeats = 5;
+
+template<bool UseLazy, size_t N>
+void half_chain(
+    kf::vec<__half, N>* output,
+    const kf::vec<__half, N>* a,
+    const kf::vec<__half, N>* b,
+    const kf::vec<__half, N>* c,
+    size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (UseLazy) {
+            // Evaluated in `kf::compute_type<__half>` and rounded once at the end
+            output[i] = (kf::lazy(a[i]) * b[i] + c[i]) * a[i] - b[i];
+        } else {
+            // Every intermediate vector is rounded to `__half`
+            output[i] = (a[i] * b[i] + c[i]) * a[i] - b[i];
+        }
+    }
+}
+
+// Prints the best time per element out of `repeats` runs and the largest error compared to a double reference
+template<bool UseLazy, size_t N>
+void benchmark(const __half* a, const __half* b, const __half* c, __half* output) {
+    using V = kf::vec<__half, N>;
+    double best_seconds = 0.0;
+
+    for (int r = 0; r < repeats; r++) {
+        auto before = std::chrono::steady_clock::now();
+        half_chain<UseLazy, N>(
+            reinterpret_cast<V*>(output),
+            reinterpret_cast<const V*>(a),
+            reinterpret_cast<const V*>(b),
+            reinterpret_cast<const V*>(c),
+            size / N);
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - before;
+
+        if (r == 0 || seconds.count() < best_seconds) {
+            best_seconds = seconds.count();
+        }
+    }
+
+    double max_error = 0.0;
+    for (size_t i = 0; i < size; i++) {
+        double x = float(a[i]), y = float(b[i]), z = float(c[i]);
+        double error = std::fabs(double(float(output[i])) - ((x * y + z) * x - y));
+        max_error = error > max_error ? error : max_error;
+    }
+
+    printf(
+        "%-6s N=%-3zu %8.3f ns/element  max error %.6f\n",
+        UseLazy ? "lazy" : "eager",
+        N,
+        best_seconds / double(size) * 1e9,
+        max_error);
+}
+
+template<size_t N>
+void benchmark_both(const __half* a, const __half* b, const __half* c, __half* output) {
+    benchmark<false, N>(a, b, c, output);
+    benchmark<true, N>(a, b, c, output);
+}
+
+int main() {
+    std::unique_ptr<__half[]> a(new __half[size]);
+    std::unique_ptr<__half[]> b(new __half[size]);
+    std::unique_ptr<__half[]> c(new __half[size]);
+    std::unique_ptr<__half[]> output(new __half[size]);
+
+    for (size_t i = 0; i < size; i++) {
+        a[i] = __float2half(float(i % 97) / 97.0f - 0.5f);
+        b[i] = __float2half(float(i % 89) / 89.0f * 2.0f);
+        c[i] = __float2half(float(i % 83) / 83.0f - 0.25f);
+    }
+
+    benchmark_both<2>(a.get(), b.get(), c.get(), output.get());
+    benchmark_both<4>(a.get(), b.get(), c.get(), output.get());
+    benchmark_both<8>(a.get(), b.get(), c.get(), output.get());
+    return 0;
+}
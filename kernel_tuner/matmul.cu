@@ -0,0 +1,55 @@
+#include "kernel_float.h"
+namespace kf = kernel_float;
+
+// Every thread computes a `tile_m` x `tile_n` tile of `C = A * B` in registers. The loop over `k` is blocked
+// by `tile_k`: each step loads a `tile_m` x `tile_k` tile of `A` and a `tile_k` x `tile_n` tile of `B` and
+// multiplies them using `kf::matmul`. All matrices are square, row-major and `n` is a multiple of the tiles.
+__global__ void matmul(float* C, const float* A, const float* B, int n) {
+    int row = (blockIdx.y * blockDim.y + threadIdx.y) * tile_m;
+    int col = (blockIdx.x * blockDim.x + threadIdx.x) * tile_n;
+
+    if (row >= n || col >= n) {
+        return;
+    }
+
+    kf::vector<float, kf::extent<tile_m, tile_n>> acc = 0.0f;
+
+    for (int k = 0; k < n; k += tile_k) {
+        kf::vector<float, kf::extent<tile_m, tile_k>> a;
+        kf::vector<float, kf::extent<tile_k, tile_n>> b;
+
+#pragma unroll
+        for (int i = 0; i < tile_m; i++) {
+            kf::vec<float, tile_k> items = kf::read<tile_k>(&A[(row + i) * n + k]);
+
+#pragma unroll
+            for (int j = 0; j < tile_k; j++) {
+                a[i * tile_k + j] = items[j];
+            }
+        }
+
+#pragma unroll
+        for (int i = 0; i < tile_k; i++) {
+            kf::vec<float, tile_n> items = kf::read<tile_n>(&B[(k + i) * n + col]);
+
+#pragma unroll
+            for (int j = 0; j < tile_n; j++) {
+                b[i * tile_n + j] = items[j];
+            }
+        }
+
+        acc = acc + kf::matmul(a, b);
+    }
+
+#pragma unroll
+    for (int i = 0; i < tile_m; i++) {
+        kf::vec<float, tile_n> items;
+
+#pragma unroll
+        for (int j = 0; j < tile_n; j++) {
+            items[j] = acc[i * tile_n + j];
+        }
+
+        kf::write(&C[(row + i) * n + col], items);
+    }
+}
@@ -0,0 +1,57 @@
+#!/usr/bin/env python
+import os
+
+import numpy
+from kernel_tuner import tune_kernel
+
+# Specify the compiler flags Kernel Tuner should use to compile our kernel
+ROOT_DIR = os.path.dirname(os.path.abspath(__file__)) + "/../"
+flags = [f"-I{ROOT_DIR}/include", "-std=c++17"]
+
+
+def tune():
+
+    # Prepare the input matrices. The size must be a multiple of every tile size
+    size = 2048
+    n = numpy.int32(size)
+    a = numpy.random.randn(size, size).astype(numpy.float32)
+    b = numpy.random.randn(size, size).astype(numpy.float32)
+    c = numpy.zeros_like(a)
+
+    args = [c, a, b, n]
+
+    # Define the reference answer to compute the kernel output against
+    answer = [a @ b, None, None, None]
+
+    # Define the tunable parameters: the thread block size and the size of the register tiles
+    tune_params = dict()
+    tune_params["block_size_x"] = [8, 16, 32]
+    tune_params["block_size_y"] = [4, 8, 16]
+    tune_params["tile_m"] = [1, 2, 4, 8]
+    tune_params["tile_n"] = [1, 2, 4, 8]
+    tune_params["tile_k"] = [1, 4, 8]
+
+    # Each thread computes a tile of `tile_m` x `tile_n` elements
+    grid_div_x = ["block_size_x", "tile_n"]
+    grid_div_y = ["block_size_y", "tile_m"]
+
+    metrics = {"GFLOP/s": lambda p: 2 * size**3 / (p["time"] / 1e3) / 1e9}
+
+    results, env = tune_kernel(
+        "matmul",
+        "matmul.cu",
+        (size, size),
+        args,
+        tune_params,
+        grid_div_x=grid_div_x,
+        grid_div_y=grid_div_y,
+        answer=answer,
+        atol=1e-2,
+        metrics=metrics,
+        lang="cupy",
+        compiler_options=flags
+    )
+
+
+if __name__ == "__main__":
+    tune()
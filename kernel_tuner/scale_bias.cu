@@ -0,0 +1,16 @@
+#include "kernel_float.h"
+namespace kf = kernel_float;
+
+__global__ void scale_bias(
+        kf::vec<float_type, elements_per_thread>* output,
+        const kf::vec<float_type, elements_per_thread>* input,
+        float scale,
+        float bias,
+        int n
+) {
+    int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i * elements_per_thread < n) {
+        // `scale` and `bias` are applied as scalars, they are not broadcast into vectors first
+        output[i] = input[i] * float_type(scale) + float_type(bias);
+    }
+}
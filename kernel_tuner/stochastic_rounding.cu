@@ -0,0 +1,18 @@
+#include "kernel_float.h"
+namespace kf = kernel_float;
+
+__global__ void round_values(
+        kf::vec<output_type, elements_per_thread>* output,
+        const kf::vec<float, elements_per_thread>* input,
+        int n,
+        unsigned int seed
+) {
+    int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i * elements_per_thread < n) {
+#if use_stochastic
+        output[i] = kf::cast_stochastic<output_type>(input[i], seed ^ i);
+#else
+        output[i] = kf::cast<output_type, kf::RoundingMode::NEAREST>(input[i]);
+#endif
+    }
+}
@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+import os
+
+import numpy
+from kernel_tuner import tune_kernel, run_kernel
+
+# Specify the compiler flags Kernel Tuner should use to compile our kernel
+ROOT_DIR = os.path.dirname(os.path.abspath(__file__)) + "/../"
+flags = [f"-I{ROOT_DIR}/include", "-std=c++17"]
+
+
+def decode(raw, output_type):
+    # Interpret the raw 16-bit output as floating-point values
+    if output_type == "half":
+        return raw.view(numpy.float16).astype(numpy.float64)
+    else:
+        return (raw.astype(numpy.uint32) << 16).view(numpy.float32).astype(numpy.float64)
+
+
+def tune():
+
+    # Prepare input data. All values are slightly above one, but less than half a unit in the last place of
+    # half and bfloat16. Rounding to nearest thus always rounds down, while stochastic rounding is unbiased.
+    size = 100000000
+    n = numpy.int32(size)
+    seed = numpy.uint32(1234)
+    input = (1.0 + numpy.random.uniform(0, 2**-12, size)).astype(numpy.float32)
+    output = numpy.zeros(size, dtype=numpy.uint16)
+
+    args = [output, input, n, seed]
+
+    # Define the tunable parameters, in this case thread block size, the output type
+    # and whether to use stochastic rounding or rounding to nearest
+    tune_params = dict()
+    tune_params["block_size_x"] = [128, 256, 512]
+    tune_params["elements_per_thread"] = [2, 4, 8]
+    tune_params["output_type"] = ["half", "__nv_bfloat16"]
+    tune_params["use_stochastic"] = [0, 1]
+
+    # Report throughput in bytes read and written per second
+    metrics = {"GB/s": lambda p: size * (4 + 2) / (p["time"] / 1e3) / 1e9}
+
+    results, env = tune_kernel(
+        "round_values",
+        "stochastic_rounding.cu",
+        size,
+        args,
+        tune_params,
+        grid_div_x=["block_size_x", "elements_per_thread"],
+        metrics=metrics,
+        lang="cupy",
+        compiler_options=flags
+    )
+
+    # Measure the bias (mean error) of each rounding mode
+    for output_type in tune_params["output_type"]:
+        for use_stochastic in tune_params["use_stochastic"]:
+            params = dict(
+                block_size_x=256,
+                elements_per_thread=4,
+                output_type=output_type,
+                use_stochastic=use_stochastic,
+            )
+
+            answer = run_kernel(
+                "round_values",
+                "stochastic_rounding.cu",
+                size,
+                args,
+                params,
+                grid_div_x=["block_size_x", "elements_per_thread"],
+                lang="cupy",
+                compiler_options=flags
+            )
+
+            error = decode(answer[0], output_type) - input.astype(numpy.float64)
+            mode = "stochastic" if use_stochastic else "nearest"
+            print(f"{output_type} {mode}: bias={numpy.mean(error):.3e} rmse={numpy.sqrt(numpy.mean(error**2)):.3e}")
+
+
+if __name__ == "__main__":
+    tune()
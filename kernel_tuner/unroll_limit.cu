@@ -0,0 +1,12 @@
+#include "kernel_float.h"
+namespace kf = kernel_float;
+
+// `KERNEL_FLOAT_UNROLL_LIMIT` is defined by Kernel Tuner before `kernel_float.h` is included
+__global__ void unroll_limit(float* output, const kf::vec<float, elements_per_thread>* input, int n) {
+    int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i * elements_per_thread < n) {
+        kf::vec<float, elements_per_thread> x = input[i];
+        kf::vec<float, elements_per_thread> y = kf::exp(x * 0.5f) - kf::cast<float>(x > 0.0f);
+        output[i] = kf::sum(y * x);
+    }
+}
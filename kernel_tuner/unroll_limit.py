@@ -0,0 +1,50 @@
+#!/usr/bin/env python
+import os
+
+import numpy
+from kernel_tuner import tune_kernel
+
+# Specify the compiler flags Kernel Tuner should use to compile our kernel
+ROOT_DIR = os.path.dirname(os.path.abspath(__file__)) + "/../"
+flags = [f"-I{ROOT_DIR}/include", "-std=c++17"]
+
+
+def tune():
+    # Prepare input data
+    size = 2**26
+    n = numpy.int32(size)
+    input = numpy.random.randn(size).astype(numpy.float32)
+    output = numpy.zeros(size, dtype=numpy.float32)
+
+    args = [output, input, n]
+
+    # Each combination compiles the kernel with a different vector length and unroll limit, which shows
+    # the effect of `KERNEL_FLOAT_UNROLL_LIMIT` on compile time and run time.
+    tune_params = dict()
+    tune_params["block_size_x"] = [128]
+    tune_params["elements_per_thread"] = [8, 16, 32, 64, 128, 256]
+    tune_params["KERNEL_FLOAT_UNROLL_LIMIT"] = [8, 16, 32, 64, 128, 256]
+
+    # Each thread processes `elements_per_thread` elements
+    grid_div_x = ["block_size_x", "elements_per_thread"]
+
+    metrics = {
+        "GB/s": lambda p: size * 4 / (p["time"] / 1e3) / 1e9,
+        "compile time (ms)": lambda p: p["compile_time"],
+    }
+
+    results, env = tune_kernel(
+        "unroll_limit",
+        "unroll_limit.cu",
+        size,
+        args,
+        tune_params,
+        grid_div_x=grid_div_x,
+        metrics=metrics,
+        lang="cupy",
+        compiler_options=flags
+    )
+
+
+if __name__ == "__main__":
+    tune()
@@ -16,8 +16,8 @@
 
 //================================================================================
 // this file has been auto-generated, do not modify its contents!
-// date: 2024-05-17 10:55:41.948281
-// git hash: 41246ab6db9fcc24639342c439e606ba143ee346
+// date: 2026-10-18 12:52:05.587090
+// git hash: d084affbb9cd192d459a2b3695de420c764d0544
 //================================================================================
 
 #ifndef KERNEL_FLOAT_MACROS_H
@@ -89,6 +89,22 @@
 #define KERNEL_FLOAT_FAST_MATH (0)
 #endif
 
+// Promotion policies, see `promote_t`. By default, combining two floating-point types results in the widest of the
+// two (for example, `half + float` gives `float`). With `KERNEL_FLOAT_PROMOTE_NARROWEST`, the narrowest of the two
+// is used instead (`half + float` gives `half`), which reduces register usage and memory traffic.
+#define KERNEL_FLOAT_PROMOTE_WIDEST (0)
+#define KERNEL_FLOAT_PROMOTE_NARROWEST (1)
+
+#ifndef KERNEL_FLOAT_PROMOTION_POLICY
+#define KERNEL_FLOAT_PROMOTION_POLICY KERNEL_FLOAT_PROMOTE_WIDEST
+#endif
+
+// Vectors with more elements than this limit are processed using loops over small chunks, instead of fully
+// unrolling the operation. This limits compile time and code size for very large vectors.
+#ifndef KERNEL_FLOAT_UNROLL_LIMIT
+#define KERNEL_FLOAT_UNROLL_LIMIT (64)
+#endif
+
 #endif  //KERNEL_FLOAT_MACROS_H
 #ifndef KERNEL_FLOAT_CORE_H
 #define KERNEL_FLOAT_CORE_H
@@ -103,8 +119,22 @@ struct index_sequence {
 };
 
 namespace detail {
+template<typename L, size_t Offset, typename R>
+struct concat_index_sequence;
+
+template<size_t... Ls, size_t Offset, size_t... Rs>
+struct concat_index_sequence<index_sequence<Ls...>, Offset, index_sequence<Rs...>> {
+    using type = index_sequence<Ls..., (Offset + Rs)...>;
+};
+
+// Sequences longer than the predefined ones below are built by concatenating two halves.
 template<size_t N>
-struct make_index_sequence_impl {};
+struct make_index_sequence_impl {
+    using type = typename concat_index_sequence<
+        typename make_index_sequence_impl<N / 2>::type,
+        N / 2,
+        typename make_index_sequence_impl<N - N / 2>::type>::type;
+};
 
 // Benchmarks show that it is much faster to predefine all possible index sequences instead of doing something
 // recursive with variadic templates.
@@ -171,6 +201,14 @@ using decay_t = typename detail::decay_impl<T>::type;
 template<typename A, typename B>
 struct promote_type {};
 
+namespace detail {
+// Set to true for all floating-point types by `KERNEL_FLOAT_DEFINE_PROMOTED_FLOAT`
+template<typename T>
+struct is_promoted_float {
+    static constexpr bool value = false;
+};
+}  // namespace detail
+
 template<typename T>
 struct promote_type<T, T> {
     using type = T;
@@ -219,6 +257,12 @@ KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(long double, float)
 KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(long double, double)
 
 #define KERNEL_FLOAT_DEFINE_PROMOTED_FLOAT(T)                \
+    namespace detail {                                       \
+    template<>                                               \
+    struct is_promoted_float<T> {                            \
+        static constexpr bool value = true;                  \
+    };                                                       \
+    }                                                        \
     KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(T, char)               \
     KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(T, signed char)        \
     KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(T, signed short)       \
@@ -303,9 +347,6 @@ struct multi_promote_type<A, B, C, Rest...>:
 
 }  // namespace detail
 
-template<typename... Ts>
-using promote_t = typename detail::multi_promote_type<decay_t<Ts>...>::type;
-
 namespace detail {
 
 template<typename A, typename B>
@@ -362,6 +403,73 @@ struct enable_if_impl<true, T> {
 template<bool C, typename T = void>
 using enable_if_t = typename detail::enable_if_impl<C, T>::type;
 
+namespace detail {
+/**
+ * Promotes `A` and `B` like `promote_type`, except that combining two different floating-point types results in
+ * the narrowest of the two instead of the widest. Used if `KERNEL_FLOAT_PROMOTION_POLICY` is set to
+ * `KERNEL_FLOAT_PROMOTE_NARROWEST`.
+ */
+template<typename A, typename B, typename = void>
+struct narrow_promote_type: promote_type<A, B> {};
+
+template<typename A, typename B>
+struct narrow_promote_type<
+    A,
+    B,
+    enable_if_t<
+        is_promoted_float<A>::value && is_promoted_float<B>::value && !is_same_type<A, B>
+        && is_same_type<typename promote_type<A, B>::type, A>>> {
+    using type = B;
+};
+
+template<typename A, typename B>
+struct narrow_promote_type<
+    A,
+    B,
+    enable_if_t<
+        is_promoted_float<A>::value && is_promoted_float<B>::value && !is_same_type<A, B>
+        && is_same_type<typename promote_type<A, B>::type, B>>> {
+    using type = A;
+};
+
+#if KERNEL_FLOAT_PROMOTION_POLICY == KERNEL_FLOAT_PROMOTE_NARROWEST
+template<typename A, typename B>
+struct policy_promote_type: narrow_promote_type<A, B> {};
+#else
+template<typename A, typename B>
+struct policy_promote_type: promote_type<A, B> {};
+#endif
+
+template<typename... Ts>
+struct multi_policy_promote_type;
+
+template<typename T>
+struct multi_policy_promote_type<T> {
+    using type = T;
+};
+
+template<typename A, typename B>
+struct multi_policy_promote_type<A, B>: policy_promote_type<A, B> {};
+
+template<typename A, typename B, typename C, typename... Rest>
+struct multi_policy_promote_type<A, B, C, Rest...>:
+    multi_policy_promote_type<typename policy_promote_type<A, B>::type, C, Rest...> {};
+}  // namespace detail
+
+/**
+ * The type to which the types `Ts...` are promoted when they are combined in an operation, according to the
+ * promotion policy selected by `KERNEL_FLOAT_PROMOTION_POLICY`.
+ */
+template<typename... Ts>
+using promote_t = typename detail::multi_policy_promote_type<decay_t<Ts>...>::type;
+
+/**
+ * The widest type of the types `Ts...`, regardless of the promotion policy. Use this for intermediate values that
+ * must not lose precision, such as accumulators.
+ */
+template<typename... Ts>
+using widest_promote_t = typename detail::multi_promote_type<decay_t<Ts>...>::type;
+
 template<typename T, typename...>
 using identity_t = T;
 
@@ -374,6 +482,17 @@ constexpr size_t round_up_to_power_of_two(size_t n) {
     return result;
 }
 
+namespace detail {
+// The number of elements processed per iteration for vectors that are not fully unrolled
+static constexpr size_t unroll_chunk_size = 8;
+
+// Returns `true` if operations on `N` elements should be fully unrolled, see `KERNEL_FLOAT_UNROLL_LIMIT`
+KERNEL_FLOAT_INLINE
+constexpr bool is_unrolled(size_t n) {
+    return n <= KERNEL_FLOAT_UNROLL_LIMIT || n < 2 * unroll_chunk_size;
+}
+}  // namespace detail
+
 }  // namespace kernel_float
 
 #endif
@@ -466,8 +585,44 @@ template<size_t N>
 struct extent<N> {
     static constexpr size_t value = N;
     static constexpr size_t size = N;
+    static constexpr size_t rank = 1;
+};
+
+/**
+ * Multi-dimensional extent, for example `extent<M, N>` for a matrix of `M` rows and `N` columns. The elements are
+ * stored contiguously in row-major order, thus `value` is the total number of elements.
+ */
+template<size_t N, size_t M, size_t... Rest>
+struct extent<N, M, Rest...> {
+    static constexpr size_t value = N * extent<M, Rest...>::value;
+    static constexpr size_t size = value;
+    static constexpr size_t rank = 2 + sizeof...(Rest);
 };
 
+namespace detail {
+/**
+ * Returns the size of dimension `axis` of the given extent.
+ */
+template<size_t... Ns>
+KERNEL_FLOAT_INLINE constexpr size_t extent_dim(extent<Ns...>, size_t axis) {
+    constexpr size_t dims[] = {Ns...};
+    return dims[axis];
+}
+
+/**
+ * Returns the number of elements between two consecutive indices along dimension `axis` of the given extent.
+ */
+template<size_t... Ns>
+KERNEL_FLOAT_INLINE constexpr size_t extent_stride(extent<Ns...>, size_t axis) {
+    constexpr size_t dims[] = {Ns...};
+    size_t result = 1;
+    for (size_t i = axis + 1; i < sizeof...(Ns); i++) {
+        result *= dims[i];
+    }
+    return result;
+}
+}  // namespace detail
+
 namespace detail {
 // Indicates that elements of type `T` offer less precision than floats, thus operations
 // on elements of type `T` can be performed by upcasting them to ` float`.
@@ -482,6 +637,20 @@ struct allow_float_fallback<float> {
 };
 }  // namespace detail
 
+/**
+ * The type used to compute a chain of operations on elements of type `T`, see `lazy`. By default, this is `T`
+ * itself. Types without native arithmetic (such as `__half` on the host) are computed as `float` instead, such that
+ * the inputs are converted once and the result is rounded once, instead of converting before and after every
+ * operation. This struct can be specialized to change the compute type of `T`.
+ */
+template<typename T>
+struct compute_type_policy {
+    using type = T;
+};
+
+template<typename T>
+using compute_type = typename compute_type_policy<T>::type;
+
 template<typename T>
 struct into_vector_impl {
     using value_type = T;
@@ -661,19 +830,72 @@ struct broadcast_extent_helper<E> {
     using type = E;
 };
 
+// Two dimensions can be broadcast if they are equal or if one of them is 1
+template<size_t A, size_t B>
+struct broadcast_dim_helper {};
+
 template<size_t N>
-struct broadcast_extent_helper<extent<N>, extent<N>> {
-    using type = extent<N>;
+struct broadcast_dim_helper<N, N> {
+    static constexpr size_t value = N;
 };
 
 template<size_t N>
-struct broadcast_extent_helper<extent<1>, extent<N>> {
-    using type = extent<N>;
+struct broadcast_dim_helper<1, N> {
+    static constexpr size_t value = N;
 };
 
 template<size_t N>
-struct broadcast_extent_helper<extent<N>, extent<1>> {
-    using type = extent<N>;
+struct broadcast_dim_helper<N, 1> {
+    static constexpr size_t value = N;
+};
+
+template<>
+struct broadcast_dim_helper<1, 1> {
+    static constexpr size_t value = 1;
+};
+
+// Prepends `K` dimensions of size 1 to the extent `E`
+template<size_t K, typename E>
+struct prepend_ones_helper {
+    using type = E;
+};
+
+template<size_t K, size_t... Ns>
+struct prepend_ones_helper<K, extent<Ns...>>: prepend_ones_helper<K - 1, extent<1, Ns...>> {};
+
+template<size_t... Ns>
+struct prepend_ones_helper<0, extent<Ns...>> {
+    using type = extent<Ns...>;
+};
+
+template<typename A, typename B>
+struct broadcast_equal_rank_helper;
+
+template<size_t... As, size_t... Bs>
+struct broadcast_equal_rank_helper<extent<As...>, extent<Bs...>> {
+    using type = extent<broadcast_dim_helper<As, Bs>::value...>;
+};
+
+// Extents of different rank are aligned on their last dimension, so `extent<N>` acts as a row of `extent<M, N>`
+template<typename A, typename B>
+struct broadcast_extent_helper<A, B>:
+    broadcast_equal_rank_helper<
+        typename prepend_ones_helper<(B::rank > A::rank ? B::rank - A::rank : 0), A>::type,
+        typename prepend_ones_helper<(A::rank > B::rank ? A::rank - B::rank : 0), B>::type> {};
+
+template<typename E>
+struct broadcast_extent_helper<E, E> {
+    using type = E;
+};
+
+template<size_t... Ns>
+struct broadcast_extent_helper<extent<1>, extent<Ns...>> {
+    using type = extent<Ns...>;
+};
+
+template<size_t... Ns>
+struct broadcast_extent_helper<extent<Ns...>, extent<1>> {
+    using type = extent<Ns...>;
 };
 
 template<>
@@ -701,11 +923,56 @@ static constexpr bool is_vector_broadcastable = is_broadcastable<vector_extent_t
 
 namespace detail {
 
+/**
+ * Returns the index into a vector of extent `From` of the element that is broadcast to index `i` of a vector of
+ * extent `To`.
+ */
+template<size_t... Fs, size_t... Ts>
+KERNEL_FLOAT_INLINE constexpr size_t broadcast_index(size_t i, extent<Fs...>, extent<Ts...>) {
+    constexpr size_t rank = sizeof...(Ts);
+    constexpr size_t padding = rank - sizeof...(Fs);
+    constexpr size_t from[] = {Fs...};
+    constexpr size_t to[] = {Ts...};
+
+    size_t result = 0;
+    size_t stride = 1;
+
+    for (size_t k = rank; k > 0; k--) {
+        size_t from_dim = k - 1 < padding ? 1 : from[k - 1 - padding];
+        size_t index = i % to[k - 1];
+        i /= to[k - 1];
+
+        if (from_dim != 1) {
+            result += index * stride;
+        }
+
+        stride *= from_dim;
+    }
+
+    return result;
+}
+
 template<typename T, typename From, typename To>
-struct broadcast_impl;
+struct broadcast_impl {
+    static_assert(is_broadcastable<From, To>, "cannot broadcast vector to the given extent");
+
+    KERNEL_FLOAT_INLINE static vector_storage<T, To::value>
+    call(const vector_storage<T, From::value>& input) {
+        vector_storage<T, To::value> output;
+
+#pragma unroll
+        for (size_t i = 0; i < To::value; i++) {
+            output.data()[i] = input.data()[broadcast_index(i, From {}, To {})];
+        }
+
+        return output;
+    }
+};
+
+template<typename T, size_t... Ns>
+struct broadcast_impl<T, extent<1>, extent<Ns...>> {
+    static constexpr size_t N = extent<Ns...>::value;
 
-template<typename T, size_t N>
-struct broadcast_impl<T, extent<1>, extent<N>> {
     KERNEL_FLOAT_INLINE static vector_storage<T, N> call(const vector_storage<T, 1>& input) {
         vector_storage<T, N> output;
         for (size_t i = 0; i < N; i++) {
@@ -715,9 +982,9 @@ struct broadcast_impl<T, extent<1>, extent<N>> {
     }
 };
 
-template<typename T, size_t N>
-struct broadcast_impl<T, extent<N>, extent<N>> {
-    KERNEL_FLOAT_INLINE static vector_storage<T, N> call(vector_storage<T, N> input) {
+template<typename T, typename E>
+struct broadcast_impl<T, E, E> {
+    KERNEL_FLOAT_INLINE static vector_storage<T, E::value> call(vector_storage<T, E::value> input) {
         return input;
     }
 };
@@ -735,6 +1002,9 @@ struct broadcast_impl<T, extent<1>, extent<1>> {
  * Takes the given vector `input` and extends its size to a length of `N`. This is only valid if the size of `input`
  * is 1 or `N`.
  *
+ * For multi-dimensional extents, each dimension of `input` must be 1 or equal to the corresponding dimension of the
+ * new size, where missing leading dimensions are treated as 1.
+ *
  * Example
  * =======
  * ```
@@ -743,16 +1013,40 @@ struct broadcast_impl<T, extent<1>, extent<1>> {
  *
  * vec<float, 5> b = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
  * vec<float, 5> y = broadcast<5>(b);  // Returns [1.0f, 2.0f, 3.0f, 4.0f, 5.0f]
+ *
+ * vector<float, extent<2, 1>> c = {1.0f, 2.0f};
+ * vector<float, extent<2, 3>> z = broadcast<2, 3>(c);  // Returns [[1.0f, 1.0f, 1.0f], [2.0f, 2.0f, 2.0f]]
  * ```
  */
-template<size_t N, typename V>
-KERNEL_FLOAT_INLINE vector<vector_value_type<V>, extent<N>>
-broadcast(const V& input, extent<N> new_size = {}) {
+template<size_t... Ns, typename V>
+KERNEL_FLOAT_INLINE vector<vector_value_type<V>, extent<Ns...>>
+broadcast(const V& input, extent<Ns...> new_size = {}) {
     using T = vector_value_type<V>;
-    return detail::broadcast_impl<T, vector_extent_type<V>, extent<N>>::call(
+    return detail::broadcast_impl<T, vector_extent_type<V>, extent<Ns...>>::call(
         into_vector_storage(input));
 }
 
+/**
+ * Returns the elements of `input` as a vector of the given (possibly multi-dimensional) extent `extent<Ns...>`. The
+ * number of elements must be the same. The elements are not moved, only the shape of the vector changes.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 6> a = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+ * vector<float, extent<2, 3>> m = reshape<2, 3>(a);  // Returns [[1.0f, 2.0f, 3.0f], [4.0f, 5.0f, 6.0f]]
+ * vec<float, 6> b = reshape<6>(m);
+ * ```
+ */
+template<size_t... Ns, typename V>
+KERNEL_FLOAT_INLINE vector<vector_value_type<V>, extent<Ns...>>
+reshape(const V& input, extent<Ns...> new_size = {}) {
+    static_assert(
+        vector_extent<V> == extent<Ns...>::value,
+        "reshape cannot change the number of elements");
+    return into_vector_storage(input);
+}
+
 /**
  * Takes the given vector `input` and extends its size to the same length as vector `other`. This is only valid if the
  * size of `input` is 1 or the same as `other`.
@@ -765,7 +1059,7 @@ broadcast_like(const V& input, const R& other) {
 
 namespace detail {
 
-template<size_t N>
+template<size_t N, bool = is_unrolled(N)>
 struct apply_recur_impl;
 
 template<typename F, size_t N, typename Output, typename... Args>
@@ -775,7 +1069,7 @@ struct apply_impl {
     }
 };
 
-template<size_t N>
+template<size_t N, bool>
 struct apply_recur_impl {
     static constexpr size_t K = round_up_to_power_of_two(N) / 2;
 
@@ -786,6 +1080,23 @@ struct apply_recur_impl {
     }
 };
 
+// Large vectors are processed in chunks by a loop that is not unrolled
+template<size_t N>
+struct apply_recur_impl<N, false> {
+    static constexpr size_t K = unroll_chunk_size;
+    static constexpr size_t M = N - N % K;
+
+    template<typename F, typename Output, typename... Args>
+    KERNEL_FLOAT_INLINE static void call(F fun, Output* result, const Args*... inputs) {
+#pragma unroll 1
+        for (size_t i = 0; i < M; i += K) {
+            apply_impl<F, K, Output, Args...>::call(fun, result + i, (inputs + i)...);
+        }
+
+        apply_impl<F, N - M, Output, Args...>::call(fun, result + M, (inputs + M)...);
+    }
+};
+
 template<>
 struct apply_recur_impl<0> {
     template<typename F, typename Output, typename... Args>
@@ -804,6 +1115,100 @@ template<typename F, size_t N, typename Output, typename... Args>
 struct apply_fastmath_impl: apply_impl<F, N, Output, Args...> {};
 }  // namespace detail
 
+/**
+ * Math policy that evaluates functions using their fast (but possibly less accurate) implementation, if available.
+ * A math policy can be passed as the first argument to `map`, `zip_common`, and the named math functions (such as
+ * `exp` or `divide`) to select the implementation for that call only.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {1.0f, 2.0f, 3.0f, 4.0f};
+ * vec<float, 4> a = exp(fast_math_policy {}, x);  // Approximate, even without KERNEL_FLOAT_FAST_MATH
+ * vec<float, 4> b = divide(fast_math_policy {}, x, 3.0f);
+ * ```
+ */
+struct fast_math_policy {
+    template<typename F, size_t N, typename Output, typename... Args>
+    using apply_impl = detail::apply_fastmath_impl<F, N, Output, Args...>;
+};
+
+/**
+ * Math policy that always evaluates functions using their accurate implementation, even if `KERNEL_FLOAT_FAST_MATH`
+ * is enabled. See `fast_math_policy`.
+ */
+struct precise_policy {
+    template<typename F, size_t N, typename Output, typename... Args>
+    using apply_impl = detail::apply_impl<F, N, Output, Args...>;
+};
+
+/**
+ * The math policy used if no policy is given: `fast_math_policy` if `KERNEL_FLOAT_FAST_MATH` is enabled and
+ * `precise_policy` otherwise.
+ */
+#if KERNEL_FLOAT_FAST_MATH
+using default_policy = fast_math_policy;
+#else
+using default_policy = precise_policy;
+#endif
+
+namespace detail {
+template<typename P>
+struct is_math_policy_impl {
+    static constexpr bool value = false;
+};
+
+template<>
+struct is_math_policy_impl<fast_math_policy> {
+    static constexpr bool value = true;
+};
+
+template<>
+struct is_math_policy_impl<precise_policy> {
+    static constexpr bool value = true;
+};
+}  // namespace detail
+
+template<typename P>
+static constexpr bool is_math_policy = detail::is_math_policy_impl<decay_t<P>>::value;
+
+namespace detail {
+template<typename P, typename F, size_t N, typename Output, typename... Args>
+using policy_apply_impl = typename P::template apply_impl<F, N, Output, Args...>;
+
+template<typename F, size_t N, typename Output, typename... Args>
+using default_apply_impl = policy_apply_impl<default_policy, F, N, Output, Args...>;
+
+/**
+ * Calls the binary function `F` with the scalar `value` as its left argument. Applying this function to a vector
+ * applies `F` to a scalar and a vector without first broadcasting the scalar into a vector of `N` copies.
+ */
+template<typename F, typename T>
+struct apply_scalar_left {
+    template<typename R>
+    KERNEL_FLOAT_INLINE result_t<F, T, R> operator()(R right) {
+        return fun(value, right);
+    }
+
+    F fun;
+    T value;
+};
+
+/**
+ * Calls the binary function `F` with the scalar `value` as its right argument. See `apply_scalar_left`.
+ */
+template<typename F, typename T>
+struct apply_scalar_right {
+    template<typename L>
+    KERNEL_FLOAT_INLINE result_t<F, L, T> operator()(L left) {
+        return fun(left, value);
+    }
+
+    F fun;
+    T value;
+};
+}  // namespace detail
+
 template<typename F, typename... Args>
 using map_type =
     vector<result_t<F, vector_value_type<Args>...>, broadcast_vector_extent_type<Args...>>;
@@ -820,16 +1225,28 @@ using map_type =
  */
 template<typename F, typename... Args>
 KERNEL_FLOAT_INLINE map_type<F, Args...> map(F fun, const Args&... args) {
+    return map(default_policy {}, fun, args...);
+}
+
+/**
+ * Apply the function `F` to each element from the vector `input` using the given math policy (`fast_math_policy`
+ * or `precise_policy`) and return the results as a new vector.
+ *
+ * Examples
+ * ========
+ * ```
+ * vec<float, 4> input = {1.0f, 2.0f, 3.0f, 4.0f};
+ * vec<float, 4> output = map(fast_math_policy {}, ops::exp<float> {}, input); // Same as `fast_exp(input)`
+ * ```
+ */
+template<typename P, typename F, typename... Args, typename = enable_if_t<is_math_policy<P>>>
+KERNEL_FLOAT_INLINE map_type<F, Args...> map(P /*policy*/, F fun, const Args&... args) {
     using Output = result_t<F, vector_value_type<Args>...>;
     using E = broadcast_vector_extent_type<Args...>;
     vector_storage<Output, E::value> result;
 
-    // Use the `apply_fastmath_impl` if KERNEL_FLOAT_FAST_MATH is enabled
-#if KERNEL_FLOAT_FAST_MATH
-    using apply_impl = detail::apply_fastmath_impl<F, E::value, Output, vector_value_type<Args>...>;
-#else
-    using apply_impl = detail::apply_impl<F, E::value, Output, vector_value_type<Args>...>;
-#endif
+    using apply_impl =
+        detail::policy_apply_impl<P, F, E::value, Output, vector_value_type<Args>...>;
 
     apply_impl::call(
         fun,
@@ -847,35 +1264,92 @@ KERNEL_FLOAT_INLINE map_type<F, Args...> map(F fun, const Args&... args) {
  */
 template<typename F, typename... Args>
 KERNEL_FLOAT_INLINE map_type<F, Args...> fast_map(F fun, const Args&... args) {
-    using Output = result_t<F, vector_value_type<Args>...>;
-    using E = broadcast_vector_extent_type<Args...>;
-    vector_storage<Output, E::value> result;
-
-    detail::apply_fastmath_impl<F, E::value, Output, vector_value_type<Args>...>::call(
-        fun,
-        result.data(),
-        (detail::broadcast_impl<vector_value_type<Args>, vector_extent_type<Args>, E>::call(
-             into_vector_storage(args))
-             .data())...);
-
-    return result;
+    return map(fast_math_policy {}, fun, args...);
 }
 
-}  // namespace kernel_float
-
-#endif  // KERNEL_FLOAT_APPLY_H
-#ifndef KERNEL_FLOAT_COMPLEX_TYPE_H
-#define KERNEL_FLOAT_COMPLEX_TYPE_H
-
+namespace detail {
+template<typename F, typename T, typename E, typename... Args>
+struct map_inplace_impl {
+    KERNEL_FLOAT_INLINE static void call(F fun, T* data, const Args&... args) {
+        default_apply_impl<F, E::value, T, T, vector_value_type<Args>...>::call(
+            fun,
+            data,
+            data,
+            (broadcast_impl<vector_value_type<Args>, vector_extent_type<Args>, E>::call(
+                 into_vector_storage(args))
+                 .data())...);
+    }
+};
 
+// A single scalar argument is passed to `F` by value instead of being broadcast to a vector
+template<typename F, typename T, typename E, typename A>
+struct map_inplace_impl<F, T, E, A> {
+    using value_type = vector_value_type<A>;
 
+    KERNEL_FLOAT_INLINE static void call(F fun, T* data, const A& arg) {
+        call(fun, data, into_vector_storage(arg), vector_extent_type<A> {});
+    }
 
-namespace kernel_float {
+  private:
+    template<typename AE>
+    KERNEL_FLOAT_INLINE static void
+    call(F fun, T* data, const vector_storage<value_type, AE::value>& arg, AE) {
+        default_apply_impl<F, E::value, T, T, value_type>::call(
+            fun,
+            data,
+            data,
+            broadcast_impl<value_type, AE, E>::call(arg).data());
+    }
 
-template<typename T>
-struct alignas(2 * alignof(T)) complex_type_storage {
-    T re;
-    T im;
+    KERNEL_FLOAT_INLINE static void
+    call(F fun, T* data, const vector_storage<value_type, 1>& arg, extent<1>) {
+        default_apply_impl<apply_scalar_right<F, value_type>, E::value, T, T>::call(
+            {fun, arg.data()[0]},
+            data,
+            data);
+    }
+};
+}  // namespace detail
+
+/**
+ * Apply the function `F` to each element of the vector `input` (together with the corresponding elements of the
+ * optional `args`) and write the results back into `input`. Unlike `map`, this does not create a new vector, which
+ * avoids keeping both the input and the output alive for large vectors. The `args` are broadcast to the extent of
+ * `input` and the results of `F` are converted to the element type of `input`.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {1.0f, 2.0f, 3.0f, 4.0f};
+ * map_inplace([](float a) { return a * a; }, x);  // x is now [1.0f, 4.0f, 9.0f, 16.0f]
+ * map_inplace([](float a, float b) { return a - b; }, x, 1.0f);  // x is now [0.0f, 3.0f, 8.0f, 15.0f]
+ * ```
+ */
+template<typename F, typename T, typename E, typename... Args>
+KERNEL_FLOAT_INLINE vector<T, E>& map_inplace(F fun, vector<T, E>& input, const Args&... args) {
+    static_assert(
+        is_same_type<broadcast_extent<E, vector_extent_type<Args>...>, E>,
+        "the arguments cannot be broadcast to the extent of the input vector");
+
+    detail::map_inplace_impl<F, T, E, Args...>::call(fun, input.data(), args...);
+    return input;
+}
+
+}  // namespace kernel_float
+
+#endif  // KERNEL_FLOAT_APPLY_H
+#ifndef KERNEL_FLOAT_COMPLEX_TYPE_H
+#define KERNEL_FLOAT_COMPLEX_TYPE_H
+
+
+
+
+namespace kernel_float {
+
+template<typename T>
+struct alignas(2 * alignof(T)) complex_type_storage {
+    T re;
+    T im;
 };
 
 template<typename T>
@@ -1126,6 +1600,20 @@ namespace ops {
 
 template<typename T, typename R, RoundingMode m = RoundingMode::ANY, typename = void>
 struct cast;
+}  // namespace ops
+
+namespace detail {
+template<typename T, typename R, RoundingMode m, typename = void>
+struct cast_rounding;
+}
+
+namespace ops {
+template<typename T, typename R, RoundingMode m, typename>
+struct cast {
+    KERNEL_FLOAT_INLINE R operator()(T input) noexcept {
+        return detail::cast_rounding<T, R, m>::call(input);
+    }
+};
 
 template<typename T, RoundingMode m>
 struct cast<T, T, m> {
@@ -1177,6 +1665,242 @@ struct cast<T, R, RoundingMode::ANY> {
 
 }  // namespace ops
 
+namespace detail {
+/**
+ * Describes a floating-point type for conversions that must round in a specific `RoundingMode`. Specializations
+ * give the number of significand bits and how to step to the next representable value.
+ */
+template<typename T>
+struct rounding_traits {
+    static constexpr bool value = false;
+};
+
+template<>
+struct rounding_traits<float> {
+    static constexpr bool value = true;
+    static constexpr int digits = 24;
+
+    KERNEL_FLOAT_INLINE static float next_up(float input) {
+        return ::nextafterf(input, HUGE_VALF);
+    }
+
+    KERNEL_FLOAT_INLINE static float next_down(float input) {
+        return ::nextafterf(input, -HUGE_VALF);
+    }
+};
+
+template<>
+struct rounding_traits<double> {
+    static constexpr bool value = true;
+    static constexpr int digits = 53;
+
+    KERNEL_FLOAT_INLINE static double next_up(double input) {
+        return ::nextafter(input, HUGE_VAL);
+    }
+
+    KERNEL_FLOAT_INLINE static double next_down(double input) {
+        return ::nextafter(input, -HUGE_VAL);
+    }
+};
+
+// Steps the bit pattern of a sign-magnitude floating-point value to the next representable value.
+template<typename U>
+KERNEL_FLOAT_INLINE U next_float_bits(U bits, U sign_mask, bool up) {
+    if ((bits & U(~sign_mask)) == 0) {
+        return up ? U(1) : U(sign_mask | 1);
+    }
+
+    bool negative = (bits & sign_mask) != 0;
+    return negative == up ? U(bits - 1) : U(bits + 1);
+}
+
+template<typename T>
+static constexpr bool is_rounding_float =
+    rounding_traits<T>::value || allow_float_fallback<T>::value;
+
+template<RoundingMode M>
+KERNEL_FLOAT_INLINE float round_to_integral(float input) {
+    switch (M) {
+        case RoundingMode::DOWN:
+            return ::floorf(input);
+        case RoundingMode::UP:
+            return ::ceilf(input);
+        case RoundingMode::TOWARD_ZERO:
+            return ::truncf(input);
+        default: {
+            // Round half to even without depending on the floating-point environment.
+            float result = ::floorf(input);
+            float diff = input - result;
+            bool odd = ::fmodf(result, 2.0f) != 0.0f;
+            return diff > 0.5f || (diff == 0.5f && odd) ? result + 1.0f : result;
+        }
+    }
+}
+
+template<RoundingMode M>
+KERNEL_FLOAT_INLINE double round_to_integral(double input) {
+    switch (M) {
+        case RoundingMode::DOWN:
+            return ::floor(input);
+        case RoundingMode::UP:
+            return ::ceil(input);
+        case RoundingMode::TOWARD_ZERO:
+            return ::trunc(input);
+        default: {
+            double result = ::floor(input);
+            double diff = input - result;
+            bool odd = ::fmod(result, 2.0) != 0.0;
+            return diff > 0.5 || (diff == 0.5 && odd) ? result + 1.0 : result;
+        }
+    }
+}
+
+/**
+ * Rounds the integer `input` to `Digits` significant bits using rounding mode `M`. The result is returned as a
+ * `double`, which represents it exactly.
+ */
+template<int Digits, RoundingMode M, typename T>
+KERNEL_FLOAT_INLINE double round_integer_to_digits(T input) {
+    bool negative = input < T(0);
+    unsigned long long magnitude = (unsigned long long)(input);
+    magnitude = negative ? 0ULL - magnitude : magnitude;
+
+    int shift = 0;
+    while ((magnitude >> shift) >= (1ULL << Digits)) {
+        shift++;
+    }
+
+    unsigned long long result = magnitude >> shift;
+
+    if (shift > 0) {
+        unsigned long long remainder = magnitude & ((1ULL << shift) - 1);
+        unsigned long long half = 1ULL << (shift - 1);
+        bool inexact = remainder != 0;
+        bool round_up;
+
+        switch (M) {
+            case RoundingMode::DOWN:
+                round_up = negative && inexact;
+                break;
+            case RoundingMode::UP:
+                round_up = !negative && inexact;
+                break;
+            case RoundingMode::TOWARD_ZERO:
+                round_up = false;
+                break;
+            default:
+                round_up = remainder > half || (remainder == half && (result & 1));
+                break;
+        }
+
+        result += round_up ? 1 : 0;
+    }
+
+    double value = double(result) * double(1ULL << shift);
+    return negative ? -value : value;
+}
+
+// Integer to integer: the rounding mode is irrelevant.
+template<typename T, typename R, RoundingMode M>
+struct cast_rounding<T, R, M, enable_if_t<!is_rounding_float<T> && !is_rounding_float<R>>> {
+    KERNEL_FLOAT_INLINE static R call(T input) {
+        return ops::cast<T, R> {}(input);
+    }
+};
+
+// Floating-point to integer: round to an integral value first, after which the conversion is exact.
+template<typename T, typename R, RoundingMode M>
+struct cast_rounding<
+    T,
+    R,
+    M,
+    enable_if_t<allow_float_fallback<T>::value && !is_rounding_float<R>>> {
+    KERNEL_FLOAT_INLINE static R call(T input) {
+        float value = round_to_integral<M>(ops::cast<T, float> {}(input));
+        return ops::cast<float, R> {}(value);
+    }
+};
+
+template<typename R, RoundingMode M>
+struct cast_rounding<double, R, M, enable_if_t<!is_rounding_float<R>>> {
+    KERNEL_FLOAT_INLINE static R call(double input) {
+        return ops::cast<double, R> {}(round_to_integral<M>(input));
+    }
+};
+
+// Integer to floating-point: round to the precision of `R`, after which the conversion is exact.
+template<typename T, typename R, RoundingMode M>
+struct cast_rounding<T, R, M, enable_if_t<!is_rounding_float<T> && rounding_traits<R>::value>> {
+    KERNEL_FLOAT_INLINE static R call(T input) {
+        double value = round_integer_to_digits<rounding_traits<R>::digits, M>(input);
+        return cast_rounding<double, R, M>::call(value);
+    }
+};
+
+template<RoundingMode M>
+struct cast_rounding<double, double, M> {
+    KERNEL_FLOAT_INLINE static double call(double input) {
+        return input;
+    }
+};
+
+/**
+ * Floating-point to floating-point: convert using the default conversion and then correct the result by at most
+ * one step. All types involved can be represented exactly by `double`, so the correction is exact.
+ */
+template<typename T, typename R, RoundingMode M>
+struct cast_rounding<T, R, M, enable_if_t<is_rounding_float<T> && rounding_traits<R>::value>> {
+    KERNEL_FLOAT_INLINE static R call(T input) {
+        using traits = rounding_traits<R>;
+        double value = ops::cast<T, double> {}(input);
+        R result = ops::cast<T, R> {}(input);
+        double approx = ops::cast<R, double> {}(result);
+
+        // Exact result or NaN
+        if (approx == value || value != value) {
+            return result;
+        }
+
+        R lo = approx < value ? result : traits::next_down(result);
+        R hi = approx < value ? traits::next_up(result) : result;
+
+        switch (M) {
+            case RoundingMode::DOWN:
+                return lo;
+            case RoundingMode::UP:
+                return hi;
+            case RoundingMode::TOWARD_ZERO:
+                return value < 0 ? hi : lo;
+            default:
+                break;
+        }
+
+        // Infinity is treated as if it were the next value after the largest finite value.
+        double lo_value = ops::cast<R, double> {}(lo);
+        double hi_value = ops::cast<R, double> {}(hi);
+
+        if (::isinf(hi_value)) {
+            hi_value = 2 * lo_value - ops::cast<R, double> {}(traits::next_down(lo));
+        }
+
+        if (::isinf(lo_value)) {
+            lo_value = 2 * hi_value - ops::cast<R, double> {}(traits::next_up(hi));
+        }
+
+        if (value - lo_value != hi_value - value) {
+            return value - lo_value < hi_value - value ? lo : hi;
+        }
+
+        // Tie: pick the value with an even significand. The value with the smallest magnitude is a
+        // multiple of the distance between `lo` and `hi`.
+        bool lo_smallest = ::fabs(lo_value) < ::fabs(hi_value);
+        double smallest = lo_smallest ? lo_value : hi_value;
+        bool smallest_even = ::fmod(smallest / (hi_value - lo_value), 2.0) == 0.0;
+        return lo_smallest == smallest_even ? lo : hi;
+    }
+};
+}  // namespace detail
+
 /**
  * Cast the elements of the given vector `input` to a different type `R`.
  *
@@ -1204,6 +1928,13 @@ KERNEL_FLOAT_INLINE vector<R, vector_extent_type<V>> cast(const V& input) {
     KERNEL_FLOAT_INLINE vector<vector_value_type<V>, vector_extent_type<V>> NAME(const V& input) { \
         using F = ops::NAME<vector_value_type<V>>;                                                 \
         return map(F {}, input);                                                                   \
+    }                                                                                              \
+    template<typename P, typename V, typename = enable_if_t<is_math_policy<P>>>                    \
+    KERNEL_FLOAT_INLINE vector<vector_value_type<V>, vector_extent_type<V>> NAME(                  \
+        P policy,                                                                                  \
+        const V& input) {                                                                          \
+        using F = ops::NAME<vector_value_type<V>>;                                                 \
+        return map(policy, F {}, input);                                                           \
     }
 
 #define KERNEL_FLOAT_DEFINE_UNARY(NAME, EXPR)       \
@@ -1492,6 +2223,74 @@ KERNEL_FLOAT_INLINE AssignConversionProxy<T, M> cast_to(T& input) {
     return AssignConversionProxy<T, M>(&input);
 }
 
+namespace detail {
+/**
+ * Counter-based generator of random bits: returns a hash of `seed` and `counter` (using the finalizer of
+ * MurmurHash3). Different counters give statistically independent bits, without requiring any state.
+ */
+KERNEL_FLOAT_INLINE unsigned int random_bits(unsigned int seed, unsigned int counter) {
+    unsigned int x = seed + (counter + 1) * 0x9E3779B9u;
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+}
+}  // namespace detail
+
+namespace ops {
+template<typename T, typename R>
+struct cast_stochastic {
+    KERNEL_FLOAT_INLINE R operator()(T input, unsigned int bits) {
+        using W = widest_promote_t<float, T>;
+        R lo = cast<T, R, RoundingMode::DOWN> {}(input);
+        R hi = cast<T, R, RoundingMode::UP> {}(input);
+
+        W x = cast<T, W> {}(input);
+        W lo_value = cast<R, W> {}(lo);
+        W hi_value = cast<R, W> {}(hi);
+
+        // Round up with a probability equal to the relative distance between `lo` and `x`. Uses 24 random bits.
+        W u = W(bits >> 8) * W(1.0 / 16777216.0);
+        return x - lo_value > u * (hi_value - lo_value) ? hi : lo;
+    }
+};
+}  // namespace ops
+
+/**
+ * Cast the elements of the given vector `input` to type `R` using stochastic rounding. Each element is rounded
+ * up or down with a probability proportional to its distance to those two values, meaning that the result is
+ * unbiased on average, unlike rounding to nearest.
+ *
+ * The random bits are a counter-based hash of `seed` and the index of each element, thus the result is
+ * deterministic for a given `seed`. Use a different `seed` for each call, for example, by combining the thread
+ * index and the iteration number.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 2> input = {1.0f, 1.0002f};
+ * vec<half, 2> result = cast_stochastic<half>(input, seed); // [1.0, 1.0 or 1.000977]
+ * ```
+ */
+template<typename R, typename V>
+KERNEL_FLOAT_INLINE vector<R, vector_extent_type<V>>
+cast_stochastic(const V& input, unsigned int seed) {
+    using E = vector_extent_type<V>;
+    vector_storage<unsigned int, E::value> bits;
+
+#pragma unroll
+    for (size_t i = 0; i < E::value; i++) {
+        bits.data()[i] = detail::random_bits(seed, (unsigned int)i);
+    }
+
+    return map(
+        ops::cast_stochastic<vector_value_type<V>, R> {},
+        input,
+        vector<unsigned int, E>(bits));
+}
+
 /**
  * Returns a vector containing `N` copies of `value`.
  *
@@ -1582,6 +2381,76 @@ KERNEL_FLOAT_INLINE vector<T, E> ones_like(const V& = {}) {
     return ones<T>(E {});
 }
 
+namespace detail {
+template<typename T, typename I>
+struct shuffle_impl;
+
+template<typename T, size_t... Is>
+struct shuffle_impl<T, index_sequence<Is...>> {
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static vector_storage<T, sizeof...(Is)>
+    call(const vector_storage<T, N>& input) {
+        static_assert(((Is < N) && ...), "shuffle index out of range");
+        return {input.data()[Is]...};
+    }
+};
+}  // namespace detail
+
+/**
+ * Returns a new vector where element `i` is element `Is[i]` of ``input``. The indices are compile-time constants,
+ * so the elements are simply renamed without any copying at runtime or bounds checks. Indices can be repeated and
+ * the result can have a different length than ``input``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {0.0f, 1.0f, 2.0f, 3.0f};
+ * vec<float, 4> a = shuffle<3, 2, 1, 0>(x);  // Returns [3.0f, 2.0f, 1.0f, 0.0f]
+ * vec<float, 2> b = shuffle<1, 1>(x);  // Returns [1.0f, 1.0f]
+ * ```
+ */
+template<size_t... Is, typename V>
+KERNEL_FLOAT_INLINE vector<vector_value_type<V>, extent<sizeof...(Is)>> shuffle(const V& input) {
+    static_assert(sizeof...(Is) > 0, "shuffle requires at least one index");
+    using T = vector_value_type<V>;
+    return detail::shuffle_impl<T, index_sequence<Is...>>::call(into_vector_storage(input));
+}
+
+/**
+ * Returns a new vector where element `i` is element `Is[i]` of the concatenation of ``left`` and ``right``. Thus,
+ * indices smaller than the length of ``left`` refer to ``left`` and other indices refer to ``right``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 2> x = {0.0f, 1.0f};
+ * vec<float, 2> y = {2.0f, 3.0f};
+ * vec<float, 4> z = shuffle<0, 2, 1, 3>(x, y);  // Returns [0.0f, 2.0f, 1.0f, 3.0f]
+ * ```
+ */
+template<size_t... Is, typename L, typename R, typename T = promoted_vector_value_type<L, R>>
+KERNEL_FLOAT_INLINE vector<T, extent<sizeof...(Is)>> shuffle(const L& left, const R& right) {
+    static_assert(sizeof...(Is) > 0, "shuffle requires at least one index");
+    static constexpr size_t NL = vector_extent<L>;
+    static constexpr size_t NR = vector_extent<R>;
+
+    vector_storage<T, NL> a = convert_storage<T, NL>(left);
+    vector_storage<T, NR> b = convert_storage<T, NR>(right);
+    vector_storage<T, NL + NR> items;
+
+#pragma unroll
+    for (size_t i = 0; i < NL; i++) {
+        items.data()[i] = a.data()[i];
+    }
+
+#pragma unroll
+    for (size_t i = 0; i < NR; i++) {
+        items.data()[NL + i] = b.data()[i];
+    }
+
+    return detail::shuffle_impl<T, index_sequence<Is...>>::call(items);
+}
+
 }  // namespace kernel_float
 
 #endif
@@ -1618,6 +2487,84 @@ using zip_common_type = vector<
     result_t<F, promoted_vector_value_type<L, R>, promoted_vector_value_type<L, R>>,
     broadcast_vector_extent_type<L, R>>;
 
+namespace detail {
+template<typename P, typename F, typename T, typename O, typename E, typename LE, typename RE>
+struct zip_common_impl {
+    template<typename L, typename R>
+    KERNEL_FLOAT_INLINE static vector_storage<O, E::value>
+    call(F fun, const L& left, const R& right) {
+        vector_storage<O, E::value> result;
+
+        policy_apply_impl<P, F, E::value, O, T, T>::call(
+            fun,
+            result.data(),
+            convert_impl<vector_value_type<L>, LE, T, E>::call(into_vector_storage(left)).data(),
+            convert_impl<vector_value_type<R>, RE, T, E>::call(into_vector_storage(right)).data());
+
+        return result;
+    }
+};
+
+// If the left operand is a scalar, it is passed to `F` by value instead of being broadcast to a vector
+template<typename P, typename F, typename T, typename O, typename E, typename RE>
+struct zip_common_impl<P, F, T, O, E, extent<1>, RE> {
+    template<typename L, typename R>
+    KERNEL_FLOAT_INLINE static vector_storage<O, E::value>
+    call(F fun, const L& left, const R& right) {
+        vector_storage<O, E::value> result;
+        T value = convert_impl<vector_value_type<L>, extent<1>, T, extent<1>>::call(
+                      into_vector_storage(left))
+                      .data()[0];
+
+        policy_apply_impl<P, apply_scalar_left<F, T>, E::value, O, T>::call(
+            {fun, value},
+            result.data(),
+            convert_impl<vector_value_type<R>, RE, T, E>::call(into_vector_storage(right)).data());
+
+        return result;
+    }
+};
+
+// If the right operand is a scalar, it is passed to `F` by value instead of being broadcast to a vector
+template<typename P, typename F, typename T, typename O, typename E, typename LE>
+struct zip_common_impl<P, F, T, O, E, LE, extent<1>> {
+    template<typename L, typename R>
+    KERNEL_FLOAT_INLINE static vector_storage<O, E::value>
+    call(F fun, const L& left, const R& right) {
+        vector_storage<O, E::value> result;
+        T value = convert_impl<vector_value_type<R>, extent<1>, T, extent<1>>::call(
+                      into_vector_storage(right))
+                      .data()[0];
+
+        policy_apply_impl<P, apply_scalar_right<F, T>, E::value, O, T>::call(
+            {fun, value},
+            result.data(),
+            convert_impl<vector_value_type<L>, LE, T, E>::call(into_vector_storage(left)).data());
+
+        return result;
+    }
+};
+
+template<typename P, typename F, typename T, typename O, typename E>
+struct zip_common_impl<P, F, T, O, E, extent<1>, extent<1>> {
+    template<typename L, typename R>
+    KERNEL_FLOAT_INLINE static vector_storage<O, E::value>
+    call(F fun, const L& left, const R& right) {
+        vector_storage<O, E::value> result;
+
+        policy_apply_impl<P, F, E::value, O, T, T>::call(
+            fun,
+            result.data(),
+            convert_impl<vector_value_type<L>, extent<1>, T, E>::call(into_vector_storage(left))
+                .data(),
+            convert_impl<vector_value_type<R>, extent<1>, T, E>::call(into_vector_storage(right))
+                .data());
+
+        return result;
+    }
+};
+}  // namespace detail
+
 /**
  * Combines the elements from the two inputs (`left` and `right`)  element-wise, applying a provided binary
  * function (`fun`) to each pair of corresponding elements. The elements are promoted to a common type before applying
@@ -1633,36 +2580,43 @@ using zip_common_type = vector<
  */
 template<typename F, typename L, typename R>
 KERNEL_FLOAT_INLINE zip_common_type<F, L, R> zip_common(F fun, const L& left, const R& right) {
+    return zip_common(default_policy {}, fun, left, right);
+}
+
+/**
+ * Same as `zip_common(fun, left, right)`, but uses the given math policy (`fast_math_policy` or `precise_policy`)
+ * to apply `fun`.
+ */
+template<typename P, typename F, typename L, typename R, typename = enable_if_t<is_math_policy<P>>>
+KERNEL_FLOAT_INLINE zip_common_type<F, L, R>
+zip_common(P /*policy*/, F fun, const L& left, const R& right) {
     using T = promoted_vector_value_type<L, R>;
     using O = result_t<F, T, T>;
     using E = broadcast_vector_extent_type<L, R>;
+    using LE = vector_extent_type<L>;
+    using RE = vector_extent_type<R>;
 
-    vector_storage<O, E::value> result;
-
-// Use the `apply_fastmath_impl` if KERNEL_FLOAT_FAST_MATH is enabled
-#if KERNEL_FLOAT_FAST_MATH
-    using apply_impl = detail::apply_fastmath_impl<F, E::value, O, T, T>;
-#else
-    using apply_impl = detail::apply_impl<F, E::value, O, T, T>;
-#endif
-
-    apply_impl::call(
-        fun,
-        result.data(),
-        detail::convert_impl<vector_value_type<L>, vector_extent_type<L>, T, E>::call(
-            into_vector_storage(left))
-            .data(),
-        detail::convert_impl<vector_value_type<R>, vector_extent_type<R>, T, E>::call(
-            into_vector_storage(right))
-            .data());
-
-    return result;
+    return detail::zip_common_impl<P, F, T, O, E, LE, RE>::call(fun, left, right);
 }
 
 #define KERNEL_FLOAT_DEFINE_BINARY_FUN(NAME)                                               \
     template<typename L, typename R, typename C = promoted_vector_value_type<L, R>>        \
     KERNEL_FLOAT_INLINE zip_common_type<ops::NAME<C>, L, R> NAME(L&& left, R&& right) {    \
         return zip_common(ops::NAME<C> {}, std::forward<L>(left), std::forward<R>(right)); \
+    }                                                                                      \
+    template<                                                                              \
+        typename P,                                                                        \
+        typename L,                                                                        \
+        typename R,                                                                        \
+        typename C = promoted_vector_value_type<L, R>,                                     \
+        typename = enable_if_t<is_math_policy<P>>>                                         \
+    KERNEL_FLOAT_INLINE zip_common_type<ops::NAME<C>, L, R>                                \
+    NAME(P policy, L&& left, R&& right) {                                                  \
+        return zip_common(                                                                 \
+            policy,                                                                        \
+            ops::NAME<C> {},                                                               \
+            std::forward<L>(left),                                                         \
+            std::forward<R>(right));                                                       \
     }
 
 #define KERNEL_FLOAT_DEFINE_BINARY(NAME, EXPR, EXPR_F64, EXPR_F32)         \
@@ -1759,8 +2713,11 @@ static constexpr bool is_vector_assign_allowed =
         typename = enable_if_t<is_vector_assign_allowed<ops::NAME, T, E, R>>>        \
     KERNEL_FLOAT_INLINE vector<T, E>& operator OP(vector<T, E>& lhs, const R& rhs) { \
         using F = ops::NAME<T>;                                                      \
-        lhs = zip_common(F {}, lhs, rhs);                                            \
-        return lhs;                                                                  \
+        using RT = vector_value_type<R>;                                             \
+        using RE = vector_extent_type<R>;                                            \
+        vector<T, RE> right =                                                        \
+            detail::convert_impl<RT, RE, T, RE>::call(into_vector_storage(rhs));     \
+        return map_inplace(F {}, lhs, right);                                        \
     }
 
 KERNEL_FLOAT_DEFINE_BINARY_ASSIGN_OP(add, +=)
@@ -1884,17 +2841,47 @@ struct multiply<bool> {
 };  // namespace ops
 
 namespace detail {
+// Only floating-point division can be replaced by a multiplication with the reciprocal
+template<typename T, size_t N, bool = is_promoted_float<T>::value>
+struct fast_divide_impl: apply_impl<ops::divide<T>, N, T, T, T> {};
+
 template<typename T, size_t N>
-struct apply_fastmath_impl<ops::divide<T>, N, T, T, T> {
+struct fast_divide_impl<T, N, true> {
     KERNEL_FLOAT_INLINE static void
     call(ops::divide<T> fun, T* result, const T* lhs, const T* rhs) {
         T rhs_rcp[N];
 
-        apply_fastmath_impl<ops::rcp<T>, N, T, T, T>::call({}, rhs_rcp, rhs);
+        // Fast way to perform division is to multiply by the reciprocal
+        apply_fastmath_impl<ops::rcp<T>, N, T, T>::call({}, rhs_rcp, rhs);
         apply_fastmath_impl<ops::multiply<T>, N, T, T, T>::call({}, result, lhs, rhs_rcp);
     }
 };
 
+template<typename T, size_t N>
+struct apply_fastmath_impl<ops::divide<T>, N, T, T, T>: fast_divide_impl<T, N> {};
+
+template<typename T, size_t N, bool = is_promoted_float<T>::value>
+struct fast_divide_scalar_impl: apply_impl<apply_scalar_right<ops::divide<T>, T>, N, T, T> {};
+
+template<typename T, size_t N>
+struct fast_divide_scalar_impl<T, N, true> {
+    KERNEL_FLOAT_INLINE static void
+    call(apply_scalar_right<ops::divide<T>, T> fun, T* result, const T* lhs) {
+        T rhs_rcp;
+
+        // Division by a scalar only requires a single reciprocal
+        apply_fastmath_impl<ops::rcp<T>, 1, T, T>::call({}, &rhs_rcp, &fun.value);
+        apply_fastmath_impl<apply_scalar_right<ops::multiply<T>, T>, N, T, T>::call(
+            {{}, rhs_rcp},
+            result,
+            lhs);
+    }
+};
+
+template<typename T, size_t N>
+struct apply_fastmath_impl<apply_scalar_right<ops::divide<T>, T>, N, T, T>:
+    fast_divide_scalar_impl<T, N> {};
+
 #if KERNEL_FLOAT_IS_DEVICE
 template<size_t N>
 struct apply_fastmath_impl<ops::divide<float>, N, float, float, float> {
@@ -1906,6 +2893,17 @@ struct apply_fastmath_impl<ops::divide<float>, N, float, float, float> {
         }
     }
 };
+
+template<size_t N>
+struct apply_fastmath_impl<apply_scalar_right<ops::divide<float>, float>, N, float, float> {
+    KERNEL_FLOAT_INLINE static void
+    call(apply_scalar_right<ops::divide<float>, float> fun, float* result, const float* lhs) {
+#pragma unroll
+        for (size_t i = 0; i < N; i++) {
+            result[i] = __fdividef(lhs[i], fun.value);
+        }
+    }
+};
 #endif
 }  // namespace detail
 
@@ -1934,16 +2932,10 @@ struct cross_impl {
     KERNEL_FLOAT_INLINE
     static vector<T, extent<3>>
     call(const vector_storage<T, 3>& av, const vector_storage<T, 3>& bv) {
-        auto a = av.data();
-        auto b = bv.data();
-        vector<T, extent<6>> v0 = {a[1], a[2], a[0], a[2], a[0], a[1]};
-        vector<T, extent<6>> v1 = {b[2], b[0], b[1], b[1], b[2], b[0]};
+        vector<T, extent<6>> v0 = shuffle<1, 2, 0, 2, 0, 1>(av);
+        vector<T, extent<6>> v1 = shuffle<2, 0, 1, 1, 2, 0>(bv);
         vector<T, extent<6>> rv = v0 * v1;
-
-        auto r = rv.data();
-        vector<T, extent<3>> r0 = {r[0], r[1], r[2]};
-        vector<T, extent<3>> r1 = {r[3], r[4], r[5]};
-        return r0 - r1;
+        return shuffle<0, 1, 2>(rv) - shuffle<3, 4, 5>(rv);
     }
 };
 };  // namespace detail
@@ -2115,6 +3107,7 @@ KERNEL_FLOAT_CONSTANT_DEFINE_OP(%)
 
 
 
+
 namespace kernel_float {
 
 /**
@@ -2424,11 +3417,1239 @@ KERNEL_FLOAT_INLINE select_type<V, Is...> select(const V& input, const Is&... in
     return outputs;
 }
 
-}  // namespace kernel_float
-
-#endif
-#ifndef KERNEL_FLOAT_MEMORY_H
-#define KERNEL_FLOAT_MEMORY_H
+namespace detail {
+template<typename T, size_t K, size_t N, typename I>
+struct lookup_impl {
+    KERNEL_FLOAT_INLINE static void call(T* output, const T* table, const I* indices) {
+#pragma unroll
+        for (size_t i = 0; i < N; i++) {
+            // The remainder is computed in the type of the index, such that negative indices wrap around as well
+            I remainder = I(indices[i] % I(K));
+            size_t index = size_t(remainder < I(0) ? remainder + I(K) : remainder);
+
+#if KERNEL_FLOAT_IS_DEVICE
+            // Indexing into a register array with a runtime index forces the array into local memory. Instead,
+            // the entry is selected using a chain of comparisons, which keeps the table in registers.
+            T result = table[0];
+
+#pragma unroll
+            for (size_t j = 1; j < K; j++) {
+                result = index == j ? table[j] : result;
+            }
+
+            output[i] = result;
+#else
+            output[i] = table[index];
+#endif
+        }
+    }
+};
+}  // namespace detail
+
+/**
+ * Returns a vector where element ``i`` is ``table[indices[i]]``. The ``table`` is a small vector (for example, an
+ * activation function or a decoding table of up to 32 entries) that is kept in registers. The indices are taken
+ * modulo the size of the table (where ``-1`` is the last entry), thus the lookup is never out of bounds.
+ *
+ * On the device, every lookup is performed by comparing the index against all entries of the table, which avoids
+ * spilling the table to local memory. This is efficient for small tables only.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> table = {0.0f, 0.5f, 1.0f, 1.5f};
+ * vec<int, 3> indices = {3, 0, 1};
+ * vec<float, 3> x = lookup(table, indices);  // Returns [1.5f, 0.0f, 0.5f]
+ * ```
+ */
+template<typename V, typename I>
+KERNEL_FLOAT_INLINE vector<vector_value_type<V>, vector_extent_type<I>>
+lookup(const V& table, const I& indices) {
+    using T = vector_value_type<V>;
+    static constexpr size_t K = vector_extent<V>;
+    static constexpr size_t N = vector_extent<I>;
+
+    vector_storage<T, N> result;
+    detail::lookup_impl<T, K, N, vector_value_type<I>>::call(
+        result.data(),
+        into_vector_storage(table).data(),
+        into_vector_storage(indices).data());
+    return result;
+}
+
+/**
+ * Permutes the elements of ``input`` according to ``indices``, which must be a vector of the same length. Element
+ * ``i`` of the result is ``input[indices[i]]``. Contrary to `select`, the indices are not bounds checked but taken
+ * modulo the length of ``input``. Use `shuffle` if the indices are known at compile time.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {10.0f, 20.0f, 30.0f, 40.0f};
+ * vec<int, 4> indices = {3, 2, 1, 0};
+ * vec<float, 4> y = permute(x, indices);  // Returns [40.0f, 30.0f, 20.0f, 10.0f]
+ * ```
+ */
+template<typename V, typename I>
+KERNEL_FLOAT_INLINE into_vector_type<V> permute(const V& input, const I& indices) {
+    static_assert(
+        vector_extent<V> == vector_extent<I>,
+        "the number of indices must equal the length of the input");
+    return lookup(input, indices);
+}
+
+namespace detail {
+template<size_t M, typename Map, typename = make_index_sequence<M>>
+struct index_map_sequence;
+
+template<size_t M, typename Map, size_t... Is>
+struct index_map_sequence<M, Map, index_sequence<Is...>> {
+    using type = index_sequence<Map::call(Is)...>;
+};
+
+/**
+ * Returns the `shuffle` of ``input`` where element `i` of the result is element `Map::call(i)` of ``input``.
+ */
+template<size_t M, typename Map, typename T, size_t N>
+KERNEL_FLOAT_INLINE vector_storage<T, M> shuffle_map(const vector_storage<T, N>& input) {
+    return shuffle_impl<T, typename index_map_sequence<M, Map>::type>::call(input);
+}
+
+template<size_t Offset, size_t Stride = 1>
+struct strided_index_map {
+    KERNEL_FLOAT_INLINE static constexpr size_t call(size_t i) {
+        return Offset + i * Stride;
+    }
+};
+
+template<size_t Offset, size_t N>
+struct rotate_index_map {
+    KERNEL_FLOAT_INLINE static constexpr size_t call(size_t i) {
+        return (i + Offset) % N;
+    }
+};
+
+template<size_t N>
+struct reverse_index_map {
+    KERNEL_FLOAT_INLINE static constexpr size_t call(size_t i) {
+        return N - 1 - i;
+    }
+};
+
+template<size_t N>
+struct interleave_index_map {
+    KERNEL_FLOAT_INLINE static constexpr size_t call(size_t i) {
+        return (i % 2) * N + i / 2;
+    }
+};
+}  // namespace detail
+
+/**
+ * Returns the elements of ``input`` at the positions ``Begin, Begin + 1, ..., End - 1``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 5> x = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f};
+ * vec<float, 3> y = slice<1, 4>(x);  // Returns [1.0f, 2.0f, 3.0f]
+ * ```
+ */
+template<size_t Begin, size_t End, typename V>
+KERNEL_FLOAT_INLINE vector<vector_value_type<V>, extent<End - Begin>> slice(const V& input) {
+    static_assert(Begin <= End && End <= vector_extent<V>, "invalid slice range");
+    return detail::shuffle_map<End - Begin, detail::strided_index_map<Begin>>(
+        into_vector_storage(input));
+}
+
+/**
+ * Splits ``input`` into `K` consecutive parts of equal length. The result is a vector of `K` vectors, which can be
+ * combined again using `flatten`.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {0.0f, 1.0f, 2.0f, 3.0f};
+ * vec<vec<float, 2>, 2> halves = split<2>(x);  // Returns [[0.0f, 1.0f], [2.0f, 3.0f]]
+ * vec<float, 2> lo = halves[0];
+ * ```
+ */
+template<size_t K, typename V>
+KERNEL_FLOAT_INLINE vector<vector<vector_value_type<V>, extent<vector_extent<V> / K>>, extent<K>>
+split(const V& input) {
+    using T = vector_value_type<V>;
+    static constexpr size_t N = vector_extent<V>;
+    static_assert(K > 0 && N % K == 0, "the length of the vector must be a multiple of K");
+
+    vector_storage<T, N> items = into_vector_storage(input);
+    vector_storage<vector<T, extent<N / K>>, K> result;
+
+#pragma unroll
+    for (size_t k = 0; k < K; k++) {
+#pragma unroll
+        for (size_t i = 0; i < N / K; i++) {
+            result.data()[k][i] = items.data()[k * (N / K) + i];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Interleaves the elements of ``left`` and ``right``, which must have the same length. This is the inverse of
+ * `deinterleave`.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 2> x = {0.0f, 2.0f};
+ * vec<float, 2> y = {1.0f, 3.0f};
+ * vec<float, 4> z = interleave(x, y);  // Returns [0.0f, 1.0f, 2.0f, 3.0f]
+ * ```
+ */
+template<typename L, typename R, typename T = promoted_vector_value_type<L, R>>
+KERNEL_FLOAT_INLINE vector<T, extent<2 * vector_extent<L>>>
+interleave(const L& left, const R& right) {
+    static constexpr size_t N = vector_extent<L>;
+    static_assert(N == vector_extent<R>, "the vectors to interleave must have the same length");
+
+    vector_storage<T, 2 * N> items;
+    vector_storage<T, N> a = convert_storage<T, N>(left);
+    vector_storage<T, N> b = convert_storage<T, N>(right);
+
+#pragma unroll
+    for (size_t i = 0; i < N; i++) {
+        items.data()[i] = a.data()[i];
+        items.data()[N + i] = b.data()[i];
+    }
+
+    return detail::shuffle_map<2 * N, detail::interleave_index_map<N>>(items);
+}
+
+/**
+ * Splits the elements of ``input`` into `K` vectors, where vector `k` contains the elements at the positions
+ * ``k, k + K, k + 2 * K, ...``. For the default `K = 2`, this returns the elements at the even and odd positions.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {0.0f, 1.0f, 2.0f, 3.0f};
+ * vec<vec<float, 2>, 2> y = deinterleave(x);  // Returns [[0.0f, 2.0f], [1.0f, 3.0f]]
+ * ```
+ */
+template<size_t K = 2, typename V>
+KERNEL_FLOAT_INLINE vector<vector<vector_value_type<V>, extent<vector_extent<V> / K>>, extent<K>>
+deinterleave(const V& input) {
+    using T = vector_value_type<V>;
+    static constexpr size_t N = vector_extent<V>;
+    static_assert(K > 0 && N % K == 0, "the length of the vector must be a multiple of K");
+
+    vector_storage<T, N> items = into_vector_storage(input);
+    vector_storage<vector<T, extent<N / K>>, K> result;
+
+#pragma unroll
+    for (size_t k = 0; k < K; k++) {
+#pragma unroll
+        for (size_t i = 0; i < N / K; i++) {
+            result.data()[k][i] = items.data()[i * K + k];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Rotates the elements of ``input`` to the left by `K` positions, such that element ``i`` of the result is element
+ * ``(i + K) % N`` of ``input``. A negative `K` rotates to the right.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {0.0f, 1.0f, 2.0f, 3.0f};
+ * vec<float, 4> y = rotate<1>(x);  // Returns [1.0f, 2.0f, 3.0f, 0.0f]
+ * vec<float, 4> z = rotate<-1>(x);  // Returns [3.0f, 0.0f, 1.0f, 2.0f]
+ * ```
+ */
+template<int K, typename V>
+KERNEL_FLOAT_INLINE into_vector_type<V> rotate(const V& input) {
+    static constexpr int N = int(vector_extent<V>);
+    static constexpr size_t offset = size_t(((K % N) + N) % N);
+    return detail::shuffle_map<N, detail::rotate_index_map<offset, N>>(
+        into_vector_storage(input));
+}
+
+/**
+ * Reverses the order of the elements of ``input``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 3> x = {0.0f, 1.0f, 2.0f};
+ * vec<float, 3> y = reverse(x);  // Returns [2.0f, 1.0f, 0.0f]
+ * ```
+ */
+template<typename V>
+KERNEL_FLOAT_INLINE into_vector_type<V> reverse(const V& input) {
+    static constexpr size_t N = vector_extent<V>;
+    return detail::shuffle_map<N, detail::reverse_index_map<N>>(into_vector_storage(input));
+}
+
+namespace detail {
+/**
+ * Generates the comparators of a sorting network of size `n` based on Batcher's odd-even merge sort and returns
+ * the number of comparators. If `n` is not a power of two, the comparators that refer to elements beyond `n` are
+ * dropped, which is equivalent to padding the input with positive infinity.
+ */
+KERNEL_FLOAT_INLINE
+constexpr size_t generate_sort_network(size_t n, size_t* lo = nullptr, size_t* hi = nullptr) {
+    size_t count = 0;
+
+    for (size_t p = 1; p < n; p += p) {
+        for (size_t k = p; k >= 1; k /= 2) {
+            for (size_t j = k % p; j + k < n; j += 2 * k) {
+                for (size_t i = 0; i < k && i + j + k < n; i++) {
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                        if (lo != nullptr && hi != nullptr) {
+                            lo[count] = i + j;
+                            hi[count] = i + j + k;
+                        }
+
+                        count++;
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Sorting network of size `N`. The comparators are generated at compile-time, thus all indices are constants
+ * after unrolling and the network contains no data-dependent control flow.
+ */
+template<size_t N>
+struct sort_network {
+    static constexpr size_t size = generate_sort_network(N);
+
+    struct comparators {
+        size_t lo[size > 0 ? size : 1] = {};
+        size_t hi[size > 0 ? size : 1] = {};
+    };
+
+    KERNEL_FLOAT_INLINE
+    static constexpr comparators build() {
+        comparators result;
+        generate_sort_network(N, result.lo, result.hi);
+        return result;
+    }
+
+    template<typename F>
+    KERNEL_FLOAT_INLINE static void call(F compare_exchange) {
+        constexpr comparators network = build();
+
+#pragma unroll
+        for (size_t c = 0; c < size; c++) {
+            compare_exchange(network.lo[c], network.hi[c]);
+        }
+    }
+};
+
+template<typename T, size_t N>
+struct sort_impl {
+    KERNEL_FLOAT_INLINE
+    static void call(T* data) {
+        sort_network<N>::call([&](size_t i, size_t j) {
+            T a = data[i];
+            T b = data[j];
+            data[i] = ops::min<T> {}(a, b);
+            data[j] = ops::max<T> {}(a, b);
+        });
+    }
+};
+
+template<typename K, typename T, size_t N, typename Less = ops::less<K>>
+struct sort_by_key_impl {
+    KERNEL_FLOAT_INLINE
+    static void call(K* keys, T* values) {
+        sort_network<N>::call([&](size_t i, size_t j) {
+            K a = keys[i];
+            K b = keys[j];
+            T x = values[i];
+            T y = values[j];
+            bool swap = Less {}(b, a);
+
+            keys[i] = swap ? b : a;
+            keys[j] = swap ? a : b;
+            values[i] = swap ? y : x;
+            values[j] = swap ? x : y;
+        });
+    }
+};
+}  // namespace detail
+
+/**
+ * Sorts the elements of the vector `input` in ascending order. The sort is performed using a sorting network
+ * that is generated at compile-time from `ops::min` and `ops::max`, thus it does not contain any branches or
+ * data-dependent control flow. This makes it suitable for sorting small vectors (for example, `N <= 32`) that
+ * reside in registers.
+ *
+ * Note that NaN values are not preserved since `min` and `max` ignore NaNs.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 5> x = {5, 0, 2, 1, 0};
+ * vec<int, 5> y = sort(x);  // Returns [0, 0, 1, 2, 5]
+ * ```
+ */
+template<typename V>
+KERNEL_FLOAT_INLINE into_vector_type<V> sort(const V& input) {
+    using T = vector_value_type<V>;
+    vector_storage<T, vector_extent<V>> result = into_vector_storage(input);
+    detail::sort_impl<T, vector_extent<V>>::call(result.data());
+    return result;
+}
+
+/**
+ * Sorts the elements of `values` by the corresponding elements of `keys` in ascending order and returns the
+ * reordered `values`. Like `sort`, this uses a compile-time sorting network without data-dependent control flow.
+ * The order of elements having equal keys is not specified.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 3> keys = {3.0f, 1.0f, 2.0f};
+ * vec<int, 3> values = {10, 20, 30};
+ * vec<int, 3> y = sort_by_key(keys, values);  // Returns [20, 30, 10]
+ * ```
+ */
+template<
+    typename K,
+    typename V,
+    typename E = broadcast_vector_extent_type<K, V>,
+    typename T = vector_value_type<V>>
+KERNEL_FLOAT_INLINE vector<T, E> sort_by_key(const K& keys, const V& values) {
+    using KeyType = vector_value_type<K>;
+    vector_storage<KeyType, E::value> key_storage = convert_storage<KeyType>(keys, E {});
+    vector_storage<T, E::value> value_storage = convert_storage<T>(values, E {});
+
+    detail::sort_by_key_impl<KeyType, T, E::value>::call(key_storage.data(), value_storage.data());
+    return value_storage;
+}
+
+/**
+ * Returns the median of the elements of the vector `input`. If the vector has an even number of elements, the
+ * lower of the two middle elements is returned. See `sort` for details on the implementation.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 5> x = {5, 0, 2, 1, 0};
+ * int y = median(x);  // Returns 1
+ * ```
+ */
+template<typename V>
+KERNEL_FLOAT_INLINE vector_value_type<V> median(const V& input) {
+    static constexpr size_t N = vector_extent<V>;
+    static_assert(N > 0, "cannot take the median of an empty vector");
+
+    using T = vector_value_type<V>;
+    vector_storage<T, N> result = into_vector_storage(input);
+    detail::sort_impl<T, N>::call(result.data());
+    return result.data()[(N - 1) / 2];
+}
+
+/**
+ * The result of `top_k`: the `K` largest values in descending order together with their indices.
+ */
+template<typename T, size_t K, typename I = int>
+struct top_k_result {
+    vector<T, extent<K>> values;
+    vector<I, extent<K>> indices;
+};
+
+namespace detail {
+template<typename T, typename I>
+struct top_k_order {
+    static constexpr I invalid_index = I(-1);
+
+    // Returns `true` if the entry `(a, i)` should be ordered before entry `(b, j)`. Entries having an invalid
+    // index are empty slots and are always ordered last.
+    KERNEL_FLOAT_INLINE
+    static bool call(T a, I i, T b, I j) {
+        return i != invalid_index && (j == invalid_index || ops::greater<T> {}(a, b));
+    }
+
+    KERNEL_FLOAT_INLINE
+    static void compare_exchange(T* values, I* indices, size_t x, size_t y) {
+        T a = values[x];
+        T b = values[y];
+        I i = indices[x];
+        I j = indices[y];
+        bool swap = call(b, j, a, i);
+
+        values[x] = swap ? b : a;
+        values[y] = swap ? a : b;
+        indices[x] = swap ? j : i;
+        indices[y] = swap ? i : j;
+    }
+};
+
+template<typename T, typename I, size_t N>
+struct top_k_sort_impl {
+    KERNEL_FLOAT_INLINE
+    static void call(T* values, I* indices) {
+        sort_network<N>::call([&](size_t x, size_t y) {
+            top_k_order<T, I>::compare_exchange(values, indices, x, y);
+        });
+    }
+};
+}  // namespace detail
+
+/**
+ * Returns the `K` largest elements of the vector `input` in descending order together with their indices. The
+ * selection is performed using a compile-time sorting network (see `sort`).
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 5> x = {5.0f, 0.0f, 2.0f, 1.0f, 7.0f};
+ * top_k_result<float, 2> y = top_k<2>(x);  // values=[7.0f, 5.0f], indices=[4, 0]
+ * ```
+ */
+template<size_t K, typename I = int, typename V, typename T = vector_value_type<V>>
+KERNEL_FLOAT_INLINE top_k_result<T, K, I> top_k(const V& input) {
+    static constexpr size_t N = vector_extent<V>;
+    static_assert(K <= N, "K cannot exceed the size of the vector");
+
+    vector_storage<T, N> values = into_vector_storage(input);
+    vector_storage<I, N> indices = range<I, N>();
+    detail::top_k_sort_impl<T, I, N>::call(values.data(), indices.data());
+
+    top_k_result<T, K, I> result;
+
+#pragma unroll
+    for (size_t i = 0; i < K; i++) {
+        result.values[i] = values.data()[i];
+        result.indices[i] = indices.data()[i];
+    }
+
+    return result;
+}
+
+/**
+ * Merges two results of `top_k` into the `K` largest elements of both. Since both inputs are sorted, the `K`
+ * largest elements are obtained by comparing `a[i]` against `b[K - 1 - i]`, which results in a bitonic sequence
+ * that is then sorted using a sorting network. This can be used to combine the partial results of multiple threads.
+ */
+template<typename T, size_t K, typename I>
+KERNEL_FLOAT_INLINE top_k_result<T, K, I>
+merge_top_k(const top_k_result<T, K, I>& a, const top_k_result<T, K, I>& b) {
+    using order = detail::top_k_order<T, I>;
+    top_k_result<T, K, I> result;
+
+#pragma unroll
+    for (size_t i = 0; i < K; i++) {
+        T x = a.values[i];
+        T y = b.values[K - 1 - i];
+        I xi = a.indices[i];
+        I yi = b.indices[K - 1 - i];
+        bool take_b = order::call(y, yi, x, xi);
+
+        result.values[i] = take_b ? y : x;
+        result.indices[i] = take_b ? yi : xi;
+    }
+
+    detail::top_k_sort_impl<T, I, K>::call(result.values.data(), result.indices.data());
+    return result;
+}
+
+/**
+ * Returns the `K` largest elements of the elements ``ptr[begin]``, ``ptr[begin + stride]``, ... up to ``ptr[n]``
+ * (exclusive), together with their indices. The indices are relative to ``ptr`` (not to ``begin``), so only results
+ * for the same ``ptr`` should be merged. The elements are kept in a sorted buffer in registers and each new element
+ * is inserted using a single pass of compare-exchange operations.
+ *
+ * Each thread can process a different range of the data and the partial results of multiple threads can be
+ * combined using ``merge_top_k``. If fewer than `K` elements are processed, the remaining slots have the index
+ * `I(-1)`.
+ *
+ * ```
+ * // Grid-stride loop where each thread processes a subset of the `n` elements
+ * size_t index = blockIdx.x * blockDim.x + threadIdx.x;
+ * size_t stride = gridDim.x * blockDim.x;
+ * top_k_result<float, 8> partial = top_k<8>(scores, n, index, stride);
+ * ```
+ */
+template<size_t K, typename I = int, typename T>
+KERNEL_FLOAT_INLINE top_k_result<T, K, I>
+top_k(const T* ptr, size_t n, size_t begin = 0, size_t stride = 1) {
+    using order = detail::top_k_order<T, I>;
+    static_assert(K > 0, "K must be at least one");
+
+    top_k_result<T, K, I> result;
+    result.indices = fill<K>(order::invalid_index);
+
+    for (size_t i = begin; i < n; i += stride) {
+        T value = ptr[i];
+
+        if (order::call(value, I(i), result.values[K - 1], result.indices[K - 1])) {
+            result.values[K - 1] = value;
+            result.indices[K - 1] = I(i);
+
+#pragma unroll
+            for (size_t j = K - 1; j > 0; j--) {
+                order::compare_exchange(result.values.data(), result.indices.data(), j - 1, j);
+            }
+        }
+    }
+
+    return result;
+}
+
+}  // namespace kernel_float
+
+#endif
+#ifndef KERNEL_FLOAT_REDUCE_H
+#define KERNEL_FLOAT_REDUCE_H
+
+#include <cstring>
+
+
+
+namespace kernel_float {
+namespace detail {
+
+template<size_t N, bool = is_unrolled(N)>
+struct reduce_recur_impl;
+
+template<typename F, size_t N, typename T, typename = void>
+struct reduce_impl {
+    KERNEL_FLOAT_INLINE static T call(F fun, const T* input) {
+        return reduce_recur_impl<N>::call(fun, input);
+    }
+};
+
+template<size_t N, bool>
+struct reduce_recur_impl {
+    static constexpr size_t K = round_up_to_power_of_two(N) / 2;
+
+    template<typename F, typename T>
+    KERNEL_FLOAT_INLINE static T call(F fun, const T* input) {
+        vector_storage<T, K> temp;
+        apply_impl<F, N - K, T, T, T>::call(fun, temp.data(), input, input + K);
+
+        if constexpr (N < 2 * K) {
+#pragma unroll
+            for (size_t i = N - K; i < K; i++) {
+                temp.data()[i] = input[i];
+            }
+        }
+
+        return reduce_impl<F, K, T>::call(fun, temp.data());
+    }
+};
+
+// Large vectors are reduced into `K` partial results by a loop that is not unrolled
+template<size_t N>
+struct reduce_recur_impl<N, false> {
+    static constexpr size_t K = unroll_chunk_size;
+    static constexpr size_t M = N - N % K;
+
+    template<typename F, typename T>
+    KERNEL_FLOAT_INLINE static T call(F fun, const T* input) {
+        vector_storage<T, K> partial;
+
+#pragma unroll
+        for (size_t i = 0; i < K; i++) {
+            partial.data()[i] = input[i];
+        }
+
+#pragma unroll 1
+        for (size_t i = K; i < M; i += K) {
+            apply_impl<F, K, T, T, T>::call(fun, partial.data(), partial.data(), input + i);
+        }
+
+        T result = reduce_impl<F, K, T>::call(fun, partial.data());
+
+#pragma unroll
+        for (size_t i = M; i < N; i++) {
+            result = fun(result, input[i]);
+        }
+
+        return result;
+    }
+};
+
+template<>
+struct reduce_recur_impl<0> {};
+
+template<>
+struct reduce_recur_impl<1> {
+    template<typename F, typename T>
+    KERNEL_FLOAT_INLINE static T call(F fun, const T* input) {
+        return input[0];
+    }
+};
+
+template<>
+struct reduce_recur_impl<2> {
+    template<typename F, typename T>
+    KERNEL_FLOAT_INLINE static T call(F fun, const T* input) {
+        return fun(input[0], input[1]);
+    }
+};
+
+}  // namespace detail
+
+/**
+ * Reduce the elements of the given vector ``input`` into a single value using
+ * the function ``fun``. This function should be a binary function that takes
+ * two elements and returns one element. The order in which the elements
+ * are reduced is not specified and depends on both the reduction function and
+ * the vector type.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 3> x = {5, 2, 1};
+ * int y = reduce(x, [](int a, int b) { return a + b; }); // returns 5+2+1=8
+ * ```
+ */
+template<typename F, typename V>
+KERNEL_FLOAT_INLINE vector_value_type<V> reduce(F fun, const V& input) {
+    return detail::reduce_impl<F, vector_extent<V>, vector_value_type<V>>::call(
+        fun,
+        into_vector_storage(input).data());
+}
+
+namespace detail {
+template<typename E, size_t Axis, typename Is = make_index_sequence<E::rank>>
+struct reduce_axis_extent_helper;
+
+template<size_t... Ns, size_t Axis, size_t... Is>
+struct reduce_axis_extent_helper<extent<Ns...>, Axis, index_sequence<Is...>> {
+    using type = extent<(Is == Axis ? 1 : Ns)...>;
+};
+}  // namespace detail
+
+/**
+ * The extent `E` where dimension `Axis` has been reduced to size 1.
+ */
+template<typename E, size_t Axis>
+using reduce_axis_extent = typename detail::reduce_axis_extent_helper<E, Axis>::type;
+
+/**
+ * Reduce the elements of the multi-dimensional vector ``input`` along dimension `Axis` using the function ``fun``.
+ * The reduced dimension is kept with size 1, so the result can be broadcast against ``input``.
+ *
+ * Example
+ * =======
+ * ```
+ * vector<int, extent<2, 3>> x = {1, 2, 3, 4, 5, 6};
+ * vector<int, extent<1, 3>> y = reduce_axis<0>(ops::add<int> {}, x);  // returns [[5, 7, 9]]
+ * vector<int, extent<2, 1>> z = reduce_axis<1>(ops::add<int> {}, x);  // returns [[6], [15]]
+ * ```
+ */
+template<size_t Axis, typename F, typename V>
+KERNEL_FLOAT_INLINE vector<vector_value_type<V>, reduce_axis_extent<vector_extent_type<V>, Axis>>
+reduce_axis(F fun, const V& input) {
+    using T = vector_value_type<V>;
+    using E = vector_extent_type<V>;
+    static_assert(Axis < E::rank, "axis out of range");
+    static constexpr size_t dim = detail::extent_dim(E {}, Axis);
+    static constexpr size_t stride = detail::extent_stride(E {}, Axis);
+    static constexpr size_t N = E::value / dim;
+
+    vector_storage<T, E::value> items = into_vector_storage(input);
+    vector_storage<T, N> result;
+
+#pragma unroll
+    for (size_t i = 0; i < N; i++) {
+        size_t offset = (i / stride) * (dim * stride) + i % stride;
+        vector_storage<T, dim> lane;
+
+#pragma unroll
+        for (size_t k = 0; k < dim; k++) {
+            lane.data()[k] = items.data()[offset + k * stride];
+        }
+
+        result.data()[i] = detail::reduce_impl<F, dim, T>::call(fun, lane.data());
+    }
+
+    return result;
+}
+
+/**
+ * Find the minimum element in the given vector ``input``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 5> x = {5, 0, 2, 1, 0};
+ * int y = min(x);  // Returns 0
+ * ```
+ */
+template<typename V, typename T = vector_value_type<V>>
+KERNEL_FLOAT_INLINE T min(const V& input) {
+    return reduce(ops::min<T> {}, input);
+}
+
+/**
+ * Find the maximum element in the given vector ``input``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 5> x = {5, 0, 2, 1, 0};
+ * int y = max(x);  // Returns 5
+ * ```
+ */
+template<typename V, typename T = vector_value_type<V>>
+KERNEL_FLOAT_INLINE T max(const V& input) {
+    return reduce(ops::max<T> {}, input);
+}
+
+namespace detail {
+// `ops::abs` is only defined for floating-point types. For signed integers, the magnitude of the most negative value
+// is not representable and saturates to the largest value. Unsigned values are returned as-is.
+template<typename T, typename = void>
+struct amax_abs {
+    KERNEL_FLOAT_INLINE T operator()(T input) {
+        T min_value = T(1ULL << (8 * sizeof(T) - 1));
+        T max_value = T(-(min_value + T(1)));
+        return input < T(0) ? (input == min_value ? max_value : T(-input)) : input;
+    }
+};
+
+template<typename T>
+struct amax_abs<T, enable_if_t<is_promoted_float<T>::value>> {
+    KERNEL_FLOAT_INLINE T operator()(T input) {
+        return ops::abs<T> {}(input);
+    }
+};
+}  // namespace detail
+
+/**
+ * Find the largest absolute value (amax) of the elements in the given vector ``input``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {5.0f, -7.0f, 2.0f, 1.0f};
+ * float y = amax(x);  // Returns 7
+ * ```
+ *
+ * For signed integers, the magnitude of the most negative value (e.g., ``INT_MIN``) cannot be represented and
+ * saturates to the largest value (e.g., ``INT_MAX``).
+ */
+template<typename V, typename T = vector_value_type<V>>
+KERNEL_FLOAT_INLINE T amax(const V& input) {
+    return reduce(ops::max<T> {}, map(detail::amax_abs<T> {}, input));
+}
+
+/**
+ * Sum the items in the given vector ``input``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 5> x = {5, 0, 2, 1, 0};
+ * int y = sum(x);  // Returns 8
+ * ```
+ */
+template<typename V, typename T = vector_value_type<V>>
+KERNEL_FLOAT_INLINE T sum(const V& input) {
+    return reduce(ops::add<T> {}, input);
+}
+
+/**
+ * Multiply the items in the given vector ``input``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 5> x = {5, 0, 2, 1, 0};
+ * int y = product(x);  // Returns 5*0*2*1*0 = 0
+ * ```
+ */
+template<typename V, typename T = vector_value_type<V>>
+KERNEL_FLOAT_INLINE T product(const V& input) {
+    return reduce(ops::multiply<T> {}, input);
+}
+
+namespace detail {
+KERNEL_FLOAT_INLINE int popcount(unsigned long long input) {
+#if KERNEL_FLOAT_IS_DEVICE
+    return __popcll(input);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(input);
+#else
+    int result = 0;
+    for (; input != 0; input &= input - 1) {
+        result++;
+    }
+    return result;
+#endif
+}
+
+template<size_t N>
+struct bitmask_impl {
+    static_assert(N <= 64, "bitmask only supports vectors of at most 64 elements");
+    static_assert(sizeof(bool) == 1, "bitmask requires bool to be one byte");
+
+    KERNEL_FLOAT_INLINE static unsigned long long call(const bool* input) {
+        unsigned long long result = 0;
+
+#pragma unroll
+        for (size_t i = 0; i < N; i += 8) {
+            // A bool is stored as a byte that is either 0 or 1. The multiplication moves the lowest bit of each of
+            // the eight bytes in `word` into the top byte.
+            unsigned long long word = 0;
+            memcpy(&word, input + i, N - i < 8 ? N - i : 8);
+            result |= ((word * 0x0102040810204080ULL) >> 56) << i;
+        }
+
+        return result;
+    }
+};
+
+template<size_t N, bool = (N <= 64)>
+struct bool_reduce_impl {
+    KERNEL_FLOAT_INLINE static bool all(const bool* input) {
+        return reduce_impl<ops::bit_and<bool>, N, bool>::call(ops::bit_and<bool> {}, input);
+    }
+
+    KERNEL_FLOAT_INLINE static bool any(const bool* input) {
+        return reduce_impl<ops::bit_or<bool>, N, bool>::call(ops::bit_or<bool> {}, input);
+    }
+
+    KERNEL_FLOAT_INLINE static int count(const bool* input) {
+        int result = 0;
+
+#pragma unroll
+        for (size_t i = 0; i < N; i++) {
+            result += input[i] ? 1 : 0;
+        }
+
+        return result;
+    }
+};
+
+// For at most 64 elements, the reductions become a single comparison or popcount on the bitmask
+template<size_t N>
+struct bool_reduce_impl<N, true> {
+    static constexpr unsigned long long full_mask = N == 64 ? ~0ULL : (1ULL << (N % 64)) - 1;
+
+    KERNEL_FLOAT_INLINE static bool all(const bool* input) {
+        return bitmask_impl<N>::call(input) == full_mask;
+    }
+
+    KERNEL_FLOAT_INLINE static bool any(const bool* input) {
+        return bitmask_impl<N>::call(input) != 0;
+    }
+
+    KERNEL_FLOAT_INLINE static int count(const bool* input) {
+        return popcount(bitmask_impl<N>::call(input));
+    }
+};
+}  // namespace detail
+
+/**
+ * Returns a bitmask where bit ``i`` is set if element ``i`` of the given vector ``input`` is non-zero. The vector
+ * can have at most 64 elements.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 5> x = {5, 0, 2, 1, 0};
+ * unsigned long long mask = bitmask(x);  // Returns 0b01101
+ * ```
+ */
+template<typename V>
+KERNEL_FLOAT_INLINE unsigned long long bitmask(const V& input) {
+    return detail::bitmask_impl<vector_extent<V>>::call(cast<bool>(input).data());
+}
+
+/**
+ * Returns a vector of ``N`` booleans where element ``i`` is ``true`` if bit ``i`` of ``mask`` is set. This is the
+ * inverse of ``bitmask``. Elements beyond the first 64 are ``false``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<bool, 4> x = from_bitmask<4>(0b0110);  // Returns [false, true, true, false]
+ * ```
+ */
+template<size_t N>
+KERNEL_FLOAT_INLINE vector<bool, extent<N>> from_bitmask(unsigned long long mask, extent<N> = {}) {
+    vector_storage<bool, N> result;
+
+#pragma unroll
+    for (size_t i = 0; i < N; i++) {
+        result.data()[i] = i < 64 && ((mask >> i) & 1) != 0;
+    }
+
+    return result;
+}
+
+/**
+ * Check if all elements in the given vector ``input`` are non-zero. An element ``v`` is considered
+ * non-zero if ``bool(v)==true``.
+ */
+template<typename V>
+KERNEL_FLOAT_INLINE bool all(const V& input) {
+    return detail::bool_reduce_impl<vector_extent<V>>::all(cast<bool>(input).data());
+}
+
+/**
+ * Check if any element in the given vector ``input`` is non-zero. An element ``v`` is considered
+ * non-zero if ``bool(v)==true``.
+ */
+template<typename V>
+KERNEL_FLOAT_INLINE bool any(const V& input) {
+    return detail::bool_reduce_impl<vector_extent<V>>::any(cast<bool>(input).data());
+}
+
+/**
+ * Count the number of non-zero items in the given vector ``input``. An element ``v`` is considered
+ * non-zero if ``bool(v)==true``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 5> x = {5, 0, 2, 1, 0};
+ * int y = count(x);  // Returns 3 (5, 2, 1 are non-zero)
+ * ```
+ */
+template<typename T = int, typename V>
+KERNEL_FLOAT_INLINE T count(const V& input) {
+    return T(detail::bool_reduce_impl<vector_extent<V>>::count(cast<bool>(input).data()));
+}
+
+namespace detail {
+template<typename T, size_t N>
+struct dot_impl {
+    KERNEL_FLOAT_INLINE
+    static T call(const T* left, const T* right) {
+        vector_storage<T, N> intermediate;
+        detail::apply_impl<ops::multiply<T>, N, T, T, T>::call(
+            ops::multiply<T>(),
+            intermediate.data(),
+            left,
+            right);
+
+        return detail::reduce_impl<ops::add<T>, N, T>::call(ops::add<T>(), intermediate.data());
+    }
+};
+}  // namespace detail
+
+/**
+ * Compute the dot product of the given vectors ``left`` and ``right``
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 3> x = {1, 2, 3};
+ * vec<int, 3> y = {4, 5, 6};
+ * int y = dot(x, y);  // Returns 1*4+2*5+3*6 = 32
+ * ```
+ */
+template<typename L, typename R, typename T = promoted_vector_value_type<L, R>>
+KERNEL_FLOAT_INLINE T dot(const L& left, const R& right) {
+    using E = broadcast_vector_extent_type<L, R>;
+    return detail::dot_impl<T, E::value>::call(
+        convert_storage<T>(left, E {}).data(),
+        convert_storage<T>(right, E {}).data());
+}
+
+namespace detail {
+template<typename T, size_t N>
+struct magnitude_impl {
+    KERNEL_FLOAT_INLINE
+    static T call(const T* input) {
+        return ops::sqrt<T> {}(detail::dot_impl<T, N>::call(input, input));
+    }
+};
+
+template<typename T>
+struct magnitude_impl<T, 0> {
+    KERNEL_FLOAT_INLINE
+    static T call(const T* input) {
+        return T {};
+    }
+};
+
+template<typename T>
+struct magnitude_impl<T, 1> {
+    KERNEL_FLOAT_INLINE
+    static T call(const T* input) {
+        return ops::abs<T> {}(input[0]);
+    }
+};
+
+template<typename T>
+struct magnitude_impl<T, 2> {
+    KERNEL_FLOAT_INLINE
+    static T call(const T* input) {
+        return ops::hypot<T>()(input[0], input[1]);
+    }
+};
+
+// The 3-argument overload of hypot is only available on host from C++17
+#if defined(__cpp_lib_hypot) && KERNEL_FLOAT_IS_HOST
+template<>
+struct magnitude_impl<float, 3> {
+    static float call(const float* input) {
+        return ::hypot(input[0], input[1], input[2]);
+    }
+};
+
+template<>
+struct magnitude_impl<double, 3> {
+    static double call(const double* input) {
+        return ::hypot(input[0], input[1], input[2]);
+    }
+};
+#endif
+
+}  // namespace detail
+
+/**
+ * Compute the magnitude of the given input vector. This calculates the square root of the sum of squares, also
+ * known as the Euclidian norm, of a vector.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 3> x = {2, 3, 6};
+ * float y = mag(x);  // Returns sqrt(2*2 + 3*3 + 6*6) = 7
+ * ```
+ */
+template<typename V, typename T = vector_value_type<V>>
+KERNEL_FLOAT_INLINE T mag(const V& input) {
+    return detail::magnitude_impl<T, vector_extent<V>>::call(into_vector_storage(input).data());
+}
+
+/**
+ * Running statistics (count, mean, and sum of squared deviations ``m2``) of a sequence of values, as computed by
+ * Welford's algorithm. Two partial results can be combined using ``merge_moments``, which makes it possible to
+ * compute the statistics of a large dataset in parallel and then merge the results.
+ */
+template<typename T>
+struct running_moments {
+    T count = T(0);
+    T mean = T(0);
+    T m2 = T(0);
+
+    /**
+     * Add a single value to these statistics.
+     */
+    KERNEL_FLOAT_INLINE
+    void push(T value) {
+        count = count + T(1);
+        T delta = value - mean;
+        mean = mean + delta / count;
+        m2 = m2 + delta * (value - mean);
+    }
+
+    /**
+     * Returns the population variance (``m2 / count``).
+     */
+    KERNEL_FLOAT_INLINE
+    T variance() const {
+        return count > T(0) ? m2 / count : T(0);
+    }
+
+    /**
+     * Returns the sample variance (``m2 / (count - 1)``).
+     */
+    KERNEL_FLOAT_INLINE
+    T sample_variance() const {
+        return count > T(1) ? m2 / (count - T(1)) : T(0);
+    }
+
+    /**
+     * Returns the population standard deviation.
+     */
+    KERNEL_FLOAT_INLINE
+    T stddev() const {
+        return ops::sqrt<T> {}(variance());
+    }
+};
+
+namespace ops {
+template<typename T>
+struct merge_moments {
+    KERNEL_FLOAT_INLINE running_moments<T>
+    operator()(const running_moments<T>& a, const running_moments<T>& b) {
+        T count = a.count + b.count;
+
+        if (count == T(0)) {
+            return a;
+        }
+
+        T delta = b.mean - a.mean;
+        T factor = b.count / count;
+
+        running_moments<T> result;
+        result.count = count;
+        result.mean = a.mean + delta * factor;
+        result.m2 = a.m2 + b.m2 + delta * delta * a.count * factor;
+        return result;
+    }
+};
+
+template<typename T>
+struct into_moments {
+    template<typename U>
+    KERNEL_FLOAT_INLINE running_moments<T> operator()(U value) {
+        return {T(1), ops::cast<U, T> {}(value), T(0)};
+    }
+};
+}  // namespace ops
+
+/**
+ * Combine the statistics of two disjoint sets of values into the statistics of their union. This uses the
+ * parallel formulation of Welford's algorithm by Chan et al.
+ *
+ * Example
+ * =======
+ * ```
+ * running_moments<float> a = moments(vec<float, 2>(1.0f, 2.0f));
+ * running_moments<float> b = moments(vec<float, 2>(3.0f, 4.0f));
+ * running_moments<float> c = merge_moments(a, b);  // count=4, mean=2.5, m2=5
+ * ```
+ */
+template<typename T>
+KERNEL_FLOAT_INLINE running_moments<T>
+merge_moments(const running_moments<T>& a, const running_moments<T>& b) {
+    return ops::merge_moments<T> {}(a, b);
+}
+
+/**
+ * Compute the count, mean, and sum of squared deviations (``m2``) of the elements in the given vector ``input``
+ * in a single pass. The statistics are accumulated in type ``A``, which is at least ``float``.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> x = {1.0f, 2.0f, 3.0f, 4.0f};
+ * running_moments<float> m = moments(x);
+ * float mean = m.mean;  // Returns 2.5
+ * float var = m.variance();  // Returns 1.25
+ * ```
+ */
+template<typename V, typename A = widest_promote_t<float, vector_value_type<V>>>
+KERNEL_FLOAT_INLINE running_moments<A> moments(const V& input) {
+    return reduce(ops::merge_moments<A> {}, map(ops::into_moments<A> {}, input));
+}
+}  // namespace kernel_float
+
+#endif  //KERNEL_FLOAT_REDUCE_H
+#ifndef KERNEL_FLOAT_MEMORY_H
+#define KERNEL_FLOAT_MEMORY_H
+
 
 
 
@@ -2542,7 +4763,10 @@ constexpr size_t gcd(size_t a, size_t b) {
 }
 
 template<typename T, size_t N, size_t alignment, typename = void>
-struct copy_aligned_impl {
+struct copy_aligned_impl;
+
+template<typename T, size_t N, size_t alignment, bool = is_unrolled(N)>
+struct copy_aligned_recur_impl {
     static constexpr size_t K = N > 8 ? 8 : (N > 4 ? 4 : (N > 2 ? 2 : 1));
     static constexpr size_t alignment_K = gcd(alignment, sizeof(T) * K);
 
@@ -2559,6 +4783,37 @@ struct copy_aligned_impl {
     }
 };
 
+// Large vectors are copied in chunks by a loop that is not unrolled
+template<typename T, size_t N, size_t alignment>
+struct copy_aligned_recur_impl<T, N, alignment, false> {
+    static constexpr size_t K = unroll_chunk_size;
+    static constexpr size_t M = N - N % K;
+    static constexpr size_t alignment_K = gcd(alignment, sizeof(T) * K);
+
+    KERNEL_FLOAT_INLINE
+    static void load(T* output, const T* input) {
+#pragma unroll 1
+        for (size_t i = 0; i < M; i += K) {
+            copy_aligned_impl<T, K, alignment_K>::load(output + i, input + i);
+        }
+
+        copy_aligned_impl<T, N - M, alignment_K>::load(output + M, input + M);
+    }
+
+    KERNEL_FLOAT_INLINE
+    static void store(T* output, const T* input) {
+#pragma unroll 1
+        for (size_t i = 0; i < M; i += K) {
+            copy_aligned_impl<T, K, alignment_K>::store(output + i, input + i);
+        }
+
+        copy_aligned_impl<T, N - M, alignment_K>::store(output + M, input + M);
+    }
+};
+
+template<typename T, size_t N, size_t alignment, typename>
+struct copy_aligned_impl: copy_aligned_recur_impl<T, N, alignment> {};
+
 template<typename T, size_t alignment>
 struct copy_aligned_impl<T, 0, alignment> {
     KERNEL_FLOAT_INLINE
@@ -2714,6 +4969,75 @@ KERNEL_FLOAT_INLINE void write_aligned(T* ptr, const V& values) {
         convert_storage<T, N>(values).data());
 }
 
+namespace detail {
+template<typename T, typename R>
+static constexpr size_t convert_buffer_width =
+    KERNEL_FLOAT_MAX_ALIGNMENT / (sizeof(T) > sizeof(R) ? sizeof(T) : sizeof(R)) > 0
+    ? KERNEL_FLOAT_MAX_ALIGNMENT / (sizeof(T) > sizeof(R) ? sizeof(T) : sizeof(R))
+    : 1;
+
+template<size_t N, typename T>
+KERNEL_FLOAT_INLINE size_t elements_until_aligned(const T* ptr) {
+    size_t offset = (reinterpret_cast<size_t>(ptr) / sizeof(T)) % N;
+    return offset == 0 ? 0 : N - offset;
+}
+}  // namespace detail
+
+/**
+ * Converts the ``n`` elements of the buffer ``src`` to type ``R`` and stores them in the buffer ``dst``.
+ *
+ * The buffers are processed in chunks of ``N`` elements, which by default is the number of elements that fit
+ * into ``KERNEL_FLOAT_MAX_ALIGNMENT`` bytes. This means the conversion can use the specialized implementations
+ * for multiple elements at once (for example, the packed conversions of ``__half2`` or fp8x2) and that ``dst`` is
+ * written using aligned vector stores. The unaligned head and the tail of the buffers are converted one element
+ * at a time. The buffers should not overlap.
+ *
+ * The work can be split over multiple threads using ``thread_index`` and ``thread_count``, where each thread
+ * processes every ``thread_count``-th chunk.
+ *
+ * ```
+ * // Convert on the host
+ * convert_buffer(output, input, n);
+ *
+ * // Convert on the GPU where every thread processes a subset of the buffer
+ * size_t index = blockIdx.x * blockDim.x + threadIdx.x;
+ * size_t count = gridDim.x * blockDim.x;
+ * convert_buffer(output, input, n, index, count);
+ * ```
+ */
+template<typename R, typename T, size_t N = detail::convert_buffer_width<T, R>>
+KERNEL_FLOAT_INLINE void convert_buffer(
+    R* dst,
+    const T* src,
+    size_t n,
+    size_t thread_index = 0,
+    size_t thread_count = 1) {
+    size_t head = detail::elements_until_aligned<N>(dst);
+    head = head < n ? head : n;
+
+    for (size_t i = thread_index; i < head; i += thread_count) {
+        dst[i] = ops::cast<T, R> {}(src[i]);
+    }
+
+    size_t num_chunks = (n - head) / N;
+    R* dst_body = dst + head;
+    const T* src_body = src + head;
+
+    if (detail::elements_until_aligned<N>(src_body) == 0) {
+        for (size_t i = thread_index; i < num_chunks; i += thread_count) {
+            write_aligned<N>(dst_body + i * N, convert<R, N>(read_aligned<N>(src_body + i * N)));
+        }
+    } else {
+        for (size_t i = thread_index; i < num_chunks; i += thread_count) {
+            write_aligned<N>(dst_body + i * N, convert<R, N>(read<N>(src_body + i * N)));
+        }
+    }
+
+    for (size_t i = head + num_chunks * N + thread_index; i < n; i += thread_count) {
+        dst[i] = ops::cast<T, R> {}(src[i]);
+    }
+}
+
 /**
  * @brief A reference wrapper that allows reading/writing a vector of type `T`and length `N` with optional data
  * conversion.
@@ -2772,6 +5096,21 @@ struct vector_ref {
         return *this;
     }
 
+    /**
+     * Applies the function `fun` to each element and writes the results back to the underlying raw pointer. The
+     * elements are updated in place using `map_inplace`, so no second vector is created.
+     *
+     * @param fun The function to apply to each element.
+     * @param args Optional additional arguments passed to `fun`, which are broadcast to `N` elements.
+     */
+    template<typename F, typename... Args>
+    KERNEL_FLOAT_INLINE vector_ref apply(F fun, const Args&... args) const {
+        vector_type values = read();
+        map_inplace(fun, values, args...);
+        write(values);
+        return *this;
+    }
+
     /**
      * Gets the raw data pointer managed by this vector_ref
      */
@@ -2810,19 +5149,42 @@ struct vector_ref<T, N, const U, Align> {
     pointer_type data_ = nullptr;
 };
 
-#define KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(OP, OP_ASSIGN)                 \
-    template<typename T, size_t N, typename U, size_t Align, typename V> \
-    KERNEL_FLOAT_INLINE vector_ref<T, N, U, Align> operator OP_ASSIGN(   \
-        vector_ref<T, N, U, Align> ptr,                                  \
-        const V& value) {                                                \
-        ptr.write(ptr.read() OP value);                                  \
-        return ptr;                                                      \
-    }
-
-KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(+, +=)
-KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(-, -=)
-KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(*, *=)
-KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(/, /=)
+// The elements are updated in place if `vector OP_ASSIGN value` is allowed. Otherwise, for example if `value` has
+// a wider type, the result of `vector OP value` is converted back when it is written.
+#define KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(NAME, OP, OP_ASSIGN)                                \
+    template<                                                                                 \
+        typename T,                                                                           \
+        size_t N,                                                                             \
+        typename U,                                                                           \
+        size_t Align,                                                                         \
+        typename V,                                                                           \
+        enable_if_t<is_vector_assign_allowed<ops::NAME, decay_t<T>, extent<N>, V>, int> = 0>  \
+    KERNEL_FLOAT_INLINE vector_ref<T, N, U, Align> operator OP_ASSIGN(                        \
+        vector_ref<T, N, U, Align> ptr,                                                       \
+        const V& value) {                                                                     \
+        auto values = ptr.read();                                                             \
+        values OP_ASSIGN value;                                                               \
+        ptr.write(values);                                                                    \
+        return ptr;                                                                           \
+    }                                                                                         \
+    template<                                                                                 \
+        typename T,                                                                           \
+        size_t N,                                                                             \
+        typename U,                                                                           \
+        size_t Align,                                                                         \
+        typename V,                                                                           \
+        enable_if_t<!is_vector_assign_allowed<ops::NAME, decay_t<T>, extent<N>, V>, int> = 0> \
+    KERNEL_FLOAT_INLINE vector_ref<T, N, U, Align> operator OP_ASSIGN(                        \
+        vector_ref<T, N, U, Align> ptr,                                                       \
+        const V& value) {                                                                     \
+        ptr.write(ptr.read() OP value);                                                       \
+        return ptr;                                                                           \
+    }
+
+KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(add, +, +=)
+KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(subtract, -, -=)
+KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(multiply, *, *=)
+KERNEL_FLOAT_VECTOR_REF_ASSIGN_OP(divide, /, /=)
 
 /**
  * A wrapper for a pointer that enables vectorized access and supports type conversions..
@@ -3012,6 +5374,52 @@ KERNEL_FLOAT_INLINE vector_ptr<T, N> assert_aligned(T* ptr) {
 }
 /// @endcond
 
+/**
+ * Compute the count, mean, and sum of squared deviations (``m2``) of the elements of the vectors ``ptr[begin]``,
+ * ``ptr[begin + stride]``, ``ptr[begin + 2 * stride]``, ... up to ``ptr[end]`` (exclusive). The data is read only
+ * once, which makes this function suitable for normalizing data in a single pass over memory.
+ *
+ * Each thread can process a different range of the data and the partial results of multiple threads can be
+ * combined using ``merge_moments``.
+ *
+ * ```
+ * // Grid-stride loop where each thread processes a subset of the `n` vectors
+ * size_t index = blockIdx.x * blockDim.x + threadIdx.x;
+ * size_t stride = gridDim.x * blockDim.x;
+ * running_moments<float> partial = moments(ptr, index, n, stride);
+ * ```
+ */
+template<typename T, size_t N, typename U, typename A = widest_promote_t<float, T>>
+KERNEL_FLOAT_INLINE running_moments<A>
+moments(vector_ptr<T, N, U> ptr, size_t begin, size_t end, size_t stride = 1) {
+    A count = A(0);
+    vector_storage<A, N> mean;
+    vector_storage<A, N> m2;
+
+    // All lanes have seen the same number of elements, so the division only needs to be performed once per vector
+    for (size_t i = begin; i < end; i += stride) {
+        vector_storage<A, N> values = convert_storage<A, N>(ptr.read(i));
+        count = count + A(1);
+        A inv_count = A(1) / count;
+
+#pragma unroll
+        for (size_t j = 0; j < N; j++) {
+            A delta = values.data()[j] - mean.data()[j];
+            mean.data()[j] = mean.data()[j] + delta * inv_count;
+            m2.data()[j] = m2.data()[j] + delta * (values.data()[j] - mean.data()[j]);
+        }
+    }
+
+    vector_storage<running_moments<A>, N> lanes;
+
+#pragma unroll
+    for (size_t j = 0; j < N; j++) {
+        lanes.data()[j] = {count, mean.data()[j], m2.data()[j]};
+    }
+
+    return reduce(ops::merge_moments<A> {}, lanes);
+}
+
 template<typename T, size_t N = 1, typename U = T>
 using vec_ptr = vector_ptr<T, N, U>;
 
@@ -3034,286 +5442,194 @@ vec_ptr(const T*) -> vec_ptr<T, 1, const T>;
 }  // namespace kernel_float
 
 #endif  //KERNEL_FLOAT_MEMORY_H
-#ifndef KERNEL_FLOAT_REDUCE_H
-#define KERNEL_FLOAT_REDUCE_H
+#ifndef KERNEL_FLOAT_PACKED_H
+#define KERNEL_FLOAT_PACKED_H
+
+
 
 
 
 namespace kernel_float {
-namespace detail {
 
-template<size_t N>
-struct reduce_recur_impl;
+/**
+ * Two signed 4-bit integers in the range [-8, 7] packed into a single byte. The first value is stored in the lower
+ * four bits and the second value in the upper four bits.
+ */
+struct int4x2 {
+    unsigned char bits;
+};
 
-template<typename F, size_t N, typename T, typename = void>
-struct reduce_impl {
-    KERNEL_FLOAT_INLINE static T call(F fun, const T* input) {
-        return reduce_recur_impl<N>::call(fun, input);
-    }
+/**
+ * Two unsigned 4-bit integers in the range [0, 15] packed into a single byte. The first value is stored in the lower
+ * four bits and the second value in the upper four bits.
+ */
+struct uint4x2 {
+    unsigned char bits;
 };
 
-template<size_t N>
-struct reduce_recur_impl {
-    static constexpr size_t K = round_up_to_power_of_two(N) / 2;
+/**
+ * Two 4-bit floating-point numbers in the e2m1 format (1 sign bit, 2 exponent bits, 1 mantissa bit) packed into a
+ * single byte. The representable magnitudes are 0, 0.5, 1, 1.5, 2, 3, 4, and 6. There are no infinities or NaNs.
+ */
+struct fp4x2_e2m1 {
+    unsigned char bits;
+};
 
-    template<typename F, typename T>
-    KERNEL_FLOAT_INLINE static T call(F fun, const T* input) {
-        vector_storage<T, K> temp;
-        apply_impl<F, N - K, T, T, T>::call(fun, temp.data(), input, input + K);
+namespace detail {
+template<typename P>
+struct packed_traits;
 
-        if constexpr (N < 2 * K) {
-#pragma unroll
-            for (size_t i = N - K; i < K; i++) {
-                temp.data()[i] = input[i];
-            }
-        }
+template<>
+struct packed_traits<int4x2> {
+    using value_type = int;
 
-        return reduce_impl<F, K, T>::call(fun, temp.data());
+    KERNEL_FLOAT_INLINE static int decode(unsigned int nibble) {
+        return int(nibble ^ 0x8) - 8;
+    }
+
+    // Saturates before converting to `int`, since that conversion is undefined for values out of range (and NaN)
+    template<typename F>
+    KERNEL_FLOAT_INLINE static unsigned int encode(F value) {
+        int result = value >= F(7) ? 7 : value > F(-8) ? int(value) : -8;
+        return (unsigned int)(result) & 0xF;
     }
 };
 
 template<>
-struct reduce_recur_impl<0> {};
+struct packed_traits<uint4x2> {
+    using value_type = int;
 
-template<>
-struct reduce_recur_impl<1> {
-    template<typename F, typename T>
-    KERNEL_FLOAT_INLINE static T call(F fun, const T* input) {
-        return input[0];
+    KERNEL_FLOAT_INLINE static int decode(unsigned int nibble) {
+        return int(nibble);
     }
-};
 
-template<>
-struct reduce_recur_impl<2> {
-    template<typename F, typename T>
-    KERNEL_FLOAT_INLINE static T call(F fun, const T* input) {
-        return fun(input[0], input[1]);
+    template<typename F>
+    KERNEL_FLOAT_INLINE static unsigned int encode(F value) {
+        int result = value >= F(15) ? 15 : value > F(0) ? int(value) : 0;
+        return (unsigned int)(result);
     }
 };
 
-}  // namespace detail
-
-/**
- * Reduce the elements of the given vector ``input`` into a single value using
- * the function ``fun``. This function should be a binary function that takes
- * two elements and returns one element. The order in which the elements
- * are reduced is not specified and depends on both the reduction function and
- * the vector type.
- *
- * Example
- * =======
- * ```
- * vec<int, 3> x = {5, 2, 1};
- * int y = reduce(x, [](int a, int b) { return a + b; }); // returns 5+2+1=8
- * ```
- */
-template<typename F, typename V>
-KERNEL_FLOAT_INLINE vector_value_type<V> reduce(F fun, const V& input) {
-    return detail::reduce_impl<F, vector_extent<V>, vector_value_type<V>>::call(
-        fun,
-        into_vector_storage(input).data());
-}
-
-/**
- * Find the minimum element in the given vector ``input``.
- *
- * Example
- * =======
- * ```
- * vec<int, 5> x = {5, 0, 2, 1, 0};
- * int y = min(x);  // Returns 0
- * ```
- */
-template<typename V, typename T = vector_value_type<V>>
-KERNEL_FLOAT_INLINE T min(const V& input) {
-    return reduce(ops::min<T> {}, input);
-}
-
-/**
- * Find the maximum element in the given vector ``input``.
- *
- * Example
- * =======
- * ```
- * vec<int, 5> x = {5, 0, 2, 1, 0};
- * int y = max(x);  // Returns 5
- * ```
- */
-template<typename V, typename T = vector_value_type<V>>
-KERNEL_FLOAT_INLINE T max(const V& input) {
-    return reduce(ops::max<T> {}, input);
-}
-
-/**
- * Sum the items in the given vector ``input``.
- *
- * Example
- * =======
- * ```
- * vec<int, 5> x = {5, 0, 2, 1, 0};
- * int y = sum(x);  // Returns 8
- * ```
- */
-template<typename V, typename T = vector_value_type<V>>
-KERNEL_FLOAT_INLINE T sum(const V& input) {
-    return reduce(ops::add<T> {}, input);
-}
-
-/**
- * Multiply the items in the given vector ``input``.
- *
- * Example
- * =======
- * ```
- * vec<int, 5> x = {5, 0, 2, 1, 0};
- * int y = product(x);  // Returns 5*0*2*1*0 = 0
- * ```
- */
-template<typename V, typename T = vector_value_type<V>>
-KERNEL_FLOAT_INLINE T product(const V& input) {
-    return reduce(ops::multiply<T> {}, input);
-}
-
-/**
- * Check if all elements in the given vector ``input`` are non-zero. An element ``v`` is considered
- * non-zero if ``bool(v)==true``.
- */
-template<typename V>
-KERNEL_FLOAT_INLINE bool all(const V& input) {
-    return reduce(ops::bit_and<bool> {}, cast<bool>(input));
-}
-
-/**
- * Check if any element in the given vector ``input`` is non-zero. An element ``v`` is considered
- * non-zero if ``bool(v)==true``.
- */
-template<typename V>
-KERNEL_FLOAT_INLINE bool any(const V& input) {
-    return reduce(ops::bit_or<bool> {}, cast<bool>(input));
-}
-
-/**
- * Count the number of non-zero items in the given vector ``input``. An element ``v`` is considered
- * non-zero if ``bool(v)==true``.
- *
- * Example
- * =======
- * ```
- * vec<int, 5> x = {5, 0, 2, 1, 0};
- * int y = count(x);  // Returns 3 (5, 2, 1 are non-zero)
- * ```
- */
-template<typename T = int, typename V>
-KERNEL_FLOAT_INLINE T count(const V& input) {
-    return sum(cast<T>(cast<bool>(input)));
-}
+template<>
+struct packed_traits<fp4x2_e2m1> {
+    using value_type = float;
 
-namespace detail {
-template<typename T, size_t N>
-struct dot_impl {
-    KERNEL_FLOAT_INLINE
-    static T call(const T* left, const T* right) {
-        vector_storage<T, N> intermediate;
-        detail::apply_impl<ops::multiply<T>, N, T, T, T>::call(
-            ops::multiply<T>(),
-            intermediate.data(),
-            left,
-            right);
+    KERNEL_FLOAT_INLINE static float decode(unsigned int nibble) {
+        // The magnitude is (1 + m / 2) * 2^(e - 1) for normal numbers and m / 2 for the subnormal numbers
+        unsigned int e = (nibble >> 1) & 0x3;
+        unsigned int m = nibble & 0x1;
+        float magnitude = e == 0 ? float(m) * 0.5f : float(2 + m) * float(1 << e) * 0.25f;
+        return nibble & 0x8 ? -magnitude : magnitude;
+    }
 
-        return detail::reduce_impl<ops::add<T>, N, T>::call(ops::add<T>(), intermediate.data());
+    KERNEL_FLOAT_INLINE static unsigned int encode(float value) {
+        // Round to nearest with ties to even by counting the midpoints below `x`. Values larger than the largest
+        // value (6.0) saturate.
+        float x = ::fabsf(value);
+        unsigned int code = (x > 0.25f) + (x >= 0.75f) + (x > 1.25f) + (x >= 1.75f) + (x > 2.5f)
+            + (x >= 3.5f) + (x > 5.0f);
+        return ::signbit(value) ? code | 0x8 : code;
     }
 };
 }  // namespace detail
 
 /**
- * Compute the dot product of the given vectors ``left`` and ``right``
+ * Unpacks a vector of `N` packed values (`int4x2`, `uint4x2`, or `fp4x2_e2m1`) into a vector of `2 * N` elements
+ * of type `R`.
  *
  * Example
  * =======
  * ```
- * vec<int, 3> x = {1, 2, 3};
- * vec<int, 3> y = {4, 5, 6};
- * int y = dot(x, y);  // Returns 1*4+2*5+3*6 = 32
+ * vec<uint4x2, 2> packed = {uint4x2 {0x21}, uint4x2 {0x43}};
+ * vec<float, 4> values = unpack<float>(packed); // returns [1, 2, 3, 4]
  * ```
  */
-template<typename L, typename R, typename T = promoted_vector_value_type<L, R>>
-KERNEL_FLOAT_INLINE T dot(const L& left, const R& right) {
-    using E = broadcast_vector_extent_type<L, R>;
-    return detail::dot_impl<T, E::value>::call(
-        convert_storage<T>(left, E {}).data(),
-        convert_storage<T>(right, E {}).data());
-}
+template<typename R, typename V>
+KERNEL_FLOAT_INLINE vector<R, extent<2 * vector_extent<V>>> unpack(const V& input) {
+    using P = vector_value_type<V>;
+    using traits = detail::packed_traits<P>;
+    using T = typename traits::value_type;
+    static constexpr size_t N = vector_extent<V>;
 
-namespace detail {
-template<typename T, size_t N>
-struct magnitude_impl {
-    KERNEL_FLOAT_INLINE
-    static T call(const T* input) {
-        return ops::sqrt<T> {}(detail::dot_impl<T, N>::call(input, input));
-    }
-};
+    vector_storage<P, N> packed = into_vector_storage(input);
+    vector_storage<R, 2 * N> result;
 
-template<typename T>
-struct magnitude_impl<T, 0> {
-    KERNEL_FLOAT_INLINE
-    static T call(const T* input) {
-        return T {};
+#pragma unroll
+    for (size_t i = 0; i < N; i++) {
+        unsigned int bits = packed.data()[i].bits;
+        result.data()[2 * i + 0] = ops::cast<T, R> {}(traits::decode(bits & 0xF));
+        result.data()[2 * i + 1] = ops::cast<T, R> {}(traits::decode(bits >> 4));
     }
-};
 
-template<typename T>
-struct magnitude_impl<T, 1> {
-    KERNEL_FLOAT_INLINE
-    static T call(const T* input) {
-        return ops::abs<T> {}(input[0]);
-    }
-};
+    return result;
+}
 
-template<typename T>
-struct magnitude_impl<T, 2> {
-    KERNEL_FLOAT_INLINE
-    static T call(const T* input) {
-        return ops::hypot<T>()(input[0], input[1]);
-    }
-};
+/**
+ * Packs a vector of `2 * N` elements into a vector of `N` packed values of type `P` (`int4x2`, `uint4x2`, or
+ * `fp4x2_e2m1`). Values outside the representable range saturate. Conversion to `int4x2` and `uint4x2` truncates
+ * towards zero (NaN becomes the smallest value), while conversion to `fp4x2_e2m1` rounds to nearest.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> values = {1.0f, -2.0f, 0.7f, 100.0f};
+ * vec<fp4x2_e2m1, 2> packed = pack<fp4x2_e2m1>(values); // represents [1, -2, 0.5, 6]
+ * ```
+ */
+template<typename P, typename V>
+KERNEL_FLOAT_INLINE vector<P, extent<vector_extent<V> / 2>> pack(const V& input) {
+    using traits = detail::packed_traits<P>;
+    using F = widest_promote_t<float, vector_value_type<V>>;
+    static constexpr size_t N = vector_extent<V> / 2;
+    static_assert(vector_extent<V> % 2 == 0, "the number of elements to pack must be even");
 
-// The 3-argument overload of hypot is only available on host from C++17
-#if defined(__cpp_lib_hypot) && KERNEL_FLOAT_IS_HOST
-template<>
-struct magnitude_impl<float, 3> {
-    static float call(const float* input) {
-        return ::hypot(input[0], input[1], input[2]);
-    }
-};
+    // The values are encoded in floating-point, such that they saturate before they are converted to an integer
+    vector_storage<F, 2 * N> values = convert_storage<F, 2 * N>(input);
+    vector_storage<P, N> result;
 
-template<>
-struct magnitude_impl<double, 3> {
-    static double call(const double* input) {
-        return ::hypot(input[0], input[1], input[2]);
+#pragma unroll
+    for (size_t i = 0; i < N; i++) {
+        unsigned int lo = traits::encode(values.data()[2 * i + 0]);
+        unsigned int hi = traits::encode(values.data()[2 * i + 1]);
+        result.data()[i] = P {(unsigned char)(lo | (hi << 4))};
     }
-};
-#endif
 
-}  // namespace detail
+    return result;
+}
 
 /**
- * Compute the magnitude of the given input vector. This calculates the square root of the sum of squares, also
- * known as the Euclidian norm, of a vector.
+ * Loads `N` elements stored as `N / 2` packed values starting at `ptr` and unpacks them into a vector of type `R`.
+ * It is assumed that ``ptr`` is aligned such that the `N / 2` bytes can be loaded at once, see `read_aligned`.
  *
- * Example
- * =======
  * ```
- * vec<float, 3> x = {2, 3, 6};
- * float y = mag(x);  // Returns sqrt(2*2 + 3*3 + 6*6) = 7
+ * // Load 32 int4 weights (16 bytes) as floats
+ * vec<float, 32> weights = read_packed<float, 32>(ptr);
  * ```
  */
-template<typename V, typename T = vector_value_type<V>>
-KERNEL_FLOAT_INLINE T mag(const V& input) {
-    return detail::magnitude_impl<T, vector_extent<V>>::call(into_vector_storage(input).data());
+template<typename R, size_t N, typename P>
+KERNEL_FLOAT_INLINE vector<R, extent<N>> read_packed(const P* ptr) {
+    static_assert(N % 2 == 0, "the number of elements to read must be even");
+    return unpack<R>(read_aligned<N / 2>(ptr));
+}
+
+/**
+ * Packs the elements of `values` and stores them as `N / 2` packed values starting at `ptr`. It is assumed that
+ * ``ptr`` is aligned such that the `N / 2` bytes can be stored at once, see `write_aligned`.
+ *
+ * ```
+ * vec<float, 32> weights = ...;
+ * write_packed(ptr, weights);
+ * ```
+ */
+template<typename P, typename V>
+KERNEL_FLOAT_INLINE void write_packed(P* ptr, const V& values) {
+    static constexpr size_t N = vector_extent<V>;
+    write_aligned<N / 2>(ptr, pack<P>(values));
 }
+
 }  // namespace kernel_float
 
-#endif  //KERNEL_FLOAT_REDUCE_H
+#endif  // KERNEL_FLOAT_PACKED_H
 #ifndef KERNEL_FLOAT_TRIOPS_H
 #define KERNEL_FLOAT_TRIOPS_H
 
@@ -3445,22 +5761,441 @@ KERNEL_FLOAT_INLINE vector<T, E> fma(const A& a, const B& b, const C& c) {
     detail::apply_impl<F, E::value, T, T, T, T>::call(
         F {},
         result.data(),
-        detail::convert_impl<vector_value_type<A>, vector_extent_type<A>, T, E>::call(
-            into_vector_storage(a))
-            .data(),
-        detail::convert_impl<vector_value_type<B>, vector_extent_type<B>, T, E>::call(
-            into_vector_storage(b))
-            .data(),
-        detail::convert_impl<vector_value_type<C>, vector_extent_type<C>, T, E>::call(
-            into_vector_storage(c))
-            .data());
+        detail::convert_impl<vector_value_type<A>, vector_extent_type<A>, T, E>::call(
+            into_vector_storage(a))
+            .data(),
+        detail::convert_impl<vector_value_type<B>, vector_extent_type<B>, T, E>::call(
+            into_vector_storage(b))
+            .data(),
+        detail::convert_impl<vector_value_type<C>, vector_extent_type<C>, T, E>::call(
+            into_vector_storage(c))
+            .data());
+
+    return result;
+}
+
+}  // namespace kernel_float
+
+#endif  //KERNEL_FLOAT_TRIOPS_H
+#ifndef KERNEL_FLOAT_LAZY_H
+#define KERNEL_FLOAT_LAZY_H
+
+
+
+
+
+namespace kernel_float {
+namespace detail {
+
+/**
+ * Leaf of a lazy expression: a vector of extent `E` that is broadcast to the extent of the whole expression when
+ * its elements are requested. Scalars are stored as a single element and are never copied `N` times.
+ */
+template<typename T, typename E>
+struct lazy_leaf {
+    using value_type = T;
+    using compute_value_type = T;
+    using extent_type = E;
+
+    template<typename To>
+    KERNEL_FLOAT_INLINE T eval(size_t i) const {
+        return storage.data()[broadcast_index(i, E {}, To {})];
+    }
+
+    vector_storage<T, E::value> storage;
+};
+
+/**
+ * Returns element `i` of the expression `X` evaluated over extent `To`, converted to type `T`. Since every node
+ * already computes in its own compute type, only the leaves of an expression perform an actual conversion.
+ */
+template<typename T, typename To, typename X>
+KERNEL_FLOAT_INLINE T lazy_value(const X& expr, size_t i) {
+    return ops::cast<typename X::compute_value_type, T> {}(expr.template eval<To>(i));
+}
+
+template<typename V>
+using lazy_leaf_type = lazy_leaf<vector_value_type<V>, vector_extent_type<V>>;
+
+template<typename L, typename R>
+using lazy_promoted_type = promote_t<typename L::value_type, typename R::value_type>;
+
+// The type in which a binary node computes its result, which can be wider than its `value_type`.
+template<typename L, typename R>
+using lazy_compute_type = kernel_float::compute_type<lazy_promoted_type<L, R>>;
+
+template<typename F, typename L, typename R>
+struct lazy_binary_eval {
+    using T = lazy_compute_type<L, R>;
+
+    template<typename To>
+    KERNEL_FLOAT_INLINE static result_t<F, T, T> call(const L& left, const R& right, size_t i) {
+        return F {}(lazy_value<T, To>(left, i), lazy_value<T, To>(right, i));
+    }
+};
+
+template<typename F, typename L, typename R>
+struct lazy_binary {
+    using value_type = lazy_promoted_type<L, R>;
+    using compute_value_type = result_t<F, lazy_compute_type<L, R>, lazy_compute_type<L, R>>;
+    using extent_type = broadcast_extent<typename L::extent_type, typename R::extent_type>;
+
+    template<typename To>
+    KERNEL_FLOAT_INLINE compute_value_type eval(size_t i) const {
+        return lazy_binary_eval<F, L, R>::template call<To>(left, right, i);
+    }
+
+    L left;
+    R right;
+};
+
+// `a * b + c` is contracted into `fma(a, b, c)`
+template<typename T, typename A, typename B, typename C>
+struct lazy_binary_eval<ops::add<T>, lazy_binary<ops::multiply<T>, A, B>, C> {
+    template<typename To>
+    KERNEL_FLOAT_INLINE static T
+    call(const lazy_binary<ops::multiply<T>, A, B>& left, const C& right, size_t i) {
+        return ops::fma<T> {}(
+            lazy_value<T, To>(left.left, i),
+            lazy_value<T, To>(left.right, i),
+            lazy_value<T, To>(right, i));
+    }
+};
+
+// `c + a * b` is contracted into `fma(a, b, c)`
+template<typename T, typename C, typename A, typename B>
+struct lazy_binary_eval<ops::add<T>, C, lazy_binary<ops::multiply<T>, A, B>> {
+    template<typename To>
+    KERNEL_FLOAT_INLINE static T
+    call(const C& left, const lazy_binary<ops::multiply<T>, A, B>& right, size_t i) {
+        return ops::fma<T> {}(
+            lazy_value<T, To>(right.left, i),
+            lazy_value<T, To>(right.right, i),
+            lazy_value<T, To>(left, i));
+    }
+};
+
+// `a * b + c * d` is contracted into `fma(a, b, c * d)`
+template<typename T, typename A, typename B, typename C, typename D>
+struct lazy_binary_eval<
+    ops::add<T>,
+    lazy_binary<ops::multiply<T>, A, B>,
+    lazy_binary<ops::multiply<T>, C, D>> {
+    template<typename To>
+    KERNEL_FLOAT_INLINE static T call(
+        const lazy_binary<ops::multiply<T>, A, B>& left,
+        const lazy_binary<ops::multiply<T>, C, D>& right,
+        size_t i) {
+        return ops::fma<T> {}(
+            lazy_value<T, To>(left.left, i),
+            lazy_value<T, To>(left.right, i),
+            lazy_value<T, To>(right, i));
+    }
+};
+
+// `a * b - c` is contracted into `fma(a, b, -c)`
+template<typename T, typename A, typename B, typename C>
+struct lazy_binary_eval<ops::subtract<T>, lazy_binary<ops::multiply<T>, A, B>, C> {
+    template<typename To>
+    KERNEL_FLOAT_INLINE static T
+    call(const lazy_binary<ops::multiply<T>, A, B>& left, const C& right, size_t i) {
+        return ops::fma<T> {}(
+            lazy_value<T, To>(left.left, i),
+            lazy_value<T, To>(left.right, i),
+            ops::negate<T> {}(lazy_value<T, To>(right, i)));
+    }
+};
+
+/**
+ * Evaluates all elements of the expression `X`. Each element is computed in the compute type of the expression and
+ * only rounded to its value type once at the very end.
+ */
+template<typename X>
+KERNEL_FLOAT_INLINE vector_storage<typename X::value_type, X::extent_type::value>
+lazy_eval(const X& expr) {
+    using E = typename X::extent_type;
+    using T = typename X::value_type;
+    vector_storage<T, E::value> result;
+
+#pragma unroll
+    for (size_t i = 0; i < E::value; i++) {
+        result.data()[i] = lazy_value<T, E>(expr, i);
+    }
+
+    return result;
+}
+
+}  // namespace detail
+
+/**
+ * A vector expression that has not been evaluated yet. See `lazy` on how to construct these expressions.
+ */
+template<typename X>
+struct lazy_expr {
+    using value_type = typename X::value_type;
+    using extent_type = typename X::extent_type;
+
+    /**
+     * Evaluates this expression and returns the result as a vector.
+     */
+    KERNEL_FLOAT_INLINE
+    vector<value_type, extent_type> eval() const {
+        return detail::lazy_eval(expr);
+    }
+
+    X expr;
+};
+
+template<typename X>
+struct into_vector_impl<lazy_expr<X>> {
+    using value_type = typename X::value_type;
+    using extent_type = typename X::extent_type;
+
+    KERNEL_FLOAT_INLINE
+    static vector_storage<value_type, extent_type::value> call(const lazy_expr<X>& input) {
+        return detail::lazy_eval(input.expr);
+    }
+};
+
+/**
+ * Wraps the given vector (or scalar) into a lazy expression. Arithmetic operators (`+`, `-`, `*`, `/`) on lazy
+ * expressions do not compute anything, they build an expression tree instead. The expression is evaluated in a
+ * single loop over the elements when it is converted to a vector (or by calling `eval()`).
+ *
+ * Compared to regular vector operators, this avoids materializing intermediate vectors and broadcast copies of
+ * scalars. Elements are only converted at the leaves of the expression, and the whole expression is computed in
+ * the compute type of its element type (see `compute_type_policy`) and rounded once at the end. Additionally, the
+ * patterns `a * b + c`, `c + a * b`, and `a * b - c` are contracted into a single `fma`, which means that the
+ * result can differ in the last bit from the non-lazy version. This is why lazy evaluation is opt-in.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 8> a, b, c;
+ * vec<float, 8> x = lazy(a) * b + c;  // Evaluates `fma(a[i], b[i], c[i])` for each element
+ * vec<float, 8> y = (lazy(a) * 2.0f - 1.0f) * c;  // No temporary vectors
+ * ```
+ */
+template<typename V>
+KERNEL_FLOAT_INLINE lazy_expr<detail::lazy_leaf_type<V>> lazy(const V& input) {
+    return {{into_vector_storage(input)}};
+}
+
+/**
+ * Evaluates the given lazy expression and returns the result as a vector.
+ */
+template<typename X>
+KERNEL_FLOAT_INLINE vector<typename X::value_type, typename X::extent_type>
+eval(const lazy_expr<X>& input) {
+    return input.eval();
+}
+
+#define KERNEL_FLOAT_DEFINE_LAZY_OP(NAME, OP)                                                   \
+    template<typename L, typename R, typename C = detail::lazy_compute_type<L, R>>          \
+    KERNEL_FLOAT_INLINE lazy_expr<detail::lazy_binary<ops::NAME<C>, L, R>> operator OP(         \
+        const lazy_expr<L>& left,                                                               \
+        const lazy_expr<R>& right) {                                                            \
+        return {{left.expr, right.expr}};                                                       \
+    }                                                                                           \
+    template<                                                                                   \
+        typename L,                                                                             \
+        typename R,                                                                             \
+        typename E,                                                                             \
+        typename Leaf = detail::lazy_leaf<R, E>,                                                \
+        typename C = detail::lazy_compute_type<L, Leaf>>                                    \
+    KERNEL_FLOAT_INLINE lazy_expr<detail::lazy_binary<ops::NAME<C>, L, Leaf>> operator OP(      \
+        const lazy_expr<L>& left,                                                               \
+        const vector<R, E>& right) {                                                            \
+        return {{left.expr, lazy(right).expr}};                                                 \
+    }                                                                                           \
+    template<                                                                                   \
+        typename L,                                                                             \
+        typename E,                                                                             \
+        typename R,                                                                             \
+        typename Leaf = detail::lazy_leaf<L, E>,                                                \
+        typename C = detail::lazy_compute_type<Leaf, R>>                                    \
+    KERNEL_FLOAT_INLINE lazy_expr<detail::lazy_binary<ops::NAME<C>, Leaf, R>> operator OP(      \
+        const vector<L, E>& left,                                                               \
+        const lazy_expr<R>& right) {                                                            \
+        return {{lazy(left).expr, right.expr}};                                                 \
+    }                                                                                           \
+    template<                                                                                   \
+        typename L,                                                                             \
+        typename R,                                                                             \
+        typename Leaf = detail::lazy_leaf_type<R>,                                              \
+        typename C = detail::lazy_compute_type<L, Leaf>>                                    \
+    KERNEL_FLOAT_INLINE lazy_expr<detail::lazy_binary<ops::NAME<C>, L, Leaf>> operator OP(      \
+        const lazy_expr<L>& left,                                                               \
+        const R& right) {                                                                       \
+        return {{left.expr, lazy(right).expr}};                                                 \
+    }                                                                                           \
+    template<                                                                                   \
+        typename L,                                                                             \
+        typename R,                                                                             \
+        typename Leaf = detail::lazy_leaf_type<L>,                                              \
+        typename C = detail::lazy_compute_type<Leaf, R>>                                    \
+    KERNEL_FLOAT_INLINE lazy_expr<detail::lazy_binary<ops::NAME<C>, Leaf, R>> operator OP(      \
+        const L& left,                                                                          \
+        const lazy_expr<R>& right) {                                                            \
+        return {{lazy(left).expr, right.expr}};                                                 \
+    }
+
+KERNEL_FLOAT_DEFINE_LAZY_OP(add, +)
+KERNEL_FLOAT_DEFINE_LAZY_OP(subtract, -)
+KERNEL_FLOAT_DEFINE_LAZY_OP(multiply, *)
+KERNEL_FLOAT_DEFINE_LAZY_OP(divide, /)
+
+}  // namespace kernel_float
+
+#endif  // KERNEL_FLOAT_LAZY_H
+#ifndef KERNEL_FLOAT_MATMUL_H
+#define KERNEL_FLOAT_MATMUL_H
+
+
+
+
+
+
+namespace kernel_float {
+namespace detail {
+
+/**
+ * The dimensions of the product of a matrix (or vector) of extent `A` with a matrix (or vector) of extent `B`.
+ */
+template<typename A, typename B>
+struct matmul_extent_helper {};
+
+// matrix-matrix
+template<size_t M, size_t K, size_t N>
+struct matmul_extent_helper<extent<M, K>, extent<K, N>> {
+    static constexpr size_t rows = M;
+    static constexpr size_t inner = K;
+    static constexpr size_t cols = N;
+    using type = extent<M, N>;
+};
+
+// matrix-vector
+template<size_t M, size_t K>
+struct matmul_extent_helper<extent<M, K>, extent<K>> {
+    static constexpr size_t rows = M;
+    static constexpr size_t inner = K;
+    static constexpr size_t cols = 1;
+    using type = extent<M>;
+};
+
+// vector-matrix
+template<size_t K, size_t N>
+struct matmul_extent_helper<extent<K>, extent<K, N>> {
+    static constexpr size_t rows = 1;
+    static constexpr size_t inner = K;
+    static constexpr size_t cols = N;
+    using type = extent<N>;
+};
+
+template<typename T, size_t M, size_t K, size_t N>
+struct matmul_impl {
+    KERNEL_FLOAT_INLINE static void call(T* result, const T* a, const T* b) {
+        // Outer product formulation: every step broadcasts a column of `a` and a row of `b` and accumulates
+        // them into `result` using FMAs. This keeps all `M * N` accumulators independent.
+#pragma unroll
+        for (size_t i = 0; i < M; i++) {
+#pragma unroll
+            for (size_t j = 0; j < N; j++) {
+                result[i * N + j] = ops::multiply<T> {}(a[i * K], b[j]);
+            }
+        }
+
+#pragma unroll
+        for (size_t k = 1; k < K; k++) {
+#pragma unroll
+            for (size_t i = 0; i < M; i++) {
+#pragma unroll
+                for (size_t j = 0; j < N; j++) {
+                    result[i * N + j] =
+                        ops::fma<T> {}(a[i * K + k], b[k * N + j], result[i * N + j]);
+                }
+            }
+        }
+    }
+};
+
+template<typename T, size_t M, size_t N>
+struct matmul_impl<T, M, 0, N> {
+    KERNEL_FLOAT_INLINE static void call(T* result, const T* a, const T* b) {
+#pragma unroll
+        for (size_t i = 0; i < M * N; i++) {
+            result[i] = T {};
+        }
+    }
+};
+}  // namespace detail
+
+template<typename A, typename B>
+using matmul_extent =
+    typename detail::matmul_extent_helper<vector_extent_type<A>, vector_extent_type<B>>::type;
+
+/**
+ * Computes the matrix product of ``a`` and ``b``. The arguments must be matrices of extent `extent<M, K>` and
+ * `extent<K, N>`, in which case the result has extent `extent<M, N>`. Either argument can also be a vector
+ * of `K` elements for a matrix-vector or vector-matrix product.
+ *
+ * The product is fully unrolled and computed using `M * N` independent FMAs per step, which makes this function
+ * suitable for small tiles held in registers (for example, 4x8 by 8x4).
+ *
+ * Example
+ * =======
+ * ```
+ * vector<float, extent<2, 3>> a = {1, 2, 3, 4, 5, 6};
+ * vector<float, extent<3, 2>> b = {1, 0, 0, 1, 1, 1};
+ * vector<float, extent<2, 2>> c = matmul(a, b);  // Returns [[4, 5], [10, 11]]
+ *
+ * vec<float, 3> x = {1, 1, 1};
+ * vec<float, 2> y = matmul(a, x);  // Returns [6, 15]
+ * ```
+ */
+template<typename A, typename B, typename T = promoted_vector_value_type<A, B>>
+KERNEL_FLOAT_INLINE vector<T, matmul_extent<A, B>> matmul(const A& a, const B& b) {
+    using helper = detail::matmul_extent_helper<vector_extent_type<A>, vector_extent_type<B>>;
+    static constexpr size_t M = helper::rows;
+    static constexpr size_t K = helper::inner;
+    static constexpr size_t N = helper::cols;
+
+    vector_storage<T, M * N> result;
+    detail::matmul_impl<T, M, K, N>::call(
+        result.data(),
+        convert_storage<T, M * K>(reshape<M * K>(a)).data(),
+        convert_storage<T, K * N>(reshape<K * N>(b)).data());
 
     return result;
 }
 
+/**
+ * Computes the outer product of the vectors ``a`` and ``b``. If ``a`` has `M` elements and ``b`` has `N`
+ * elements, the result is a matrix of extent `extent<M, N>` where element `(i, j)` equals `a[i] * b[j]`.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int, 2> a = {1, 2};
+ * vec<int, 3> b = {3, 4, 5};
+ * vector<int, extent<2, 3>> c = outer(a, b);  // Returns [[3, 4, 5], [6, 8, 10]]
+ * ```
+ */
+template<typename A, typename B, typename T = promoted_vector_value_type<A, B>>
+KERNEL_FLOAT_INLINE vector<T, extent<vector_extent<A>, vector_extent<B>>>
+outer(const A& a, const B& b) {
+    static constexpr size_t M = vector_extent<A>;
+    static constexpr size_t N = vector_extent<B>;
+
+    return zip_common(
+        ops::multiply<T> {},
+        reshape<M, 1>(convert_storage<T, M>(a)),
+        reshape<1, N>(convert_storage<T, N>(b)));
+}
+
 }  // namespace kernel_float
 
-#endif  //KERNEL_FLOAT_TRIOPS_H
+#endif  // KERNEL_FLOAT_MATMUL_H
 #ifndef KERNEL_FLOAT_VECTOR_H
 #define KERNEL_FLOAT_VECTOR_H
 
@@ -3481,7 +6216,7 @@ namespace kernel_float {
  * `vector<T, extent<N>, vector_storage<T, E>>`.
  *
  * @tparam T The type of the values stored within the vector.
- * @tparam E The size of this vector. Should be of type `extent<N>`.
+ * @tparam E The size of this vector. Should be of type `extent<N>` or, for multi-dimensional vectors, `extent<M, N>`.
  * @tparam S The object's storage class. Should be the type `vector_storage<T, E>`
  */
 template<typename T, typename E, class S>
@@ -3503,14 +6238,27 @@ struct vector: public S {
     vector(const value_type& input = {}) :
         storage_type(detail::broadcast_impl<T, extent<1>, E>::call(input)) {}
 
-    // For all other arguments, we convert it using `convert_storage` according to broadcast rules
-    template<typename U, enable_if_t<is_implicit_convertible<vector_value_type<U>, T>, int> = 0>
+    // For all other arguments, we convert it using `convert_storage` according to broadcast rules. The storage
+    // type is excluded since it has no shape of its own, which matters for multi-dimensional extents.
+    template<
+        typename U,
+        enable_if_t<
+            is_implicit_convertible<vector_value_type<U>, T>
+                && !is_same_type<decay_t<U>, storage_type>,
+            int> = 0>
     KERNEL_FLOAT_INLINE vector(U&& input) :
-        storage_type(convert_storage<T>(input, extent_type {})) {}
+        storage_type(detail::convert_impl<vector_value_type<U>, vector_extent_type<U>, T, E>::call(
+            into_vector_storage(input))) {}
 
-    template<typename U, enable_if_t<!is_implicit_convertible<vector_value_type<U>, T>, int> = 0>
+    template<
+        typename U,
+        enable_if_t<
+            !is_implicit_convertible<vector_value_type<U>, T>
+                && !is_same_type<decay_t<U>, storage_type>,
+            int> = 0>
     KERNEL_FLOAT_INLINE explicit vector(U&& input) :
-        storage_type(convert_storage<T>(input, extent_type {})) {}
+        storage_type(detail::convert_impl<vector_value_type<U>, vector_extent_type<U>, T, E>::call(
+            into_vector_storage(input))) {}
 
     // List of `N` (where N >= 2), simply pass forward to the storage
     template<
@@ -3831,11 +6579,37 @@ struct into_vector_impl<__half2> {
     }
 };
 
+// There is no native half-precision arithmetic on the host, so chains of operations are computed in float
+#if !KERNEL_FLOAT_IS_DEVICE
+template<>
+struct compute_type_policy<__half> {
+    using type = float;
+};
+#endif
+
 namespace detail {
 template<>
 struct allow_float_fallback<__half> {
     static constexpr bool value = true;
 };
+
+template<>
+struct rounding_traits<__half> {
+    static constexpr bool value = true;
+    static constexpr int digits = 11;
+
+    KERNEL_FLOAT_INLINE static __half next_up(__half input) {
+        __half_raw raw = input;
+        raw.x = next_float_bits<unsigned short>(raw.x, 0x8000, true);
+        return raw;
+    }
+
+    KERNEL_FLOAT_INLINE static __half next_down(__half input) {
+        __half_raw raw = input;
+        raw.x = next_float_bits<unsigned short>(raw.x, 0x8000, false);
+        return raw;
+    }
+};
 };  // namespace detail
 
 #if KERNEL_FLOAT_IS_DEVICE
@@ -3878,24 +6652,44 @@ KERNEL_FLOAT_FP16_UNARY_FUN(trunc, ::htrunc, ::h2trunc)
 KERNEL_FLOAT_FP16_UNARY_FUN(rcp, ::hrcp, ::h2rcp)
 
 #if KERNEL_FLOAT_IS_DEVICE
-#define KERNEL_FLOAT_FP16_BINARY_FUN(NAME, FUN1, FUN2)                              \
-    namespace ops {                                                                 \
-    template<>                                                                      \
-    struct NAME<__half> {                                                           \
-        KERNEL_FLOAT_INLINE __half operator()(__half left, __half right) const {    \
-            return FUN1(left, right);                                               \
-        }                                                                           \
-    };                                                                              \
-    }                                                                               \
-    namespace detail {                                                              \
-    template<>                                                                      \
-    struct apply_impl<ops::NAME<__half>, 2, __half, __half, __half> {               \
-        KERNEL_FLOAT_INLINE static void                                             \
-        call(ops::NAME<__half>, __half* result, const __half* a, const __half* b) { \
-            __half2 r = FUN2(__half2 {a[0], a[1]}, __half2 {b[0], b[1]});           \
-            result[0] = r.x, result[1] = r.y;                                       \
-        }                                                                           \
-    };                                                                              \
+#define KERNEL_FLOAT_FP16_BINARY_FUN(NAME, FUN1, FUN2)                                    \
+    namespace ops {                                                                       \
+    template<>                                                                            \
+    struct NAME<__half> {                                                                 \
+        KERNEL_FLOAT_INLINE __half operator()(__half left, __half right) const {          \
+            return FUN1(left, right);                                                     \
+        }                                                                                 \
+    };                                                                                    \
+    }                                                                                     \
+    namespace detail {                                                                    \
+    template<>                                                                            \
+    struct apply_impl<ops::NAME<__half>, 2, __half, __half, __half> {                     \
+        KERNEL_FLOAT_INLINE static void                                                   \
+        call(ops::NAME<__half>, __half* result, const __half* a, const __half* b) {       \
+            __half2 r = FUN2(__half2 {a[0], a[1]}, __half2 {b[0], b[1]});                 \
+            result[0] = r.x, result[1] = r.y;                                             \
+        }                                                                                 \
+    };                                                                                    \
+    template<>                                                                            \
+    struct apply_impl<apply_scalar_left<ops::NAME<__half>, __half>, 2, __half, __half> {  \
+        KERNEL_FLOAT_INLINE static void call(                                             \
+            apply_scalar_left<ops::NAME<__half>, __half> fun,                             \
+            __half* result,                                                               \
+            const __half* b) {                                                            \
+            __half2 r = FUN2(__half2half2(fun.value), __half2 {b[0], b[1]});              \
+            result[0] = r.x, result[1] = r.y;                                             \
+        }                                                                                 \
+    };                                                                                    \
+    template<>                                                                            \
+    struct apply_impl<apply_scalar_right<ops::NAME<__half>, __half>, 2, __half, __half> { \
+        KERNEL_FLOAT_INLINE static void call(                                             \
+            apply_scalar_right<ops::NAME<__half>, __half> fun,                            \
+            __half* result,                                                               \
+            const __half* a) {                                                            \
+            __half2 r = FUN2(__half2 {a[0], a[1]}, __half2half2(fun.value));              \
+            result[0] = r.x, result[1] = r.y;                                             \
+        }                                                                                 \
+    };                                                                                    \
     }
 #else
 #define KERNEL_FLOAT_FP16_BINARY_FUN(NAME, FUN1, FUN2)
@@ -4057,11 +6851,37 @@ struct into_vector_impl<__nv_bfloat162> {
     }
 };
 
+// Native bfloat16 arithmetic is only available on devices of compute capability 8.0 or higher
+#if KERNEL_FLOAT_CUDA_ARCH < 800
+template<>
+struct compute_type_policy<__nv_bfloat16> {
+    using type = float;
+};
+#endif
+
 namespace detail {
 template<>
 struct allow_float_fallback<__nv_bfloat16> {
     static constexpr bool value = true;
 };
+
+template<>
+struct rounding_traits<__nv_bfloat16> {
+    static constexpr bool value = true;
+    static constexpr int digits = 8;
+
+    KERNEL_FLOAT_INLINE static __nv_bfloat16 next_up(__nv_bfloat16 input) {
+        __nv_bfloat16_raw raw = input;
+        raw.x = next_float_bits<unsigned short>(raw.x, 0x8000, true);
+        return raw;
+    }
+
+    KERNEL_FLOAT_INLINE static __nv_bfloat16 next_down(__nv_bfloat16 input) {
+        __nv_bfloat16_raw raw = input;
+        raw.x = next_float_bits<unsigned short>(raw.x, 0x8000, false);
+        return raw;
+    }
+};
 };  // namespace detail
 
 #if KERNEL_FLOAT_IS_DEVICE
@@ -4129,6 +6949,38 @@ KERNEL_FLOAT_BF16_UNARY_FUN(rcp, ::hrcp, ::h2rcp)
             result[0] = r.x, result[1] = r.y;                                                     \
         }                                                                                         \
     };                                                                                            \
+    template<>                                                                                    \
+    struct apply_impl<                                                                            \
+        apply_scalar_left<ops::NAME<__nv_bfloat16>, __nv_bfloat16>,                               \
+        2,                                                                                        \
+        __nv_bfloat16,                                                                            \
+        __nv_bfloat16> {                                                                          \
+        KERNEL_FLOAT_INLINE static void call(                                                     \
+            apply_scalar_left<ops::NAME<__nv_bfloat16>, __nv_bfloat16> fun,                       \
+            __nv_bfloat16* result,                                                                \
+            const __nv_bfloat16* b) {                                                             \
+            __nv_bfloat162 r = FUN2(                                                              \
+                __bfloat162bfloat162(fun.value),                                                  \
+                __nv_bfloat162 {b[0], b[1]});                                                     \
+            result[0] = r.x, result[1] = r.y;                                                     \
+        }                                                                                         \
+    };                                                                                            \
+    template<>                                                                                    \
+    struct apply_impl<                                                                            \
+        apply_scalar_right<ops::NAME<__nv_bfloat16>, __nv_bfloat16>,                              \
+        2,                                                                                        \
+        __nv_bfloat16,                                                                            \
+        __nv_bfloat16> {                                                                          \
+        KERNEL_FLOAT_INLINE static void call(                                                     \
+            apply_scalar_right<ops::NAME<__nv_bfloat16>, __nv_bfloat16> fun,                      \
+            __nv_bfloat16* result,                                                                \
+            const __nv_bfloat16* a) {                                                             \
+            __nv_bfloat162 r = FUN2(                                                              \
+                __nv_bfloat162 {a[0], a[1]},                                                      \
+                __bfloat162bfloat162(fun.value));                                                 \
+            result[0] = r.x, result[1] = r.y;                                                     \
+        }                                                                                         \
+    };                                                                                            \
     }
 #else
 #define KERNEL_FLOAT_BF16_BINARY_FUN(NAME, FUN1, FUN2)
@@ -4351,6 +7203,47 @@ template<>
 struct allow_float_fallback<__nv_fp8_e5m2> {
     static constexpr bool value = true;
 };
+
+template<>
+struct rounding_traits<__nv_fp8_e4m3> {
+    static constexpr bool value = true;
+    static constexpr int digits = 4;
+
+    // There is no infinity for e4m3, so stepping beyond the largest value saturates.
+    KERNEL_FLOAT_INLINE static __nv_fp8_e4m3 step(__nv_fp8_e4m3 input, bool up) {
+        __nv_fp8_storage_t bits = next_float_bits<__nv_fp8_storage_t>(input.__x, 0x80, up);
+
+        if ((bits & 0x7F) != 0x7F) {
+            input.__x = bits;
+        }
+
+        return input;
+    }
+
+    KERNEL_FLOAT_INLINE static __nv_fp8_e4m3 next_up(__nv_fp8_e4m3 input) {
+        return step(input, true);
+    }
+
+    KERNEL_FLOAT_INLINE static __nv_fp8_e4m3 next_down(__nv_fp8_e4m3 input) {
+        return step(input, false);
+    }
+};
+
+template<>
+struct rounding_traits<__nv_fp8_e5m2> {
+    static constexpr bool value = true;
+    static constexpr int digits = 3;
+
+    KERNEL_FLOAT_INLINE static __nv_fp8_e5m2 next_up(__nv_fp8_e5m2 input) {
+        input.__x = next_float_bits<__nv_fp8_storage_t>(input.__x, 0x80, true);
+        return input;
+    }
+
+    KERNEL_FLOAT_INLINE static __nv_fp8_e5m2 next_down(__nv_fp8_e5m2 input) {
+        input.__x = next_float_bits<__nv_fp8_storage_t>(input.__x, 0x80, false);
+        return input;
+    }
+};
 }  // namespace detail
 }  // namespace kernel_float
 
@@ -4422,24 +7315,485 @@ KERNEL_FLOAT_FP8_CAST(__half)
 KERNEL_FLOAT_FP8_CAST2(__half, __nv_fp8_e4m3, __NV_E4M3)
 KERNEL_FLOAT_FP8_CAST2(__half, __nv_fp8_e5m2, __NV_E5M2)
 
-}  // namespace kernel_float
-#endif  // KERNEL_FLOAT_FP16_AVAILABLE
+}  // namespace kernel_float
+#endif  // KERNEL_FLOAT_FP16_AVAILABLE
+
+#if KERNEL_FLOAT_BF16_AVAILABLE
+
+
+namespace kernel_float {
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__nv_bfloat16, __nv_fp8_e4m3)
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__nv_bfloat16, __nv_fp8_e5m2)
+
+KERNEL_FLOAT_FP8_CAST(__nv_bfloat16)
+KERNEL_FLOAT_FP8_CAST2(__nv_bfloat16, __nv_fp8_e4m3, __NV_E4M3)
+KERNEL_FLOAT_FP8_CAST2(__nv_bfloat16, __nv_fp8_e5m2, __NV_E5M2)
+}  // namespace kernel_float
+#endif  // KERNEL_FLOAT_BF16_AVAILABLE
+
+#endif  // KERNEL_FLOAT_FP8_AVAILABLE
+#endif  // KERNEL_FLOAT_FP8_H
+#ifndef KERNEL_FLOAT_MINIFLOAT_H
+#define KERNEL_FLOAT_MINIFLOAT_H
+
+#include <cstring>
+
+
+
+
+namespace kernel_float {
+namespace detail {
+KERNEL_FLOAT_INLINE unsigned int float_to_bits(float value) {
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(float));
+    return bits;
+}
+
+KERNEL_FLOAT_INLINE float bits_to_float(unsigned int bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+
+/**
+ * Describes a floating-point format of at most 8 bits that is implemented in software. The format has
+ * `ExponentBits` exponent bits, `MantissaBits` mantissa bits, and the given exponent `Bias`. `NanCode` is the bit
+ * pattern of NaN (or -1 if the format has no NaN). None of the formats have infinities, thus conversions saturate
+ * to the largest finite value. Conversions operate directly on the bits of the `float` (rebiasing the exponent and
+ * rounding the mantissa to nearest even), so they do not call any math library functions.
+ */
+template<
+    int ExponentBits,
+    int MantissaBits,
+    int Bias,
+    bool IsSigned = true,
+    int NanCode = -1,
+    bool HasSubnormals = true>
+struct minifloat_format {
+    static constexpr int digits = MantissaBits + 1;
+    static constexpr unsigned int sign_bit = IsSigned ? 1u << (ExponentBits + MantissaBits) : 0u;
+    static constexpr unsigned int magnitude_mask = (1u << (ExponentBits + MantissaBits)) - 1;
+    static constexpr unsigned int max_code =
+        magnitude_mask - (NanCode == int(magnitude_mask) ? 1 : 0);
+
+    static constexpr float pow2(int e) {
+        return e == 0 ? 1.0f : (e > 0 ? 2.0f * pow2(e - 1) : 0.5f * pow2(e + 1));
+    }
+
+    static constexpr float max_value =
+        float((max_code & ((1u << MantissaBits) - 1)) | (1u << MantissaBits))
+        * pow2(int(max_code >> MantissaBits) - Bias - MantissaBits);
+
+    /**
+     * Returns the bit pattern of the next representable value above (if `up`) or below `bits`. Since there are no
+     * infinities, the largest and smallest values are returned unchanged. NaN is also returned unchanged.
+     */
+    KERNEL_FLOAT_INLINE static unsigned int next_code(unsigned int bits, bool up) {
+        unsigned int magnitude = bits & magnitude_mask;
+        bool negative = (bits & sign_bit) != 0;
+
+        if (int(bits) == NanCode) {
+            return bits;
+        }
+
+        if (!IsSigned) {
+            return up ? (bits < max_code ? bits + 1 : bits) : (bits > 0 ? bits - 1 : bits);
+        }
+
+        if (magnitude == 0) {
+            return up ? 1 : (sign_bit | 1);
+        }
+
+        // Towards zero, negative zero is avoided since its bit pattern might be NaN
+        if (negative == up) {
+            return magnitude > 1 ? bits - 1 : 0;
+        }
+
+        return magnitude < max_code ? bits + 1 : bits;
+    }
+
+    KERNEL_FLOAT_INLINE static float decode(unsigned int bits) {
+        if (int(bits) == NanCode) {
+            return bits_to_float(0x7FC00000u);
+        }
+
+        unsigned int sign = bits & sign_bit ? 0x80000000u : 0u;
+        unsigned int exponent = (bits & magnitude_mask) >> MantissaBits;
+        unsigned int mantissa = bits & ((1u << MantissaBits) - 1);
+
+        if (exponent == 0 && HasSubnormals) {
+            // Subnormals are multiples of the smallest subnormal, this product is exact
+            float value = float(mantissa) * pow2(1 - Bias - MantissaBits);
+            return bits_to_float(float_to_bits(value) | sign);
+        }
+
+        // Rebias the exponent and move the mantissa to the most significant bits of the float mantissa
+        int float_exponent = int(exponent) - Bias + 127;
+
+        if (float_exponent > 0) {
+            return bits_to_float(
+                sign | (unsigned(float_exponent) << 23) | (mantissa << (23 - MantissaBits)));
+        }
+
+        // Below the normal range of float (only for e8m0), the implicit leading one becomes part of a float subnormal
+        unsigned int significand = mantissa | (1u << MantissaBits);
+        return bits_to_float(sign | (significand << (22 - MantissaBits + float_exponent)));
+    }
+
+    KERNEL_FLOAT_INLINE static unsigned int encode(float input) {
+        if (input != input) {
+            return NanCode >= 0 ? unsigned(NanCode) : 0;
+        }
+
+        unsigned int input_bits = float_to_bits(input);
+        bool negative = (input_bits >> 31) != 0;
+        unsigned int code = 0;
+
+        if (negative && !IsSigned) {
+            code = 0;
+        } else if (bits_to_float(input_bits & 0x7FFFFFFFu) >= max_value) {
+            code = max_code;
+        } else {
+            unsigned int magnitude_bits = input_bits & 0x7FFFFFFFu;
+            int exponent_offset = Bias - 127;
+
+            // Float subnormals are normalized first, multiplying by 2^24 is exact
+            if (magnitude_bits < 0x800000u) {
+                magnitude_bits = float_to_bits(bits_to_float(magnitude_bits) * 16777216.0f);
+                exponent_offset -= 24;
+            }
+
+            // The exponent of `input`, rebiased to the exponent of this format
+            int exponent = int(magnitude_bits >> 23) + exponent_offset;
+            unsigned int fraction = magnitude_bits & 0x7FFFFFu;
+            unsigned int value = 0;
+            int shift = 32;
+
+            if (exponent >= (HasSubnormals ? 1 : 0)) {
+                // The exponent and mantissa are rounded together, so rounding up carries over into the exponent
+                value = (unsigned(exponent) << 23) | fraction;
+                shift = 23 - MantissaBits;
+            } else if (HasSubnormals) {
+                // Subnormal: shift the significand (including the implicit leading one) to the smallest subnormal
+                value = fraction | 0x800000u;
+                shift = 24 - MantissaBits - exponent;
+            }
+
+            // Round to nearest with ties to even. Values below half of the smallest subnormal become zero.
+            if (shift < 25) {
+                unsigned int round_bit = 1u << (shift - 1);
+                code = (value + round_bit - 1 + ((value >> shift) & 1)) >> shift;
+            }
+        }
+
+        // Negative zero might not exist if its bit pattern is used for NaN
+        if (negative && !(code == 0 && NanCode == int(sign_bit))) {
+            code |= sign_bit;
+        }
+
+        return code;
+    }
+};
+}  // namespace detail
+
+#define KERNEL_FLOAT_DEFINE_MINIFLOAT(NAME, ...)                                         \
+    struct NAME {                                                                        \
+        using format_type = detail::minifloat_format<__VA_ARGS__>;                       \
+                                                                                         \
+        NAME() = default;                                                                \
+                                                                                         \
+        KERNEL_FLOAT_INLINE                                                              \
+        explicit NAME(float value) :                                                     \
+            bits((unsigned char)format_type::encode(value)) {}                           \
+                                                                                         \
+        KERNEL_FLOAT_INLINE                                                              \
+        explicit operator float() const {                                                \
+            return format_type::decode(bits);                                            \
+        }                                                                                \
+                                                                                         \
+        unsigned char bits;                                                              \
+    };                                                                                   \
+                                                                                         \
+    namespace ops {                                                                      \
+    template<>                                                                           \
+    struct cast<float, NAME> {                                                           \
+        KERNEL_FLOAT_INLINE NAME operator()(float input) noexcept {                      \
+            return NAME(input);                                                          \
+        }                                                                                \
+    };                                                                                   \
+                                                                                         \
+    template<>                                                                           \
+    struct cast<NAME, float> {                                                           \
+        KERNEL_FLOAT_INLINE float operator()(NAME input) noexcept {                      \
+            return float(input);                                                         \
+        }                                                                                \
+    };                                                                                   \
+    }                                                                                    \
+                                                                                         \
+    namespace detail {                                                                   \
+    template<>                                                                           \
+    struct allow_float_fallback<NAME> {                                                  \
+        static constexpr bool value = true;                                              \
+    };                                                                                   \
+                                                                                         \
+    template<>                                                                           \
+    struct rounding_traits<NAME> {                                                       \
+        static constexpr bool value = true;                                              \
+        static constexpr int digits = NAME::format_type::digits;                         \
+                                                                                         \
+        KERNEL_FLOAT_INLINE static NAME next_up(NAME input) {                            \
+            input.bits = (unsigned char)NAME::format_type::next_code(input.bits, true);  \
+            return input;                                                                \
+        }                                                                                \
+                                                                                         \
+        KERNEL_FLOAT_INLINE static NAME next_down(NAME input) {                          \
+            input.bits = (unsigned char)NAME::format_type::next_code(input.bits, false); \
+            return input;                                                                \
+        }                                                                                \
+    };                                                                                   \
+    }                                                                                    \
+                                                                                         \
+    KERNEL_FLOAT_DEFINE_PROMOTED_FLOAT(NAME)                                             \
+    KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(float, NAME)                                       \
+    KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(double, NAME)
+
+/**
+ * 8-bit float with 4 exponent bits and 3 mantissa bits, without infinities or negative zero. NaN is `0x80`.
+ */
+KERNEL_FLOAT_DEFINE_MINIFLOAT(fp8_e4m3fnuz, 4, 3, 8, true, 0x80)
+
+/**
+ * 8-bit float with 5 exponent bits and 2 mantissa bits, without infinities or negative zero. NaN is `0x80`.
+ */
+KERNEL_FLOAT_DEFINE_MINIFLOAT(fp8_e5m2fnuz, 5, 2, 16, true, 0x80)
+
+/**
+ * 6-bit float (OCP MX) with 3 exponent bits and 2 mantissa bits, stored in the lower bits of a byte.
+ */
+KERNEL_FLOAT_DEFINE_MINIFLOAT(fp6_e3m2, 3, 2, 3)
+
+/**
+ * 6-bit float (OCP MX) with 2 exponent bits and 3 mantissa bits, stored in the lower bits of a byte.
+ */
+KERNEL_FLOAT_DEFINE_MINIFLOAT(fp6_e2m3, 2, 3, 1)
+
+/**
+ * 8-bit unsigned power of two (OCP MX scale format), representing `2^(bits - 127)`. NaN is `0xFF`.
+ */
+KERNEL_FLOAT_DEFINE_MINIFLOAT(fp8_e8m0, 8, 0, 127, false, 0xFF, false)
+
+}  // namespace kernel_float
+
+#if KERNEL_FLOAT_FP16_AVAILABLE
+
+
+namespace kernel_float {
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__half, fp8_e4m3fnuz)
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__half, fp8_e5m2fnuz)
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__half, fp6_e3m2)
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__half, fp6_e2m3)
+}  // namespace kernel_float
+#endif  // KERNEL_FLOAT_FP16_AVAILABLE
+
+#if KERNEL_FLOAT_BF16_AVAILABLE
+
+
+namespace kernel_float {
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__nv_bfloat16, fp8_e4m3fnuz)
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__nv_bfloat16, fp8_e5m2fnuz)
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__nv_bfloat16, fp6_e3m2)
+KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__nv_bfloat16, fp6_e2m3)
+}  // namespace kernel_float
+#endif  // KERNEL_FLOAT_BF16_AVAILABLE
+
+#endif  // KERNEL_FLOAT_MINIFLOAT_H
+#ifndef KERNEL_FLOAT_MIXED_H
+#define KERNEL_FLOAT_MIXED_H
+
+
+
+
+
+
+
+namespace kernel_float {
+
+/**
+ * Vector of `N` elements that is stored using type `U`, but behaves as a vector of type `T` in all computations.
+ * For example, a `mixed_vec<float, half, 8>` occupies the registers (and memory) of eight half-precision values,
+ * while all arithmetic on it is performed in single precision.
+ *
+ * Reading a `mixed_vec` (using `get()`, `operator[]`, or by passing it to any function that accepts vectors)
+ * converts the elements to `T`, which is exact whenever `U` is narrower than `T`. The result of a computation is
+ * of type `vec<T, N>` and is only rounded to `U` when it is explicitly committed using `commit` (or assignment).
+ * This is the value counterpart of `vector_ptr<T, N, U>`, which makes the same distinction for memory.
+ *
+ * Example
+ * =======
+ * ```
+ * mixed_vec<float, half, 8> acc;
+ * vec<float, 8> x = acc * 2.0f + 1.0f;  // Computed in float, no rounding to half
+ * acc.commit(x);  // Rounded to half exactly once
+ * acc += x;  // Same as `acc.commit(acc.get() + x)`
+ * ```
+ */
+template<typename T, typename U, size_t N>
+struct mixed_vec {
+    using value_type = T;
+    using storage_type = U;
+    using extent_type = extent<N>;
+
+    mixed_vec() = default;
+
+    /**
+     * Constructs a `mixed_vec` by converting the given values (or scalar, which is broadcast) to the storage type.
+     */
+    template<typename V, enable_if_t<!is_same_type<decay_t<V>, mixed_vec>, int> = 0>
+    KERNEL_FLOAT_INLINE explicit mixed_vec(const V& values) :
+        storage_(convert_storage<U, N>(values)) {}
+
+    /**
+     * Returns the number of elements in this vector.
+     */
+    KERNEL_FLOAT_INLINE
+    static constexpr size_t size() {
+        return N;
+    }
+
+    /**
+     * Returns the elements of this vector converted to the compute type `T`.
+     */
+    KERNEL_FLOAT_INLINE
+    vector<T, extent<N>> get() const {
+        return convert_storage<T, N>(storage_);
+    }
+
+    /**
+     * Returns the element at index `i` converted to the compute type `T`.
+     */
+    KERNEL_FLOAT_INLINE
+    T operator[](size_t i) const {
+        return ops::cast<U, T> {}(storage_[i]);
+    }
+
+    /**
+     * Rounds the given values (or scalar, which is broadcast) to the storage type `U` and stores them in this vector.
+     */
+    template<typename V>
+    KERNEL_FLOAT_INLINE void commit(const V& values) {
+        storage_ = convert_storage<U, N>(values);
+    }
+
+    /**
+     * Shorthand for `commit(values)`.
+     */
+    template<typename V, enable_if_t<!is_same_type<decay_t<V>, mixed_vec>, int> = 0>
+    KERNEL_FLOAT_INLINE mixed_vec& operator=(const V& values) {
+        commit(values);
+        return *this;
+    }
+
+    /**
+     * Returns the elements as they are stored, without any conversion. Use this to write them to memory.
+     */
+    KERNEL_FLOAT_INLINE
+    vector<U, extent<N>>& storage() {
+        return storage_;
+    }
+
+    /**
+     * Returns the elements as they are stored, without any conversion. Use this to write them to memory.
+     */
+    KERNEL_FLOAT_INLINE
+    const vector<U, extent<N>>& storage() const {
+        return storage_;
+    }
 
-#if KERNEL_FLOAT_BF16_AVAILABLE
+  private:
+    vector<U, extent<N>> storage_;
+};
 
+template<typename T, typename U, size_t N>
+struct into_vector_impl<mixed_vec<T, U, N>> {
+    using value_type = T;
+    using extent_type = extent<N>;
 
-namespace kernel_float {
-KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__nv_bfloat16, __nv_fp8_e4m3)
-KERNEL_FLOAT_DEFINE_PROMOTED_TYPE(__nv_bfloat16, __nv_fp8_e5m2)
+    KERNEL_FLOAT_INLINE
+    static vector_storage<T, N> call(const mixed_vec<T, U, N>& input) {
+        return input.get();
+    }
+};
+
+// Vector operators already accept a `mixed_vec` as their other operand. These overloads add the cases where neither
+// operand is a `vector`, and disambiguate the cases where the other operand is a `vector` or a `lazy_expr` (both of
+// which also define operators that accept any type as their other operand).
+#define KERNEL_FLOAT_DEFINE_MIXED_OP(OP)                                           \
+    template<typename L, typename LU, typename R, typename RU, size_t N>           \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const mixed_vec<L, LU, N>& left,                                           \
+        const mixed_vec<R, RU, N>& right) -> decltype(left.get() OP right.get()) { \
+        return left.get() OP right.get();                                          \
+    }                                                                              \
+    template<typename L, typename LU, size_t N, typename R, typename E>            \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const mixed_vec<L, LU, N>& left,                                           \
+        const vector<R, E>& right) -> decltype(left.get() OP right) {              \
+        return left.get() OP right;                                                \
+    }                                                                              \
+    template<typename L, typename E, typename R, typename RU, size_t N>            \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const vector<L, E>& left,                                                  \
+        const mixed_vec<R, RU, N>& right) -> decltype(left OP right.get()) {       \
+        return left OP right.get();                                                \
+    }                                                                              \
+    template<typename L, typename LU, size_t N, typename R>                        \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const mixed_vec<L, LU, N>& left,                                           \
+        const lazy_expr<R>& right) -> decltype(left.get() OP right) {              \
+        return left.get() OP right;                                                \
+    }                                                                              \
+    template<typename L, typename R, typename RU, size_t N>                        \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const lazy_expr<L>& left,                                                  \
+        const mixed_vec<R, RU, N>& right) -> decltype(left OP right.get()) {       \
+        return left OP right.get();                                                \
+    }                                                                              \
+    template<typename L, typename LU, size_t N, typename R>                        \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const mixed_vec<L, LU, N>& left,                                           \
+        const R& right) -> decltype(left.get() OP right) {                         \
+        return left.get() OP right;                                                \
+    }                                                                              \
+    template<typename L, typename R, typename RU, size_t N>                        \
+    KERNEL_FLOAT_INLINE auto operator OP(                                          \
+        const L& left,                                                             \
+        const mixed_vec<R, RU, N>& right) -> decltype(left OP right.get()) {       \
+        return left OP right.get();                                                \
+    }
+
+KERNEL_FLOAT_DEFINE_MIXED_OP(+)
+KERNEL_FLOAT_DEFINE_MIXED_OP(-)
+KERNEL_FLOAT_DEFINE_MIXED_OP(*)
+KERNEL_FLOAT_DEFINE_MIXED_OP(/)
+
+// The operation is computed in `T` and the result is rounded to the storage type once, like `commit(get() OP value)`.
+#define KERNEL_FLOAT_DEFINE_MIXED_ASSIGN_OP(OP, OP_ASSIGN)      \
+    template<typename T, typename U, size_t N, typename V>      \
+    KERNEL_FLOAT_INLINE mixed_vec<T, U, N>& operator OP_ASSIGN( \
+        mixed_vec<T, U, N>& left,                               \
+        const V& right) {                                       \
+        left.commit(left.get() OP right);                       \
+        return left;                                            \
+    }
+
+KERNEL_FLOAT_DEFINE_MIXED_ASSIGN_OP(+, +=)
+KERNEL_FLOAT_DEFINE_MIXED_ASSIGN_OP(-, -=)
+KERNEL_FLOAT_DEFINE_MIXED_ASSIGN_OP(*, *=)
+KERNEL_FLOAT_DEFINE_MIXED_ASSIGN_OP(/, /=)
 
-KERNEL_FLOAT_FP8_CAST(__nv_bfloat16)
-KERNEL_FLOAT_FP8_CAST2(__nv_bfloat16, __nv_fp8_e4m3, __NV_E4M3)
-KERNEL_FLOAT_FP8_CAST2(__nv_bfloat16, __nv_fp8_e5m2, __NV_E5M2)
 }  // namespace kernel_float
-#endif  // KERNEL_FLOAT_BF16_AVAILABLE
 
-#endif  // KERNEL_FLOAT_FP8_AVAILABLE
-#endif  // KERNEL_FLOAT_FP8_H
+#endif  // KERNEL_FLOAT_MIXED_H
 #ifndef KERNEL_FLOAT_PRELUDE_H
 #define KERNEL_FLOAT_PRELUDE_H
 
@@ -4566,6 +7920,537 @@ kconstant(T&&) -> kconstant<decay_t<T>>;
 }  // namespace kernel_float
 
 #endif
+#ifndef KERNEL_FLOAT_QUANTIZE_H
+#define KERNEL_FLOAT_QUANTIZE_H
+
+
+
+
+
+
+
+
+namespace kernel_float {
+
+namespace detail {
+/**
+ * The range of values that can be represented by the integer type `T`.
+ */
+template<typename T>
+struct quantize_limits {
+    static constexpr bool is_signed = T(-1) < T(0);
+    static constexpr T min = is_signed ? T(1ULL << (8 * sizeof(T) - 1)) : T(0);
+    static constexpr T max = T(~min);
+};
+}  // namespace detail
+
+namespace ops {
+template<typename R>
+struct quantize {
+    template<typename T, typename S, typename Z>
+    KERNEL_FLOAT_INLINE R operator()(T input, S scale, Z zero_point) {
+        using W = widest_promote_t<float, T, S>;
+        using limits = detail::quantize_limits<R>;
+
+        W x = cast<T, W> {}(input) / cast<S, W> {}(scale);
+        x = detail::round_to_integral<RoundingMode::NEAREST>(x) + cast<Z, W> {}(zero_point);
+
+        // Saturate to the range of `R`. This also maps NaN to the lowest value.
+        if (!(x > W(limits::min))) {
+            return limits::min;
+        }
+
+        if (x >= W(limits::max)) {
+            return limits::max;
+        }
+
+        return R(x);
+    }
+};
+
+template<typename R>
+struct dequantize {
+    template<typename T, typename S, typename Z>
+    KERNEL_FLOAT_INLINE R operator()(T input, S scale, Z zero_point) {
+        using W = widest_promote_t<float, R, S>;
+        W x = cast<T, W> {}(input) - cast<Z, W> {}(zero_point);
+        return cast<W, R> {}(x * cast<S, W> {}(scale));
+    }
+};
+}  // namespace ops
+
+/**
+ * Quantizes the elements of `input` to the integer type `R` (for example, `int8_t` or `uint8_t`) by computing
+ * `round(input / scale) + zero_point`. Rounding is to nearest with ties to even and values outside the range of
+ * `R` saturate to its minimum or maximum value.
+ *
+ * The `scale` and `zero_point` can be scalars (one scale for the entire vector) or vectors (one scale per
+ * element).
+ *
+ * Example
+ * =======
+ * ```
+ * vec<float, 4> input = {-1.0f, 0.25f, 0.5f, 100.0f};
+ * vec<int8_t, 4> q = quantize<int8_t>(input, 0.1f);  // returns [-10, 2, 5, 127]
+ * vec<uint8_t, 4> p = quantize<uint8_t>(input, 0.1f, 128);  // returns [118, 130, 133, 255]
+ * ```
+ */
+template<typename R, typename V, typename S, typename Z = int>
+KERNEL_FLOAT_INLINE map_type<ops::quantize<R>, V, S, Z>
+quantize(const V& input, const S& scale, const Z& zero_point = {}) {
+    return map(ops::quantize<R> {}, input, scale, zero_point);
+}
+
+/**
+ * Dequantizes the elements of `input` to type `R` by computing `(input - zero_point) * scale`. This is the
+ * inverse of `quantize`.
+ *
+ * Example
+ * =======
+ * ```
+ * vec<int8_t, 3> input = {-10, 2, 127};
+ * vec<float, 3> x = dequantize(input, 0.1f);  // returns [-1.0f, 0.2f, 12.7f]
+ * ```
+ */
+template<typename R = float, typename V, typename S, typename Z = int>
+KERNEL_FLOAT_INLINE map_type<ops::dequantize<R>, V, S, Z>
+dequantize(const V& input, const S& scale, const Z& zero_point = {}) {
+    return map(ops::dequantize<R> {}, input, scale, zero_point);
+}
+
+namespace detail {
+template<typename F, typename R, typename T, typename S, typename Z>
+KERNEL_FLOAT_INLINE void quantize_buffer_impl(
+    F fun,
+    R* dst,
+    const T* src,
+    size_t n,
+    const S* scales,
+    const Z* zero_points,
+    size_t channels,
+    size_t thread_index,
+    size_t thread_count) {
+    size_t channel = thread_index % channels;
+    size_t channel_step = thread_count % channels;
+
+    // Keep track of the channel incrementally to avoid a modulo for every element
+    for (size_t i = thread_index; i < n; i += thread_count) {
+        Z zero_point = zero_points != nullptr ? zero_points[channel] : Z {};
+        dst[i] = fun(src[i], scales[channel], zero_point);
+
+        channel += channel_step;
+        channel = channel >= channels ? channel - channels : channel;
+    }
+}
+}  // namespace detail
+
+/**
+ * Quantizes the ``n`` elements of the buffer ``src`` to type ``R`` and stores them in the buffer ``dst``, see
+ * `quantize`. The buffer is assumed to consist of ``channels`` interleaved channels (i.e., element ``i`` belongs
+ * to channel ``i % channels``) and each channel has its own scale and zero point. If ``zero_points`` is a null
+ * pointer, the zero points are zero. Use ``channels = 1`` to use a single scale for the entire buffer.
+ *
+ * The work can be split over multiple threads using ``thread_index`` and ``thread_count``, where each thread
+ * processes every ``thread_count``-th element.
+ *
+ * ```
+ * // Quantize RGB pixels using one scale and zero point per color channel
+ * float scales[3] = {0.02f, 0.03f, 0.01f};
+ * int zero_points[3] = {128, 120, 110};
+ * quantize_buffer(output, input, num_pixels * 3, scales, zero_points, 3);
+ * ```
+ */
+template<typename R, typename T, typename S, typename Z = int>
+KERNEL_FLOAT_INLINE void quantize_buffer(
+    R* dst,
+    const T* src,
+    size_t n,
+    const S* scales,
+    const Z* zero_points = nullptr,
+    size_t channels = 1,
+    size_t thread_index = 0,
+    size_t thread_count = 1) {
+    detail::quantize_buffer_impl(
+        ops::quantize<R> {},
+        dst,
+        src,
+        n,
+        scales,
+        zero_points,
+        channels,
+        thread_index,
+        thread_count);
+}
+
+/**
+ * Dequantizes the ``n`` elements of the buffer ``src`` to type ``R`` and stores them in the buffer ``dst``. This
+ * is the inverse of `quantize_buffer` and accepts the same per-channel ``scales`` and ``zero_points``.
+ */
+template<typename R, typename T, typename S, typename Z = int>
+KERNEL_FLOAT_INLINE void dequantize_buffer(
+    R* dst,
+    const T* src,
+    size_t n,
+    const S* scales,
+    const Z* zero_points = nullptr,
+    size_t channels = 1,
+    size_t thread_index = 0,
+    size_t thread_count = 1) {
+    detail::quantize_buffer_impl(
+        ops::dequantize<R> {},
+        dst,
+        src,
+        n,
+        scales,
+        zero_points,
+        channels,
+        thread_index,
+        thread_count);
+}
+
+namespace detail {
+/**
+ * Describes how a block of ``N`` elements of type `E` is loaded from and stored to memory by `block_scaled_ptr`.
+ * The default implementation is for integer types, where values are rounded to nearest and saturated.
+ */
+template<typename E>
+struct block_scaled_traits {
+    static constexpr size_t elements_per_item = 1;
+    static constexpr float max_value = float(quantize_limits<E>::max);
+
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static vector_storage<float, N> load(const E* ptr) {
+        return convert_storage<float, N>(read_aligned<N>(ptr));
+    }
+
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static void store(E* ptr, const vector_storage<float, N>& values) {
+        write_aligned<N>(ptr, quantize<E>(values, 1.0f));
+    }
+};
+
+template<typename E>
+struct block_scaled_float_traits {
+    static constexpr size_t elements_per_item = 1;
+
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static vector_storage<float, N> load(const E* ptr) {
+        return convert_storage<float, N>(read_aligned<N>(ptr));
+    }
+
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static void store(E* ptr, const vector_storage<float, N>& values) {
+        write_aligned<N>(ptr, convert_storage<E, N>(values));
+    }
+};
+
+template<typename P, bool RoundToIntegral>
+struct block_scaled_packed_traits {
+    static constexpr size_t elements_per_item = 2;
+
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static vector_storage<float, N> load(const P* ptr) {
+        return unpack<float>(read_aligned<N / 2>(ptr));
+    }
+
+    template<size_t N>
+    KERNEL_FLOAT_INLINE static void store(P* ptr, vector_storage<float, N> values) {
+        // `pack` truncates towards zero for integer formats, round to nearest first
+        if (RoundToIntegral) {
+#pragma unroll
+            for (size_t i = 0; i < N; i++) {
+                values.data()[i] = round_to_integral<RoundingMode::NEAREST>(values.data()[i]);
+            }
+        }
+
+        write_aligned<N / 2>(ptr, pack<P>(values));
+    }
+};
+
+#define KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(T, MAX_VALUE)         \
+    template<>                                                       \
+    struct block_scaled_traits<T>: block_scaled_float_traits<T> {    \
+        static constexpr float max_value = MAX_VALUE;                \
+    };
+
+KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(fp8_e4m3fnuz, fp8_e4m3fnuz::format_type::max_value)
+KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(fp8_e5m2fnuz, fp8_e5m2fnuz::format_type::max_value)
+KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(fp6_e3m2, fp6_e3m2::format_type::max_value)
+KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(fp6_e2m3, fp6_e2m3::format_type::max_value)
+
+template<>
+struct block_scaled_traits<int4x2>: block_scaled_packed_traits<int4x2, true> {
+    static constexpr float max_value = 7.0f;
+};
+
+template<>
+struct block_scaled_traits<uint4x2>: block_scaled_packed_traits<uint4x2, true> {
+    static constexpr float max_value = 15.0f;
+};
+
+template<>
+struct block_scaled_traits<fp4x2_e2m1>: block_scaled_packed_traits<fp4x2_e2m1, false> {
+    static constexpr float max_value = 6.0f;
+};
+}  // namespace detail
+
+/**
+ * A pointer to block-scaled data (for example, the MXFP8, MXFP4, or block-int8 formats), where every block of
+ * `BlockSize` consecutive elements of type `E` shares a single scale of type `S`. The elements are stored in the
+ * buffer ``data`` and the scales are stored in the buffer ``scales`` (one scale per block).
+ *
+ * Reading block ``i`` returns a `vec<T, BlockSize>` that has already been multiplied by the scale of the block.
+ * Writing block ``i`` computes the scale from the largest absolute value (amax) of the block, such that the amax
+ * maps onto the largest value representable by `E`, and stores both the scale and the scaled elements. If `S` has
+ * lower precision than float (for example, `fp8_e8m0`), the scale is rounded up and the elements are scaled using
+ * the rounded scale. For `fp8_e8m0`, this gives the scale ``2^ceil(log2(amax / max_value))``.
+ *
+ * `E` can be an integer type (e.g., ``int8_t``), one of the minifloat types (e.g., `fp8_e4m3fnuz`), ``__nv_fp8_e4m3``
+ * and ``__nv_fp8_e5m2``, or one of the packed types (`int4x2`, `uint4x2`, or `fp4x2_e2m1`), in which case every
+ * element of ``data`` holds two values. It is assumed that ``data`` is aligned to the size of a block.
+ *
+ * Example
+ * =======
+ * ```
+ * // MXFP4 weights: blocks of 32 values in fp4 (16 bytes) with one power-of-two scale
+ * block_scaled_ptr<float, 32, fp4x2_e2m1, fp8_e8m0> weights(data, scales);
+ * vec<float, 32> w = weights.read(block);
+ *
+ * // Block-int8: blocks of 32 values in int8 with one float scale
+ * block_scaled_ptr<float, 32, int8_t> output(data, scales);
+ * output.write(block, values);
+ * ```
+ */
+template<typename T, size_t BlockSize, typename E, typename S = float>
+struct block_scaled_ptr {
+    using value_type = decay_t<T>;
+    using element_type = decay_t<E>;
+    using scale_type = decay_t<S>;
+    using traits = detail::block_scaled_traits<element_type>;
+
+    static constexpr size_t block_size = BlockSize;
+    static constexpr size_t items_per_block = BlockSize / traits::elements_per_item;
+    static_assert(
+        BlockSize % traits::elements_per_item == 0,
+        "invalid block size for element type");
+
+    /**
+     * Default constructor sets the pointers to `NULL`.
+     */
+    block_scaled_ptr() = default;
+
+    /**
+     * Constructs a block-scaled pointer from the buffer of elements and the buffer of scales.
+     */
+    KERNEL_FLOAT_INLINE block_scaled_ptr(E* data, S* scales) : data_(data), scales_(scales) {}
+
+    /**
+     * Returns the scale of block ``index`` as a float.
+     */
+    KERNEL_FLOAT_INLINE float scale(size_t index) const {
+        return ops::cast<scale_type, float> {}(scales_[index]);
+    }
+
+    /**
+     * Reads block ``index`` and multiplies its elements by the scale of the block.
+     */
+    KERNEL_FLOAT_INLINE vector<value_type, extent<BlockSize>> read(size_t index) const {
+        vector_storage<float, BlockSize> values =
+            traits::template load<BlockSize>(data_ + index * items_per_block);
+        float s = scale(index);
+
+#pragma unroll
+        for (size_t i = 0; i < BlockSize; i++) {
+            values.data()[i] = values.data()[i] * s;
+        }
+
+        return convert_storage<value_type, BlockSize>(values);
+    }
+
+    /**
+     * Shorthand for `read(index)`.
+     */
+    KERNEL_FLOAT_INLINE vector<value_type, extent<BlockSize>> operator[](size_t index) const {
+        return read(index);
+    }
+
+    /**
+     * Writes ``values`` to block ``index``. The scale of the block is computed from the largest absolute value of
+     * ``values`` and is stored as well.
+     */
+    template<typename V>
+    KERNEL_FLOAT_INLINE void write(size_t index, const V& values) const {
+        vector_storage<float, BlockSize> items = convert_storage<float, BlockSize>(values);
+        float amax = kernel_float::amax(items);
+
+        // The scale is rounded up, since a scale that is rounded down would saturate the largest elements. The
+        // elements are scaled using the scale as it is stored.
+        scale_type s = ops::cast<float, scale_type, RoundingMode::UP> {}(amax / traits::max_value);
+        float actual_scale = ops::cast<scale_type, float> {}(s);
+        float inv_scale = actual_scale > 0.0f ? 1.0f / actual_scale : 0.0f;
+
+#pragma unroll
+        for (size_t i = 0; i < BlockSize; i++) {
+            items.data()[i] = items.data()[i] * inv_scale;
+        }
+
+        traits::template store<BlockSize>(data_ + index * items_per_block, items);
+        scales_[index] = s;
+    }
+
+    /**
+     * Gets the pointer to the elements.
+     */
+    KERNEL_FLOAT_INLINE E* get() const {
+        return data_;
+    }
+
+    /**
+     * Gets the pointer to the scales.
+     */
+    KERNEL_FLOAT_INLINE S* scales() const {
+        return scales_;
+    }
+
+  private:
+    E* data_ = nullptr;
+    S* scales_ = nullptr;
+};
+
+/**
+ * Returns the largest absolute value (amax) of the ``n`` elements of the buffer ``src``.
+ *
+ * The work can be split over multiple threads using ``thread_index`` and ``thread_count``, where each thread
+ * processes every ``thread_count``-th element. The results of the threads must then be combined by taking their
+ * maximum.
+ */
+template<typename T>
+KERNEL_FLOAT_INLINE float
+amax_buffer(const T* src, size_t n, size_t thread_index = 0, size_t thread_count = 1) {
+    float result = 0.0f;
+
+    for (size_t i = thread_index; i < n; i += thread_count) {
+        result = ::fmaxf(result, ::fabsf(ops::cast<T, float> {}(src[i])));
+    }
+
+    return result;
+}
+
+/**
+ * Converts the ``n`` elements of the buffer ``src`` to type ``R`` after multiplying them by ``scale`` and stores
+ * them in the buffer ``dst``. Returns the largest absolute value (amax) of the elements of ``src``, which is
+ * computed in the same pass and can be used to compute the scale of the next cast (see `delayed_scaling`).
+ *
+ * The work can be split over multiple threads in the same way as for `amax_buffer`.
+ *
+ * ```
+ * delayed_scaling<__nv_fp8_e4m3> scaling;
+ *
+ * // Every step: cast using the current scale and record the amax for the next step
+ * float scale = scaling.scale();
+ * scaling.update(cast_scaled_buffer(output, input, n, scale));
+ * ```
+ */
+template<typename R, typename T>
+KERNEL_FLOAT_INLINE float cast_scaled_buffer(
+    R* dst,
+    const T* src,
+    size_t n,
+    float scale,
+    size_t thread_index = 0,
+    size_t thread_count = 1) {
+    float result = 0.0f;
+
+    for (size_t i = thread_index; i < n; i += thread_count) {
+        float value = ops::cast<T, float> {}(src[i]);
+        result = ::fmaxf(result, ::fabsf(value));
+        dst[i] = ops::cast<float, R> {}(value * scale);
+    }
+
+    return result;
+}
+
+/**
+ * Computes the scale for casting to the reduced-precision type `E` (for example, ``__nv_fp8_e4m3``) from the
+ * history of the amax of the last `HistoryLength` steps ("delayed scaling"). The scale maps the largest amax in
+ * the history onto the largest value representable by `E`, so values are only clipped if the amax grows faster
+ * than the history can follow.
+ *
+ * Example
+ * =======
+ * ```
+ * delayed_scaling<__nv_fp8_e4m3, 16> scaling;
+ *
+ * float scale = scaling.scale();  // 1.0 until an amax has been recorded
+ * float amax = cast_scaled_buffer(output, input, n, scale);
+ * scaling.update(amax);
+ *
+ * // The original values are `output[i] / scale`
+ * ```
+ */
+template<typename E, size_t HistoryLength = 16>
+struct delayed_scaling {
+    static_assert(HistoryLength > 0, "the history length cannot be zero");
+    static constexpr float max_value = detail::block_scaled_traits<decay_t<E>>::max_value;
+
+    /**
+     * Records the amax of the current step, replacing the oldest entry of the history.
+     */
+    KERNEL_FLOAT_INLINE void update(float amax) {
+        history_[position_] = amax;
+        position_ = position_ + 1 < HistoryLength ? position_ + 1 : 0;
+    }
+
+    /**
+     * Returns the largest amax in the history.
+     */
+    KERNEL_FLOAT_INLINE float amax() const {
+        float result = 0.0f;
+
+#pragma unroll
+        for (size_t i = 0; i < HistoryLength; i++) {
+            result = ::fmaxf(result, history_[i]);
+        }
+
+        return result;
+    }
+
+    /**
+     * Returns the factor by which values should be multiplied before casting them to `E`. Returns one if the
+     * history is empty (or contains only zeros or non-finite values).
+     */
+    KERNEL_FLOAT_INLINE float scale() const {
+        float a = amax();
+        return a > 0.0f && ::isfinite(a) ? max_value / a : 1.0f;
+    }
+
+    /**
+     * Returns the factor by which values should be multiplied after casting them back from `E`. This is the
+     * inverse of `scale`.
+     */
+    KERNEL_FLOAT_INLINE float inverse_scale() const {
+        return 1.0f / scale();
+    }
+
+  private:
+    float history_[HistoryLength] = {};
+    size_t position_ = 0;
+};
+
+}  // namespace kernel_float
+
+#if KERNEL_FLOAT_FP8_AVAILABLE
+
+
+namespace kernel_float {
+namespace detail {
+KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(__nv_fp8_e4m3, 448.0f)
+KERNEL_FLOAT_DEFINE_BLOCK_SCALED_FLOAT(__nv_fp8_e5m2, 57344.0f)
+}  // namespace detail
+}  // namespace kernel_float
+#endif  // KERNEL_FLOAT_FP8_AVAILABLE
+
+#endif  // KERNEL_FLOAT_QUANTIZE_H
 #ifndef KERNEL_FLOAT_TILING_H
 #define KERNEL_FLOAT_TILING_H
 
@@ -146,3 +146,54 @@ struct creation_tests {
 };
 
 REGISTER_TEST_CASE("into_vec and make_vec", creation_tests, int, float)
+
+struct map_inplace_tests {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        kf::vec<T, 4> x = {T(1), T(2), T(3), T(4)};
+
+        kf::map_inplace(kf::ops::multiply<T> {}, x, x);
+        ASSERT_EQ(x, kf::make_vec(T(1), T(4), T(9), T(16)));
+
+        // Scalar arguments and arguments of a different type
+        kf::map_inplace(kf::ops::subtract<T> {}, x, T(1));
+        ASSERT_EQ(x, kf::make_vec(T(0), T(3), T(8), T(15)));
+        kf::map_inplace(kf::ops::add<T> {}, x, kf::make_vec(1, 2, 3, 4));
+        ASSERT_EQ(x, kf::make_vec(T(1), T(5), T(11), T(19)));
+
+        // Broadcasting of multi-dimensional arguments
+        kf::vector<T, kf::extent<2, 2>> m = kf::reshape<2, 2>(x);
+        kf::vector<T, kf::extent<2, 1>> col = {T(1), T(10)};
+        kf::map_inplace(kf::ops::add<T> {}, m, col);
+        ASSERT_EQ(m, (kf::vector<T, kf::extent<2, 2>> {T(2), T(6), T(21), T(29)}));
+
+        // Compound assignment is performed in place
+        x *= T(2);
+        ASSERT_EQ(x, kf::make_vec(T(2), T(10), T(22), T(38)));
+    }
+};
+
+REGISTER_TEST_CASE("map_inplace", map_inplace_tests, int, float, double)
+
+struct large_vector_tests {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        // Vectors longer than `KERNEL_FLOAT_UNROLL_LIMIT` are processed by loops over chunks
+        static constexpr size_t N = KERNEL_FLOAT_UNROLL_LIMIT + 3;
+        kf::vec<T, N> x = kf::range<T, N>();
+
+        kf::vec<T, N> y = x * T(2) + T(1);
+        ASSERT(equals(y[0], T(1)) && equals(y[N - 1], T(2 * N - 1)));
+        ASSERT_EQ(kf::sum(x), T(N * (N - 1) / 2));
+        ASSERT_EQ(kf::max(x), T(N - 1));
+
+        kf::vec<double, N> z = kf::cast<double>(x);
+        ASSERT(z[N - 1] == double(N - 1));
+
+        T buffer[N];
+        kf::write_aligned<1>(buffer, y);
+        ASSERT_EQ((kf::read_aligned<1, N>(buffer)), y);
+    }
+};
+
+REGISTER_TEST_CASE("large vectors", large_vector_tests, int, float, double)
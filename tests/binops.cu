@@ -49,6 +49,19 @@ struct binops_tests {
         c = a != b;
         ASSERT(equals(from_bool(x[I] != y[I]), c[I]) && ...);
 
+        // Scalar operands are applied without broadcasting them first
+        c = a - y[0];
+        ASSERT(equals(T(x[I] - y[0]), c[I]) && ...);
+
+        c = y[0] - a;
+        ASSERT(equals(T(y[0] - x[I]), c[I]) && ...);
+
+        c = y[0] * a;
+        ASSERT(equals(T(y[0] * x[I]), c[I]) && ...);
+
+        c = a < y[0];
+        ASSERT(equals(from_bool(x[I] < y[0]), c[I]) && ...);
+
         // Assignment
         c = a;
         c += b;
@@ -139,4 +152,32 @@ struct cross_test {
 };
 
 REGISTER_TEST_CASE("cross product", cross_test, float, double)
-REGISTER_TEST_CASE_GPU("cross product", cross_test, __half, __nv_bfloat16)
\ No newline at end of file
+REGISTER_TEST_CASE_GPU("cross product", cross_test, __half, __nv_bfloat16)
+
+struct math_policy_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        kf::vec<T, 2> a = {T(3), T(1)};
+        kf::vec<T, 2> b = {T(7), T(4)};
+        kf::vec<T, 2> expected = {T(3) / T(7), T(0.25)};
+
+        // The precise policy is correctly rounded, even if KERNEL_FLOAT_FAST_MATH is enabled. The expected values do
+        // not use kernel_float, since `kf::sqrt` follows the default policy.
+        ASSERT_EQ(kf::divide(kf::precise_policy {}, a, b), expected);
+        ASSERT_EQ(kf::zip_common(kf::precise_policy {}, kf::ops::divide<T> {}, a, b), expected);
+        kf::vec<T, 2> expected_sqrt = {::sqrt(T(7)), T(2)};
+        ASSERT_EQ(kf::map(kf::precise_policy {}, kf::ops::sqrt<T> {}, b), expected_sqrt);
+
+        // The fast-math policy is only accurate up to a few ulps
+        kf::vec<T, 2> c = kf::divide(kf::fast_math_policy {}, a, b);
+        kf::vec<T, 2> d = kf::divide(kf::fast_math_policy {}, a, T(7));
+        ASSERT(kf::all(kf::abs(c - expected) <= T(1e-6)));
+        ASSERT(kf::all(kf::abs(d - a / T(7)) <= T(1e-6)));
+        ASSERT_EQ(kf::exp(kf::fast_math_policy {}, a), kf::fast_exp(a));
+
+        static_assert(kf::is_math_policy<kf::fast_math_policy>, "");
+        static_assert(!kf::is_math_policy<kf::ops::divide<T>>, "");
+    }
+};
+
+REGISTER_TEST_CASE("math policies", math_policy_test, float, double)
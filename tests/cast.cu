@@ -57,3 +57,88 @@ REGISTER_TEST_CASE(
     double)
 
 REGISTER_TEST_CASE_GPU("type cast", cast_test, __half, __nv_bfloat16)
+
+struct rounding_cast_test {
+    template<kf::RoundingMode M, typename R, typename T>
+    __host__ __device__ R round(T input) {
+        return kf::ops::cast<T, R, M> {}(input);
+    }
+
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        using kf::RoundingMode;
+        using ivec = kf::vec<int, 8>;
+        constexpr int digits = kf::detail::rounding_traits<T>::digits;
+
+        kf::vec<T, 8> input = {
+            T(-2.5),
+            T(-1.5),
+            T(-0.5),
+            T(0.5),
+            T(1.5),
+            T(2.5),
+            T(1.25),
+            T(-1.75)};
+
+        ASSERT_EQ((kf::cast<int, RoundingMode::DOWN>(input)), ivec(-3, -2, -1, 0, 1, 2, 1, -2));
+        ASSERT_EQ((kf::cast<int, RoundingMode::UP>(input)), ivec(-2, -1, 0, 1, 2, 3, 2, -1));
+        ASSERT_EQ((kf::cast<int, RoundingMode::NEAREST>(input)), ivec(-2, -2, 0, 0, 2, 2, 1, -2));
+        ASSERT_EQ(
+            (kf::cast<int, RoundingMode::TOWARD_ZERO>(input)),
+            ivec(-2, -1, 0, 0, 1, 2, 1, -1));
+
+        // Integers that are halfway between two values of type `T`
+        long long big = (1LL << digits) + 1;
+        T lower = T(double(big - 1));
+        T upper = T(double(big + 1));
+
+        ASSERT_EQ((round<RoundingMode::DOWN, T>(big)), lower);
+        ASSERT_EQ((round<RoundingMode::UP, T>(big)), upper);
+        ASSERT_EQ((round<RoundingMode::NEAREST, T>(big)), lower);
+        ASSERT_EQ((round<RoundingMode::TOWARD_ZERO, T>(big)), lower);
+        ASSERT_EQ((round<RoundingMode::DOWN, T>(-big)), T(-upper));
+        ASSERT_EQ((round<RoundingMode::UP, T>(-big)), T(-lower));
+
+        // Doubles that are one and a half ulp above one
+        if (digits < 53) {
+            double x = 1.0 + 3.0 * ::ldexp(1.0, -digits);
+            T one_ulp = T(1.0 + ::ldexp(1.0, 1 - digits));
+            T two_ulp = T(1.0 + ::ldexp(1.0, 2 - digits));
+
+            ASSERT_EQ((round<RoundingMode::DOWN, T>(x)), one_ulp);
+            ASSERT_EQ((round<RoundingMode::UP, T>(x)), two_ulp);
+            ASSERT_EQ((round<RoundingMode::NEAREST, T>(x)), two_ulp);
+            ASSERT_EQ((round<RoundingMode::TOWARD_ZERO, T>(x)), one_ulp);
+            ASSERT_EQ((round<RoundingMode::DOWN, T>(-x)), T(-two_ulp));
+            ASSERT_EQ((round<RoundingMode::UP, T>(-x)), T(-one_ulp));
+            ASSERT_EQ((round<RoundingMode::NEAREST, T>(1.0 + ::ldexp(1.0, -digits))), T(1.0));
+        }
+    }
+};
+
+REGISTER_TEST_CASE("rounding cast", rounding_cast_test, float, double)
+REGISTER_TEST_CASE_GPU("rounding cast", rounding_cast_test, __half, __nv_bfloat16)
+
+struct stochastic_cast_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        kf::vec<T, 4> input = {T(2.0), T(2.25), T(-2.75), T(-3.0)};
+        kf::vec<int, 4> total = {0, 0, 0, 0};
+
+        for (unsigned int seed = 0; seed < 1000; seed++) {
+            kf::vec<int, 4> result = kf::cast_stochastic<int>(input, seed);
+
+            ASSERT(result[0] == 2);
+            ASSERT(result[1] == 2 || result[1] == 3);
+            ASSERT(result[2] == -3 || result[2] == -2);
+            ASSERT(result[3] == -3);
+            total += result;
+        }
+
+        // The average should be close to the input
+        ASSERT(total[1] >= 2200 && total[1] <= 2300);
+        ASSERT(total[2] >= -2800 && total[2] <= -2700);
+    }
+};
+
+REGISTER_TEST_CASE("stochastic cast", stochastic_cast_test, float, double)
@@ -77,10 +77,11 @@ struct equals_helper<__nv_bfloat16> {
     }
 };
 
-template<typename T, size_t N>
-struct equals_helper<kf::vec<T, N>> {
-    static __host__ __device__ bool call(const kf::vec<T, N>& left, const kf::vec<T, N>& right) {
-        for (int i = 0; i < N; i++) {
+template<typename T, typename E>
+struct equals_helper<kf::vector<T, E>> {
+    static __host__ __device__ bool
+    call(const kf::vector<T, E>& left, const kf::vector<T, E>& right) {
+        for (int i = 0; i < E::value; i++) {
             if (!equals_helper<T>::call(left[i], right[i])) {
                 return false;
             }
@@ -221,6 +222,13 @@ struct generator_value<__nv_bfloat16> {
         return __nv_bfloat16(generator_value<float>::call(seed));
     }
 };
+
+template<typename T>
+struct generator_value<T, std::void_t<typename T::format_type>> {
+    __host__ __device__ static T call(uint64_t seed) {
+        return T(generator_value<float>::call(seed));
+    }
+};
 }  // namespace detail
 
 template<typename T = int>
@@ -266,6 +274,11 @@ DEFINE_TYPE_NAME(__half)
 DEFINE_TYPE_NAME(__nv_bfloat16)
 DEFINE_TYPE_NAME(float)
 DEFINE_TYPE_NAME(double)
+DEFINE_TYPE_NAME(kf::fp8_e4m3fnuz)
+DEFINE_TYPE_NAME(kf::fp8_e5m2fnuz)
+DEFINE_TYPE_NAME(kf::fp6_e3m2)
+DEFINE_TYPE_NAME(kf::fp6_e2m3)
+DEFINE_TYPE_NAME(kf::fp8_e8m0)
 
 template<typename T>
 struct type_sequence {};
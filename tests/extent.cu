@@ -0,0 +1,52 @@
+#include "common.h"
+
+struct extent_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        using matrix = kf::vector<T, kf::extent<2, 3>>;
+        static_assert(kf::extent<2, 3>::value == 6, "");
+        static_assert(kf::extent<2, 3>::rank == 2, "");
+        static_assert(sizeof(matrix) == 6 * sizeof(T), "");
+
+        matrix m = {T(1), T(2), T(3), T(4), T(5), T(6)};
+        ASSERT(equals(m[4], T(5)));
+
+        // Columns (extent<2, 1>) and rows (extent<1, 3> or extent<3>) broadcast against the matrix
+        kf::vector<T, kf::extent<2, 1>> col = {T(10), T(20)};
+        kf::vector<T, kf::extent<1, 3>> row = {T(1), T(2), T(3)};
+        kf::vec<T, 3> flat_row = {T(1), T(2), T(3)};
+
+        matrix a = m + col;
+        ASSERT_EQ(a, (matrix {T(11), T(12), T(13), T(24), T(25), T(26)}));
+
+        matrix b = m * row;
+        ASSERT_EQ(b, (matrix {T(1), T(4), T(9), T(4), T(10), T(18)}));
+        ASSERT_EQ(m * flat_row, b);
+
+        // Outer product
+        kf::vector<T, kf::extent<2, 3>> outer = col * row;
+        ASSERT_EQ(outer, (matrix {T(10), T(20), T(30), T(20), T(40), T(60)}));
+        ASSERT_EQ((kf::broadcast<2, 3>(col)), (matrix {T(10), T(10), T(10), T(20), T(20), T(20)}));
+
+        // Reshape between shapes with the same number of elements
+        kf::vec<T, 6> flat = kf::reshape<6>(m);
+        ASSERT_EQ(flat, (kf::vec<T, 6> {T(1), T(2), T(3), T(4), T(5), T(6)}));
+        kf::vector<T, kf::extent<3, 2>> tall = kf::reshape<3, 2>(flat);
+        ASSERT(equals(tall[1], T(2)) && equals(tall[5], T(6)));
+
+        // Per-axis reductions keep the reduced dimension
+        kf::vector<T, kf::extent<1, 3>> col_sums = kf::reduce_axis<0>(kf::ops::add<T> {}, m);
+        kf::vector<T, kf::extent<2, 1>> row_max = kf::reduce_axis<1>(kf::ops::max<T> {}, m);
+        ASSERT_EQ(col_sums, (kf::vector<T, kf::extent<1, 3>> {T(5), T(7), T(9)}));
+        ASSERT_EQ(row_max, (kf::vector<T, kf::extent<2, 1>> {T(3), T(6)}));
+        ASSERT_EQ(kf::sum(m), T(21));
+
+        // Three dimensions
+        kf::vector<T, kf::extent<2, 2, 2>> cube = kf::reshape<2, 2, 2>(kf::range<T, 8>());
+        kf::vector<T, kf::extent<2, 1, 2>> middle = kf::reduce_axis<1>(kf::ops::add<T> {}, cube);
+        ASSERT_EQ(middle, (kf::vector<T, kf::extent<2, 1, 2>> {T(2), T(4), T(10), T(12)}));
+        ASSERT_EQ(cube - middle, (cube - kf::broadcast<2, 2, 2>(middle)));
+    }
+};
+
+REGISTER_TEST_CASE("extent", extent_test, int, float, double)
@@ -44,4 +44,171 @@ struct select_tests {
         ASSERT_EQ(x.select(4, 2), kf::make_vec(data[4], data[2]));
         ASSERT_EQ(x.select(4, 2, 7), kf::make_vec(data[4], data[2], data[7]));
     }
-};
\ No newline at end of file
+};
+
+struct shuffle_tests {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        kf::vec<T, 4> x = {T(0), T(1), T(2), T(3)};
+        kf::vec<T, 2> y = {T(4), T(5)};
+
+        ASSERT_EQ((kf::shuffle<3, 2, 1, 0>(x)), (kf::vec<T, 4> {T(3), T(2), T(1), T(0)}));
+        ASSERT_EQ((kf::shuffle<1, 1>(x)), (kf::vec<T, 2> {T(1), T(1)}));
+        ASSERT_EQ((kf::shuffle<2>(x)), (kf::vec<T, 1> {T(2)}));
+        ASSERT_EQ((kf::shuffle<0, 0, 0, 0, 0, 0>(T(7))), (kf::vec<T, 6> {T(7)}));
+
+        // Two inputs: indices refer to the concatenation of both vectors
+        ASSERT_EQ((kf::shuffle<0, 4, 1, 5>(x, y)), (kf::vec<T, 4> {T(0), T(4), T(1), T(5)}));
+        ASSERT_EQ((kf::shuffle<5, 3>(x, y)), (kf::vec<T, 2> {T(5), T(3)}));
+        ASSERT_EQ((kf::shuffle<1, 0>(x, 1)), (kf::vec<T, 2> {T(1), T(0)}));
+    }
+};
+
+REGISTER_TEST_CASE("shuffle", shuffle_tests, int, float, double)
+
+struct lookup_tests {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        kf::vec<T, 4> table = {T(0), T(10), T(20), T(30)};
+
+        kf::vec<int, 6> indices = {3, 0, 1, 1, 2, 3};
+        ASSERT_EQ(
+            kf::lookup(table, indices),
+            (kf::vec<T, 6> {T(30), T(0), T(10), T(10), T(20), T(30)}));
+
+        // Indices wrap around the size of the table
+        kf::vec<unsigned int, 2> wrapped = {4, 7};
+        ASSERT_EQ(kf::lookup(table, wrapped), (kf::vec<T, 2> {T(0), T(30)}));
+        ASSERT_EQ(kf::lookup(table, 2), (kf::vec<T, 1> {T(20)}));
+
+        // Negative indices wrap around as well, for any size of the table
+        kf::vec<int, 3> negative = {-1, -4, -6};
+        ASSERT_EQ(kf::lookup(table, negative), (kf::vec<T, 3> {T(30), T(0), T(20)}));
+        kf::vec<T, 3> small_table = {T(0), T(10), T(20)};
+        ASSERT_EQ(kf::lookup(small_table, negative), (kf::vec<T, 3> {T(20), T(20), T(0)}));
+
+        kf::vec<int, 4> reverse = {3, 2, 1, 0};
+        ASSERT_EQ(kf::permute(table, reverse), (kf::vec<T, 4> {T(30), T(20), T(10), T(0)}));
+        ASSERT_EQ(kf::permute(kf::permute(table, reverse), reverse), table);
+    }
+};
+
+REGISTER_TEST_CASE("lookup", lookup_tests, int, float, double)
+
+struct slicing_tests {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        kf::vec<T, 6> x = {T(0), T(1), T(2), T(3), T(4), T(5)};
+
+        ASSERT_EQ((kf::slice<1, 4>(x)), kf::make_vec(T(1), T(2), T(3)));
+        ASSERT_EQ((kf::slice<0, 6>(x)), x);
+
+        kf::vec<kf::vec<T, 3>, 2> halves = kf::split<2>(x);
+        ASSERT_EQ(halves[0], kf::make_vec(T(0), T(1), T(2)));
+        ASSERT_EQ(halves[1], kf::make_vec(T(3), T(4), T(5)));
+        ASSERT_EQ(kf::flatten(halves), x);
+
+        kf::vec<kf::vec<T, 3>, 2> parts = kf::deinterleave(x);
+        ASSERT_EQ(parts[0], kf::make_vec(T(0), T(2), T(4)));
+        ASSERT_EQ(parts[1], kf::make_vec(T(1), T(3), T(5)));
+        ASSERT_EQ(kf::interleave(parts[0], parts[1]), x);
+        ASSERT_EQ(kf::deinterleave<3>(x)[1], kf::make_vec(T(1), T(4)));
+
+        ASSERT_EQ(kf::rotate<2>(x), kf::make_vec(T(2), T(3), T(4), T(5), T(0), T(1)));
+        ASSERT_EQ(kf::rotate<-1>(x), kf::make_vec(T(5), T(0), T(1), T(2), T(3), T(4)));
+        ASSERT_EQ(kf::rotate<6>(x), x);
+        ASSERT_EQ(kf::reverse(x), kf::make_vec(T(5), T(4), T(3), T(2), T(1), T(0)));
+
+        // Vectors longer than the predefined index sequences
+        kf::vec<T, 24> y = kf::range<T, 24>();
+        ASSERT_EQ((kf::slice<20, 23>(y)), kf::make_vec(T(20), T(21), T(22)));
+        ASSERT_EQ(kf::rotate<5>(y)[19], T(0));
+        ASSERT_EQ(kf::reverse(y)[0], T(23));
+        ASSERT_EQ(kf::reverse(kf::reverse(y)), y);
+        ASSERT_EQ(kf::interleave(y, y)[47], T(23));
+    }
+};
+
+REGISTER_TEST_CASE("slicing", slicing_tests, int, float, double)
+
+struct sort_tests {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        {
+            kf::vec<T, 1> x = {T(3.0)};
+            ASSERT_EQ(kf::sort(x), x);
+            ASSERT_EQ(kf::median(x), T(3.0));
+        }
+
+        {
+            kf::vec<T, 5> x = {T(5.0), T(0.0), T(2.0), T(1.0), T(0.0)};
+            kf::vec<T, 5> expected = {T(0.0), T(0.0), T(1.0), T(2.0), T(5.0)};
+            ASSERT_EQ(kf::sort(x), expected);
+            ASSERT_EQ(kf::median(x), T(1.0));
+        }
+
+        {
+            kf::vec<T, 8> x = {T(7.0), T(3.0), T(6.0), T(1.0), T(0.0), T(4.0), T(2.0), T(5.0)};
+            kf::vec<T, 8> expected = {T(0.0), T(1.0), T(2.0), T(3.0), T(4.0), T(5.0), T(6.0), T(7.0)};
+            ASSERT_EQ(kf::sort(x), expected);
+            ASSERT_EQ(kf::median(x), T(3.0));
+        }
+
+        {
+            kf::vec<T, 3> keys = {T(3.0), T(1.0), T(2.0)};
+            kf::vec<int, 3> values = {10, 20, 30};
+            ASSERT_EQ(kf::sort_by_key(keys, values), kf::make_vec(20, 30, 10));
+        }
+    }
+};
+
+REGISTER_TEST_CASE("sort", sort_tests, int, float, double)
+
+struct top_k_tests {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        {
+            kf::vec<T, 5> x = {T(5.0), T(0.0), T(2.0), T(1.0), T(7.0)};
+            kf::top_k_result<T, 2> result = kf::top_k<2>(x);
+            ASSERT_EQ(result.values, kf::make_vec(T(7.0), T(5.0)));
+            ASSERT_EQ(result.indices, kf::make_vec(4, 0));
+        }
+
+        {
+            T data[10] = {
+                T(3.0),
+                T(9.0),
+                T(1.0),
+                T(8.0),
+                T(0.0),
+                T(4.0),
+                T(7.0),
+                T(2.0),
+                T(6.0),
+                T(5.0)};
+
+            kf::top_k_result<T, 3> result = kf::top_k<3>(data, 10);
+            ASSERT_EQ(result.values, kf::make_vec(T(9.0), T(8.0), T(7.0)));
+            ASSERT_EQ(result.indices, kf::make_vec(1, 3, 6));
+
+            auto even = kf::top_k<3>(data, 10, 0, 2);
+            auto odd = kf::top_k<3>(data, 10, 1, 2);
+            result = kf::merge_top_k(even, odd);
+            ASSERT_EQ(result.values, kf::make_vec(T(9.0), T(8.0), T(7.0)));
+            ASSERT_EQ(result.indices, kf::make_vec(1, 3, 6));
+
+            // Results of the vector and the pointer overload can be merged
+            kf::vec<T, 3> head = {data[0], data[1], data[2]};
+            result = kf::merge_top_k(kf::top_k<3>(head), kf::top_k<3>(data, 10, 3));
+            ASSERT_EQ(result.values, kf::make_vec(T(9.0), T(8.0), T(7.0)));
+            ASSERT_EQ(result.indices, kf::make_vec(1, 3, 6));
+
+            result = kf::top_k<3>(data, 2);
+            ASSERT_EQ(result.values[0], T(9.0));
+            ASSERT_EQ(result.values[1], T(3.0));
+            ASSERT_EQ(result.indices, kf::make_vec(1, 0, -1));
+        }
+    }
+};
+
+REGISTER_TEST_CASE("top k", top_k_tests, int, float, double)
@@ -0,0 +1,53 @@
+#include "common.h"
+
+struct lazy_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        kf::vec<T, 4> a = {T(1), T(2), T(3), T(4)};
+        kf::vec<T, 4> b = {T(2), T(0), T(1), T(3)};
+        kf::vec<T, 4> c = {T(1), T(1), T(2), T(2)};
+
+        // Contracted into an fma
+        kf::vec<T, 4> x = kf::lazy(a) * b + c;
+        ASSERT_EQ(x, a * b + c);
+        ASSERT_EQ(kf::eval(c + kf::lazy(a) * b), a * b + c);
+        ASSERT_EQ(kf::eval(kf::lazy(a) * b - c), a * b - c);
+        ASSERT_EQ(kf::eval(kf::lazy(a) * b + kf::lazy(c) * a), a * b + c * a);
+
+        // Scalars and vectors of a different type are only converted at the leaves
+        kf::vec<T, 4> y = (kf::lazy(a) * T(2) - 1) / c;
+        ASSERT_EQ(y, (a * T(2) - 1) / c);
+        kf::vec<double, 4> z = kf::lazy(a) + kf::vec<double, 4>(0.5);
+        ASSERT_EQ(z, kf::make_vec(1.5, 2.5, 3.5, 4.5));
+
+        // Broadcasting of multi-dimensional leaves
+        kf::vector<T, kf::extent<2, 1>> col = {T(10), T(20)};
+        kf::vector<T, kf::extent<2, 2>> m = kf::lazy(col) + kf::reshape<2, 2>(a);
+        ASSERT_EQ(m, (kf::vector<T, kf::extent<2, 2>> {T(11), T(12), T(23), T(24)}));
+
+        // Lazy expressions can be passed anywhere a vector is expected
+        ASSERT_EQ(kf::sum(kf::lazy(a) * b), T(2 + 0 + 3 + 12));
+    }
+};
+
+REGISTER_TEST_CASE("lazy", lazy_test, int, float, double)
+
+struct lazy_widening_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        // `1 + 2^-12` is not representable in half nor bfloat16
+        kf::vec<T, 2> a = {T(1), T(-1)};
+        kf::vec<T, 2> b = {T(1.0f / 4096), T(1.0f / 4096)};
+
+        // Rounding after every operation loses `b` entirely
+        ASSERT_EQ((a + b) - a, (kf::vec<T, 2> {T(0), T(0)}));
+
+        // On the host, the whole expression is computed in float and only rounded at the end
+        using C = kf::compute_type<T>;
+        static_assert(std::is_same<C, float>::value, "half types should be computed as float");
+        kf::vec<T, 2> x = (kf::lazy(a) + b) - a;
+        ASSERT_EQ(x, b);
+    }
+};
+
+REGISTER_TEST_CASE_CPU("lazy widening", lazy_widening_test, __half, __nv_bfloat16)
@@ -0,0 +1,53 @@
+#include "common.h"
+
+struct matmul_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        kf::vector<T, kf::extent<2, 3>> a = {T(1), T(2), T(3), T(4), T(5), T(6)};
+        kf::vector<T, kf::extent<3, 2>> b = {T(1), T(0), T(0), T(1), T(1), T(1)};
+
+        kf::vector<T, kf::extent<2, 2>> c = kf::matmul(a, b);
+        ASSERT_EQ(c, (kf::vector<T, kf::extent<2, 2>> {T(4), T(5), T(10), T(11)}));
+
+        // Matrix-vector and vector-matrix products
+        kf::vec<T, 3> x = {T(1), T(1), T(2)};
+        ASSERT_EQ(kf::matmul(a, x), (kf::vec<T, 2> {T(9), T(21)}));
+
+        kf::vec<T, 2> y = {T(1), T(-1)};
+        ASSERT_EQ(kf::matmul(y, a), (kf::vec<T, 3> {T(-3), T(-3), T(-3)}));
+
+        // Identity
+        kf::vector<T, kf::extent<3, 3>> eye =
+            {T(1), T(0), T(0), T(0), T(1), T(0), T(0), T(0), T(1)};
+        ASSERT_EQ(kf::matmul(a, eye), a);
+
+        // A 4x8 by 8x4 tile equals the sum of outer products of the columns and rows
+        kf::vector<T, kf::extent<4, 8>> p = kf::reshape<4, 8>(kf::range<T, 32>());
+        kf::vector<T, kf::extent<8, 4>> q = kf::reshape<8, 4>(kf::range<T, 32>() - T(8));
+        kf::vector<T, kf::extent<4, 4>> expected = T(0);
+
+        for (int k = 0; k < 8; k++) {
+            kf::vec<T, 4> column = {p[k], p[8 + k], p[16 + k], p[24 + k]};
+            kf::vec<T, 4> row = {q[4 * k], q[4 * k + 1], q[4 * k + 2], q[4 * k + 3]};
+            expected = expected + kf::outer(column, row);
+        }
+
+        ASSERT_EQ(kf::matmul(p, q), expected);
+    }
+};
+
+REGISTER_TEST_CASE("matmul", matmul_test, int, float, double)
+
+struct outer_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        kf::vec<T, 2> a = {T(1), T(2)};
+        kf::vec<T, 3> b = {T(3), T(4), T(5)};
+
+        kf::vector<T, kf::extent<2, 3>> c = kf::outer(a, b);
+        ASSERT_EQ(c, (kf::vector<T, kf::extent<2, 3>> {T(3), T(4), T(5), T(6), T(8), T(10)}));
+        ASSERT_EQ(kf::outer(a, T(2)), (kf::vector<T, kf::extent<2, 1>> {T(2), T(4)}));
+    }
+};
+
+REGISTER_TEST_CASE("outer", outer_test, int, float, double)
@@ -201,6 +201,15 @@ struct vector_ptr_test {
             ptr.at(1) += T(1.0);
             auto g = ptr[1];
             ASSERT_EQ_ALL(g[I], T(1338.0));
+
+            ptr.at(1).apply(kf::ops::subtract<T> {}, T(338.0));
+            auto h = ptr[1];
+            ASSERT_EQ_ALL(h[I], T(1000.0));
+
+            // The scalar is wider than `T`, so the result is converted back to `T` when it is written
+            ptr.at(1) += 1.0;
+            auto k = ptr[1];
+            ASSERT_EQ_ALL(k[I], T(1001.0));
         }
     }
 };
@@ -213,4 +222,53 @@ REGISTER_TEST_CASE_GPU(
     float,
     double,
     __half,
-    __nv_bfloat16)
\ No newline at end of file
+    __nv_bfloat16)
+
+struct convert_buffer_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T>) {
+        struct alignas(32) input_type {
+            T data[40];
+        };
+
+        struct alignas(32) output_type {
+            float data[40];
+        };
+
+        input_type input;
+        for (int i = 0; i < 40; i++) {
+            input.data[i] = T(double(i));
+        }
+
+        // Aligned and unaligned variants of both buffers
+        for (int src_offset = 0; src_offset < 3; src_offset++) {
+            for (int dst_offset = 0; dst_offset < 3; dst_offset++) {
+                output_type output;
+                for (int i = 0; i < 40; i++) {
+                    output.data[i] = -1.0f;
+                }
+
+                kf::convert_buffer(output.data + dst_offset, input.data + src_offset, 35);
+
+                for (int i = 0; i < 35; i++) {
+                    ASSERT_EQ(output.data[dst_offset + i], float(src_offset + i));
+                }
+
+                ASSERT_EQ(output.data[dst_offset + 35], -1.0f);
+            }
+        }
+
+        // Split the work over multiple "threads"
+        output_type output;
+        for (int thread_index = 0; thread_index < 3; thread_index++) {
+            kf::convert_buffer(output.data + 1, input.data, 37, thread_index, 3);
+        }
+
+        for (int i = 0; i < 37; i++) {
+            ASSERT_EQ(output.data[i + 1], float(i));
+        }
+    }
+};
+
+REGISTER_TEST_CASE("convert buffer", convert_buffer_test, int, float, double)
+REGISTER_TEST_CASE_GPU("convert buffer", convert_buffer_test, __half, __nv_bfloat16)
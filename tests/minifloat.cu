@@ -0,0 +1,79 @@
+#include "common.h"
+
+struct minifloat_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        using format = typename T::format_type;
+
+        // Every bit pattern (except NaN) converts to float and back
+        for (unsigned int bits = 0; bits <= (format::sign_bit | format::magnitude_mask); bits++) {
+            T x;
+            x.bits = (unsigned char)bits;
+            float value = float(x);
+
+            if (value == value) {
+                ASSERT(T(value).bits == bits);
+            }
+        }
+
+        // Values outside the range saturate
+        ASSERT(float(T(3e38f)) == format::max_value);
+        ASSERT(float(T(-3e38f)) == (format::sign_bit != 0 ? -format::max_value : float(T(0.0f))));
+
+        // Vectors of these types support casts and arithmetic through float
+        kf::vec<float, 3> input = {1.0f, 2.0f, 0.5f};
+        kf::vec<T, 3> a = kf::cast<T>(input);
+        kf::vec<float, 3> b = kf::cast<float>(a * a);
+        ASSERT_EQ(b, (kf::vec<float, 3> {1.0f, 4.0f, 0.25f}));
+    }
+};
+
+REGISTER_TEST_CASE(
+    "minifloat",
+    minifloat_test,
+    kf::fp8_e4m3fnuz,
+    kf::fp8_e5m2fnuz,
+    kf::fp6_e3m2,
+    kf::fp6_e2m3,
+    kf::fp8_e8m0)
+
+struct minifloat_rounding_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        // Round to nearest, ties to even
+        ASSERT(float(kf::fp8_e4m3fnuz(1.0625f)) == 1.0f);
+        ASSERT(float(kf::fp8_e4m3fnuz(1.1875f)) == 1.25f);
+        ASSERT(float(kf::fp6_e2m3(1.0625f)) == 1.0f);
+        ASSERT(float(kf::fp6_e3m2(0.09375f)) == 0.125f);
+
+        // Subnormals round to nearest even as well (the smallest subnormal of e4m3fnuz is 2^-10)
+        ASSERT(float(kf::fp8_e4m3fnuz(0.00146484375f)) == 0.001953125f);
+        ASSERT(float(kf::fp8_e4m3fnuz(0.00048828125f)) == 0.0f);
+
+        // FNUZ formats have no negative zero, 0x80 is NaN
+        ASSERT(kf::fp8_e4m3fnuz(-0.0f).bits == 0x00);
+        ASSERT(kf::fp8_e5m2fnuz(NAN).bits == 0x80);
+        ASSERT(float(kf::fp8_e5m2fnuz(1e10f)) == 57344.0f);
+
+        // e8m0 are powers of two
+        ASSERT(float(kf::fp8_e8m0(1.0f)) == 1.0f);
+        ASSERT(float(kf::fp8_e8m0(0.25f)) == 0.25f);
+        ASSERT(kf::fp8_e8m0(1.0f).bits == 127);
+
+        // Directed rounding steps to the neighboring value, but saturates at the largest value
+        using e8m0_up = kf::ops::cast<float, kf::fp8_e8m0, kf::RoundingMode::UP>;
+        using e8m0_down = kf::ops::cast<float, kf::fp8_e8m0, kf::RoundingMode::DOWN>;
+        using e4m3_up = kf::ops::cast<float, kf::fp8_e4m3fnuz, kf::RoundingMode::UP>;
+        using e4m3_down = kf::ops::cast<float, kf::fp8_e4m3fnuz, kf::RoundingMode::DOWN>;
+        ASSERT(float(e8m0_up {}(1.25f)) == 2.0f);
+        ASSERT(float(e8m0_down {}(1.75f)) == 1.0f);
+        ASSERT(float(e4m3_down {}(-1.0625f)) == -1.125f);
+        ASSERT(float(e4m3_up {}(1e10f)) == 240.0f);
+
+        // Float subnormals round to the two smallest values 2^-127 and 2^-126
+        ASSERT(kf::fp8_e8m0(5.877471754e-39f).bits == 0);
+        ASSERT(kf::fp8_e8m0(1.0e-38f).bits == 1);
+    }
+};
+
+REGISTER_TEST_CASE("minifloat rounding", minifloat_rounding_test, float)
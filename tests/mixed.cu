@@ -0,0 +1,49 @@
+#include "common.h"
+
+struct mixed_vec_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        using mixed = kf::mixed_vec<float, T, 4>;
+        static_assert(sizeof(mixed) == sizeof(kf::vec<T, 4>), "should only store T");
+
+        mixed a(kf::make_vec(1.0f, 2.0f, 3.0f, 4.0f));
+        ASSERT_EQ(a.get(), kf::make_vec(1.0f, 2.0f, 3.0f, 4.0f));
+        ASSERT_EQ(a.storage(), (kf::vec<T, 4> {T(1), T(2), T(3), T(4)}));
+        ASSERT(equals(a[2], 3.0f));
+
+        // Computations are performed in float
+        kf::vec<float, 4> x = a * 0.5f + a;
+        ASSERT_EQ(x, kf::make_vec(1.5f, 3.0f, 4.5f, 6.0f));
+        ASSERT_EQ(a + a, kf::make_vec(2.0f, 4.0f, 6.0f, 8.0f));
+        ASSERT_EQ((kf::vec<float, 4>(1) - a), kf::make_vec(0.0f, -1.0f, -2.0f, -3.0f));
+        ASSERT(equals(kf::sum(a), 10.0f));
+
+        // Intermediate results are not rounded, `1 + 2^-12` is not representable in half nor bfloat16
+        kf::vec<float, 4> y = (a + 1.0f / 4096) - a;
+        ASSERT_EQ(y, (kf::vec<float, 4>(1.0f / 4096)));
+
+        // Only committing rounds the values to the storage type
+        a.commit(a + 1.0f / 4096);
+        ASSERT_EQ(a.get(), kf::make_vec(1.0f, 2.0f, 3.0f, 4.0f));
+        a = x;
+        ASSERT_EQ(a.storage(), (kf::vec<T, 4> {T(1.5), T(3), T(4.5), T(6)}));
+
+        // Compound assignment computes in float and rounds once
+        a += 1.0f / 4096;
+        ASSERT_EQ(a.get(), kf::make_vec(1.5f, 3.0f, 4.5f, 6.0f));
+        a *= 2.0f;
+        a -= kf::make_vec(1.0f, 2.0f, 3.0f, 4.0f);
+        a /= 2;
+        ASSERT_EQ(a.get(), kf::make_vec(1.0f, 2.0f, 3.0f, 4.0f));
+
+        // Mixing with lazy expressions, on either side
+        kf::vec<float, 4> z = kf::lazy(x) * a + 1.0f;
+        ASSERT_EQ(z, kf::make_vec(2.5f, 7.0f, 14.5f, 25.0f));
+        z = a - kf::lazy(x);
+        ASSERT_EQ(z, kf::make_vec(-0.5f, -1.0f, -1.5f, -2.0f));
+        a += kf::lazy(x) * 2.0f;
+        ASSERT_EQ(a.get(), kf::make_vec(4.0f, 8.0f, 12.0f, 16.0f));
+    }
+};
+
+REGISTER_TEST_CASE("mixed precision vector", mixed_vec_test, __half, __nv_bfloat16)
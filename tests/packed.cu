@@ -0,0 +1,55 @@
+#include "common.h"
+
+struct packed_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        kf::vec<T, 8> values = {T(0), T(1), T(-1), T(7), T(-8), T(3), T(20), T(-20)};
+
+        // int4
+        kf::vec<kf::int4x2, 4> a = kf::pack<kf::int4x2>(values);
+        ASSERT(a[0].bits == 0x10 && a[1].bits == 0x7F && a[2].bits == 0x38 && a[3].bits == 0x87);
+        ASSERT_EQ(kf::unpack<T>(a), (kf::vec<T, 8> {0, 1, -1, 7, -8, 3, 7, -8}));
+
+        // uint4
+        kf::vec<kf::uint4x2, 4> b = kf::pack<kf::uint4x2>(values);
+        ASSERT_EQ(kf::unpack<T>(b), (kf::vec<T, 8> {0, 1, 0, 7, 0, 3, 15, 0}));
+
+        // Values outside the range of `int` saturate as well
+        kf::vec<float, 4> large = {1e10f, -1e10f, NAN, 6.9f};
+        ASSERT_EQ(kf::unpack<T>(kf::pack<kf::int4x2>(large)), (kf::vec<T, 4> {7, -8, -8, 6}));
+        ASSERT_EQ(kf::unpack<T>(kf::pack<kf::uint4x2>(large)), (kf::vec<T, 4> {15, 0, 0, 6}));
+
+        // fp4 e2m1
+        kf::vec<float, 8> reals = {0.25f, 0.75f, -1.25f, 1.75f, 2.5f, 3.5f, 5.0f, -100.0f};
+        kf::vec<kf::fp4x2_e2m1, 4> c = kf::pack<kf::fp4x2_e2m1>(reals);
+        ASSERT_EQ(kf::unpack<T>(c), (kf::vec<T, 8> {0.0, 1.0, -1.0, 2.0, 2.0, 4.0, 4.0, -6.0}));
+
+        // All 16 codes round-trip
+        using fp4x2 = kf::fp4x2_e2m1;
+        kf::vec<fp4x2, 8> codes = {
+            fp4x2 {0x10},
+            fp4x2 {0x32},
+            fp4x2 {0x54},
+            fp4x2 {0x76},
+            fp4x2 {0x98},
+            fp4x2 {0xBA},
+            fp4x2 {0xDC},
+            fp4x2 {0xFE}};
+        kf::vec<float, 16> decoded = kf::unpack<float>(codes);
+        ASSERT_EQ(decoded[5], 3.0f);
+        ASSERT_EQ(decoded[7], 6.0f);
+        ASSERT_EQ(decoded[9], -0.5f);
+
+        kf::vec<fp4x2, 8> encoded = kf::pack<fp4x2>(decoded);
+        for (int i = 0; i < 8; i++) {
+            ASSERT(encoded[i].bits == codes[i].bits);
+        }
+
+        // Read and write through memory
+        alignas(4) kf::int4x2 buffer[4];
+        kf::write_packed(buffer, values);
+        ASSERT_EQ((kf::read_packed<T, 8>(buffer)), kf::unpack<T>(a));
+    }
+};
+
+REGISTER_TEST_CASE("packed 4-bit types", packed_test, int, float, double)
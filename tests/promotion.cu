@@ -4,6 +4,18 @@
 #define CHECK_PROMOTION(A, B, C) \
     CHECK(std::is_same<decltype(kf::vec<A, 2>() + kf::vec<B, 2>()), kf::vec<C, 2>>::value);
 
+// Check the promotion of two floating-point types, which depends on `KERNEL_FLOAT_PROMOTION_POLICY`. These match
+// the tables generated by `docs/guides/generate_promotion_table.py` for each policy.
+#if KERNEL_FLOAT_PROMOTION_POLICY == KERNEL_FLOAT_PROMOTE_NARROWEST
+#define CHECK_FLOAT_PROMOTION(A, B, WIDEST, NARROWEST) \
+    CHECK_PROMOTION(A, B, NARROWEST)                   \
+    CHECK(std::is_same<kf::widest_promote_t<A, B>, WIDEST>::value);
+#else
+#define CHECK_FLOAT_PROMOTION(A, B, WIDEST, NARROWEST) \
+    CHECK_PROMOTION(A, B, WIDEST)                      \
+    CHECK(std::is_same<kf::widest_promote_t<A, B>, WIDEST>::value);
+#endif
+
 TEST_CASE("type promotion") {
     CHECK_PROMOTION(int, int, int);
     CHECK_PROMOTION(int, float, float);
@@ -18,22 +30,22 @@ TEST_CASE("type promotion") {
 
     CHECK_PROMOTION(float, int, float);
     CHECK_PROMOTION(float, float, float);
-    CHECK_PROMOTION(float, double, double);
+    CHECK_FLOAT_PROMOTION(float, double, double, float);
     CHECK_PROMOTION(float, unsigned int, float);
     CHECK_PROMOTION(float, bool, float);
-    CHECK_PROMOTION(float, __half, float);
-    CHECK_PROMOTION(float, __nv_bfloat16, float);
+    CHECK_FLOAT_PROMOTION(float, __half, float, __half);
+    CHECK_FLOAT_PROMOTION(float, __nv_bfloat16, float, __nv_bfloat16);
     CHECK_PROMOTION(float, char, float);
     CHECK_PROMOTION(float, signed char, float);
     CHECK_PROMOTION(float, unsigned char, float);
 
     CHECK_PROMOTION(double, int, double);
-    CHECK_PROMOTION(double, float, double);
+    CHECK_FLOAT_PROMOTION(double, float, double, float);
     CHECK_PROMOTION(double, double, double);
     CHECK_PROMOTION(double, unsigned int, double);
     CHECK_PROMOTION(double, bool, double);
-    CHECK_PROMOTION(double, __half, double);
-    CHECK_PROMOTION(double, __nv_bfloat16, double);
+    CHECK_FLOAT_PROMOTION(double, __half, double, __half);
+    CHECK_FLOAT_PROMOTION(double, __nv_bfloat16, double, __nv_bfloat16);
     CHECK_PROMOTION(double, char, double);
     CHECK_PROMOTION(double, signed char, double);
     CHECK_PROMOTION(double, unsigned char, double);
@@ -61,8 +73,8 @@ TEST_CASE("type promotion") {
     CHECK_PROMOTION(bool, unsigned char, unsigned char);
 
     CHECK_PROMOTION(__half, int, __half);
-    CHECK_PROMOTION(__half, float, float);
-    CHECK_PROMOTION(__half, double, double);
+    CHECK_FLOAT_PROMOTION(__half, float, float, __half);
+    CHECK_FLOAT_PROMOTION(__half, double, double, __half);
     CHECK_PROMOTION(__half, unsigned int, __half);
     CHECK_PROMOTION(__half, bool, __half);
     CHECK_PROMOTION(__half, __half, __half);
@@ -72,8 +84,8 @@ TEST_CASE("type promotion") {
     CHECK_PROMOTION(__half, unsigned char, __half);
 
     CHECK_PROMOTION(__nv_bfloat16, int, __nv_bfloat16);
-    CHECK_PROMOTION(__nv_bfloat16, float, float);
-    CHECK_PROMOTION(__nv_bfloat16, double, double);
+    CHECK_FLOAT_PROMOTION(__nv_bfloat16, float, float, __nv_bfloat16);
+    CHECK_FLOAT_PROMOTION(__nv_bfloat16, double, double, __nv_bfloat16);
     CHECK_PROMOTION(__nv_bfloat16, unsigned int, __nv_bfloat16);
     CHECK_PROMOTION(__nv_bfloat16, bool, __nv_bfloat16);
     CHECK_PROMOTION(__nv_bfloat16, __half, float);
@@ -0,0 +1,138 @@
+#include "common.h"
+
+struct quantize_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        kf::vec<T, 6> input = {T(-1.0), T(0.25), T(0.5), T(0.75), T(100.0), T(-100.0)};
+
+        kf::vec<int8_t, 6> q = kf::quantize<int8_t>(input, T(0.25));
+        ASSERT_EQ(q, (kf::vec<int8_t, 6> {-4, 1, 2, 3, 127, -128}));
+        ASSERT_EQ(
+            kf::dequantize<T>(q, T(0.25)),
+            (kf::vec<T, 6> {-1.0, 0.25, 0.5, 0.75, 31.75, -32.0}));
+
+        kf::vec<uint8_t, 6> p = kf::quantize<uint8_t>(input, T(0.5), 128);
+        ASSERT_EQ(p, (kf::vec<uint8_t, 6> {126, 128, 129, 130, 255, 0}));
+        ASSERT_EQ(
+            kf::dequantize<T>(p, T(0.5), 128),
+            (kf::vec<T, 6> {-1.0, 0.0, 0.5, 1.0, 63.5, -64.0}));
+
+        // Scales and zero points per element
+        kf::vec<T, 2> pair = {T(1.0), T(1.0)};
+        kf::vec<T, 2> scales = {T(0.5), T(0.25)};
+        kf::vec<int, 2> zero_points = {10, -10};
+        ASSERT_EQ(kf::quantize<int8_t>(pair, scales, zero_points), (kf::vec<int8_t, 2> {12, -6}));
+        ASSERT_EQ(kf::dequantize<T>(kf::vec<int8_t, 2> {12, -6}, scales, zero_points), pair);
+    }
+};
+
+REGISTER_TEST_CASE("quantize", quantize_test, float, double)
+
+struct quantize_buffer_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        T input[9] = {T(1), T(1), T(1), T(2), T(2), T(2), T(-3), T(-3), T(-3)};
+        T scales[3] = {T(0.5), T(1), T(0.125)};
+        int zero_points[3] = {0, 100, -10};
+
+        int8_t q[9];
+        kf::quantize_buffer(q, input, 9, scales, zero_points, 3);
+
+        int8_t expected[9] = {2, 101, -2, 4, 102, 6, -6, 97, -34};
+        for (int i = 0; i < 9; i++) {
+            ASSERT(q[i] == expected[i]);
+        }
+
+        T output[9];
+        kf::dequantize_buffer(output, q, 9, scales, zero_points, 3);
+
+        for (int i = 0; i < 9; i++) {
+            ASSERT_EQ(output[i], input[i]);
+        }
+
+        // Split the work over two threads without zero points
+        int8_t r[9];
+        kf::quantize_buffer(r, input, 9, scales, (const int*)nullptr, 3, 0, 2);
+        kf::quantize_buffer(r, input, 9, scales, (const int*)nullptr, 3, 1, 2);
+
+        int8_t expected_r[9] = {2, 1, 8, 4, 2, 16, -6, -3, -24};
+        for (int i = 0; i < 9; i++) {
+            ASSERT(r[i] == expected_r[i]);
+        }
+    }
+};
+
+REGISTER_TEST_CASE("quantize buffer", quantize_buffer_test, float, double)
+
+struct block_scaled_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        // Block-int8 with float scales
+        alignas(8) int8_t data[8];
+        float scales[2];
+        kf::block_scaled_ptr<T, 4, int8_t> ptr(data, scales);
+
+        ptr.write(0, kf::vec<T, 4> {T(0.5), T(-1), T(2), T(63.5)});
+        ptr.write(1, kf::vec<T, 4> {T(0), T(0), T(0), T(0)});
+        ASSERT(scales[0] == 0.5f && scales[1] == 0.0f);
+        ASSERT(data[0] == 1 && data[1] == -2 && data[2] == 4 && data[3] == 127);
+        ASSERT(equals(ptr.read(0), (kf::vec<T, 4> {T(0.5), T(-1), T(2), T(63.5)})));
+        ASSERT(equals(ptr[1], (kf::vec<T, 4> {T(0), T(0), T(0), T(0)})));
+
+        // MXFP4: two fp4 values per byte with a power-of-two scale
+        alignas(2) kf::fp4x2_e2m1 packed[2];
+        kf::fp8_e8m0 exponents[1];
+        kf::block_scaled_ptr<T, 4, kf::fp4x2_e2m1, kf::fp8_e8m0> mx(packed, exponents);
+
+        mx.write(0, kf::vec<T, 4> {T(1), T(-3), T(12), T(0.25)});
+        ASSERT(mx.scale(0) == 2.0f);
+        ASSERT(equals(mx.read(0), (kf::vec<T, 4> {T(1), T(-3), T(12), T(0)})));
+
+        // MXFP8: amax / max_value = 288 / 240 is not a power of two, so the scale is rounded up
+        alignas(4) kf::fp8_e4m3fnuz elements[4];
+        kf::block_scaled_ptr<T, 4, kf::fp8_e4m3fnuz, kf::fp8_e8m0> mx8(elements, exponents);
+
+        mx8.write(0, kf::vec<T, 4> {T(288), T(1), T(-2), T(0.5)});
+        ASSERT(mx8.scale(0) == 2.0f);
+        ASSERT(equals(mx8.read(0), (kf::vec<T, 4> {T(288), T(1), T(-2), T(0.5)})));
+    }
+};
+
+REGISTER_TEST_CASE("block scaled ptr", block_scaled_test, float, double)
+
+struct delayed_scaling_test {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        using E = kf::fp8_e4m3fnuz;  // largest value is 240
+        kf::delayed_scaling<E, 2> scaling;
+        ASSERT(scaling.scale() == 1.0f);
+
+        T input[4] = {T(1), T(-2), T(0.5), T(-0.25)};
+        T large[4] = {T(10), T(-20), T(5), T(60)};
+        E output[4];
+
+        ASSERT(kf::amax_buffer(input, 4) == 2.0f);
+        ASSERT(kf::amax_buffer(input, 4, 1, 2) == 2.0f);
+        ASSERT(kf::amax_buffer(input, 4, 0, 2) == 1.0f);
+
+        // Step 1: nothing recorded yet, cast with scale 1
+        float amax = kf::cast_scaled_buffer(output, input, 4, scaling.scale());
+        ASSERT(amax == 2.0f && float(output[1]) == -2.0f);
+        scaling.update(amax);
+        ASSERT(scaling.scale() == 120.0f && scaling.inverse_scale() == 1.0f / 120.0f);
+
+        // Step 2: the amax grows, values beyond the previous amax are clipped
+        amax = kf::cast_scaled_buffer(output, large, 4, scaling.scale());
+        ASSERT(amax == 60.0f && float(output[3]) == 240.0f && float(output[1]) == -240.0f);
+        scaling.update(amax);
+        ASSERT(scaling.amax() == 60.0f && scaling.scale() == 4.0f);
+
+        // Step 3 and 4: the large amax leaves the history after two steps
+        scaling.update(kf::cast_scaled_buffer(output, input, 4, scaling.scale()));
+        ASSERT(scaling.scale() == 4.0f && float(output[1]) == -8.0f);
+        scaling.update(kf::cast_scaled_buffer(output, input, 4, scaling.scale()));
+        ASSERT(scaling.scale() == 120.0f);
+    }
+};
+
+REGISTER_TEST_CASE("delayed scaling", delayed_scaling_test, float, double)
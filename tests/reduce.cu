@@ -58,9 +58,13 @@ struct reduction_tests {
             ASSERT_APPROX(kf::max(a), T(5.0));
             ASSERT_APPROX(kf::sum(a), T(2.0));
             ASSERT_APPROX(kf::product(a), T(-15.0));
+            ASSERT_APPROX(kf::amax(a), T(5.0));
             ASSERT_EQ(kf::all(a), true);
             ASSERT_EQ(kf::any(a), true);
             ASSERT_EQ(kf::count(a), 2);
+
+            kf::vec<T, 2> b = {T(2.0), T(-7.0)};
+            ASSERT_APPROX(kf::amax(b), T(7.0));
         }
 
         {
@@ -126,6 +130,34 @@ struct reduction_tests {
 REGISTER_TEST_CASE("reductions", reduction_tests, int, float, double)
 REGISTER_TEST_CASE_GPU("reductions", reduction_tests, __half, __nv_bfloat16)
 
+struct amax_integer_tests {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        kf::vec<T, 2> a = {T(3), T(5)};
+        ASSERT_EQ(kf::amax(a), T(5));
+
+        kf::vec<T, 4> b = {T(0), T(100), T(7), T(1)};
+        ASSERT_EQ(kf::amax(b), T(100));
+
+        // The magnitude of the most negative value saturates
+        if (T(-1) < T(0)) {
+            T min_value = T(1ULL << (8 * sizeof(T) - 1));
+            T max_value = T(-(min_value + T(1)));
+            kf::vec<T, 3> c = {T(1), min_value, T(-3)};
+            ASSERT_EQ(kf::amax(c), max_value);
+        }
+    }
+};
+
+REGISTER_TEST_CASE(
+    "amax integer",
+    amax_integer_tests,
+    signed char,
+    int,
+    long long,
+    unsigned char,
+    unsigned int)
+
 struct dot_mag_tests {
     template<typename T>
     __host__ __device__ void operator()(generator<T> gen) {
@@ -168,3 +200,90 @@ struct dot_mag_tests {
 
 REGISTER_TEST_CASE("dot product/magnitude", dot_mag_tests, float, double)
 REGISTER_TEST_CASE_GPU("dot product/magnitude", dot_mag_tests, __half, __nv_bfloat16)
+
+struct moments_tests {
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        {
+            kf::vec<T, 1> a = {T(3.0)};
+            kf::running_moments<T> m = kf::moments(a);
+            ASSERT_APPROX(m.count, T(1.0));
+            ASSERT_APPROX(m.mean, T(3.0));
+            ASSERT_APPROX(m.m2, T(0.0));
+        }
+
+        {
+            kf::vec<T, 4> a = {T(1.0), T(2.0), T(3.0), T(4.0)};
+            kf::running_moments<T> m = kf::moments(a);
+            ASSERT_APPROX(m.count, T(4.0));
+            ASSERT_APPROX(m.mean, T(2.5));
+            ASSERT_APPROX(m.m2, T(5.0));
+            ASSERT_APPROX(m.variance(), T(1.25));
+        }
+
+        {
+            kf::vec<T, 5> a = {T(2.0), T(4.0), T(4.0), T(5.0), T(10.0)};
+            kf::vec<T, 3> b = {T(-1.0), T(0.0), T(1.0)};
+            kf::running_moments<T> m = kf::merge_moments(kf::moments(a), kf::moments(b));
+            ASSERT_APPROX(m.count, T(8.0));
+            ASSERT_APPROX(m.mean, T(3.125));
+            ASSERT_APPROX(m.m2, T(84.875));
+        }
+
+        {
+            T data[8] = {T(2.0), T(4.0), T(4.0), T(5.0), T(10.0), T(-1.0), T(0.0), T(1.0)};
+            auto ptr = kf::assert_aligned<2>(data);
+
+            kf::running_moments<T> m = kf::moments(ptr, 0, 4);
+            ASSERT_APPROX(m.count, T(8.0));
+            ASSERT_APPROX(m.mean, T(3.125));
+            ASSERT_APPROX(m.m2, T(84.875));
+
+            m = kf::merge_moments(kf::moments(ptr, 0, 4, 2), kf::moments(ptr, 1, 4, 2));
+            ASSERT_APPROX(m.count, T(8.0));
+            ASSERT_APPROX(m.mean, T(3.125));
+            ASSERT_APPROX(m.m2, T(84.875));
+        }
+    }
+};
+
+REGISTER_TEST_CASE("moments", moments_tests, float, double)
+
+struct bitmask_tests {
+    template<typename T, size_t N>
+    __host__ __device__ void check(unsigned long long mask) {
+        kf::vec<bool, N> b = kf::from_bitmask<N>(mask);
+        kf::vec<T, N> a = kf::cast<T>(b);
+        unsigned long long full = N == 64 ? ~0ULL : (1ULL << (N % 64)) - 1;
+        int expected_count = 0;
+
+        for (size_t i = 0; i < N; i++) {
+            ASSERT_EQ(a[i], T((mask >> i) & 1));
+            expected_count += int((mask >> i) & 1);
+        }
+
+        ASSERT(kf::bitmask(a) == (mask & full));
+        ASSERT(kf::all(a) == ((mask & full) == full));
+        ASSERT(kf::any(a) == ((mask & full) != 0));
+        ASSERT(kf::count(a) == expected_count);
+    }
+
+    template<typename T>
+    __host__ __device__ void operator()(generator<T> gen) {
+        unsigned long long masks[] = {0, ~0ULL, 0x5, 0x8000000000000001ULL, 0x123456789ABCDEFULL};
+
+        for (unsigned long long mask : masks) {
+            check<T, 1>(mask);
+            check<T, 3>(mask);
+            check<T, 8>(mask);
+            check<T, 13>(mask);
+            check<T, 64>(mask);
+        }
+
+        // More than 64 elements does not use the bitmask
+        kf::vec<T, 70> a = kf::cast<T>(kf::from_bitmask<70>(~0ULL));
+        ASSERT(kf::any(a) && !kf::all(a) && kf::count(a) == 64);
+    }
+};
+
+REGISTER_TEST_CASE("bitmask", bitmask_tests, bool, int, float)